@@ -0,0 +1,97 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// convstream.cpp
+// ConverterStream: ucnv_convertEx() from input segments to a ByteSink.
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_CONVERSION
+
+#include "unicode/bytestream.h"
+#include "unicode/convstream.h"
+#include "unicode/ucnv.h"
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+// The sink must provide at least this much space for each ucnv_convertEx() call.
+// Output that does not fit is kept in the target converter for the next call.
+const int32_t MIN_APPEND_CAPACITY = 16;
+
+const int32_t SCRATCH_CAPACITY = 1024;
+
+// ucnv_convertEx() does not accept NULL source pointers, even for empty input.
+const char gEmpty[] = "";
+
+}  // namespace
+
+void ConverterStream::convert(const UConverterSegment *segments, int32_t count,
+                              ByteSink &sink, UBool flush, UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (targetCnv_ == NULL || sourceCnv_ == NULL || count < 0 || (segments == NULL && count > 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    for (int32_t i = 0; i < count; ++i) {
+        const UConverterSegment &segment = segments[i];
+        if (segment.length < 0 || (segment.data == NULL && segment.length > 0)) {
+            errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+            return;
+        }
+        // Only the last segment can flush, so that a character split across segments
+        // is put together.
+        const char *data = segment.length > 0 ? segment.data : gEmpty;
+        convertSegment(data, data + segment.length,
+                       sink, flush && i == count - 1, errorCode);
+        if (U_FAILURE(errorCode)) {
+            return;
+        }
+    }
+    if (count == 0 && flush) {
+        convertSegment(gEmpty, gEmpty, sink, TRUE, errorCode);
+    }
+    if (flush && U_SUCCESS(errorCode)) {
+        reset();
+    }
+}
+
+void ConverterStream::convert(StringPiece segment, ByteSink &sink, UBool flush,
+                              UErrorCode &errorCode) {
+    UConverterSegment s = { segment.data(), segment.length() };
+    convert(&s, 1, sink, flush, errorCode);
+}
+
+void ConverterStream::convertSegment(const char *s, const char *limit,
+                                     ByteSink &sink, UBool flush, UErrorCode &errorCode) {
+    char scratch[SCRATCH_CAPACITY];
+    for (;;) {
+        // Ask for about twice the remaining input length; the sink may ignore this.
+        int32_t desiredCapacity = (int32_t)(limit - s);
+        desiredCapacity = desiredCapacity <= 0x3fffffff - MIN_APPEND_CAPACITY ?
+            2 * desiredCapacity + MIN_APPEND_CAPACITY : 0x7fffffff;
+        int32_t capacity;
+        char *buffer = sink.GetAppendBuffer(MIN_APPEND_CAPACITY, desiredCapacity,
+                                            scratch, SCRATCH_CAPACITY, &capacity);
+        char *t = buffer;
+        ucnv_convertEx(targetCnv_, sourceCnv_, &t, buffer + capacity,
+                       &s, limit,
+                       pivot_, &pivotSource_, &pivotTarget_, pivot_ + PIVOT_CAPACITY,
+                       reset_, flush, &errorCode);
+        reset_ = FALSE;
+        if (t != buffer) {
+            sink.Append(buffer, (int32_t)(t - buffer));
+        }
+        if (errorCode != U_BUFFER_OVERFLOW_ERROR) {
+            return;
+        }
+        errorCode = U_ZERO_ERROR;
+    }
+}
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_CONVERSION
@@ -0,0 +1,450 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// normalizer2bulk.cpp
+// Normalizer2::normalizeBulk() and normalizeUTF8Bulk(): Split a large string
+// before code points with hasBoundaryBefore(), normalize the chunks
+// on the threads of a caller-supplied executor, and concatenate the results.
+//
+// Normalization does not look across such a boundary, so each chunk's result
+// is the same as the corresponding part of normalizing the whole string.
+//
+// Normalizer2::normalizeBatch() and normalizeUTF8Batch(): The opposite case,
+// many short strings normalized into one output arena.
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_NORMALIZATION
+
+#include "unicode/bytestream.h"
+#include "unicode/edits.h"
+#include "unicode/normalizer2.h"
+#include "unicode/stringoptions.h"
+#include "unicode/utf16.h"
+#include "unicode/utf8.h"
+#include "charstr.h"
+#include "cmemory.h"
+#include "umutex.h"
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+const int32_t DEFAULT_CHUNK_LENGTH = 0x40000;
+
+// All tasks of all bulk normalization calls report their completion via these.
+// Each call waits until its own count of outstanding tasks reaches zero.
+UMutex gNormBulkMutex = U_MUTEX_INITIALIZER;
+UConditionVar gNormBulkCondition = U_CONDITION_INITIALIZER;
+
+/**
+ * Returns the index of the first code point at or after start
+ * which has a boundary before it, or length if there is none.
+ */
+int32_t findBoundary(const Normalizer2 &n2, const UChar *s, int32_t start, int32_t length) {
+    int32_t i = start;
+    // Do not split a surrogate pair.
+    if (i < length && U16_IS_TRAIL(s[i])) {
+        ++i;
+    }
+    while (i < length) {
+        int32_t cpStart = i;
+        UChar32 c;
+        U16_NEXT(s, i, length, c);
+        if (n2.hasBoundaryBefore(c)) {
+            return cpStart;
+        }
+    }
+    return length;
+}
+
+/**
+ * Same as the UTF-16 version, but splits only before a well-formed sequence:
+ * Its lead byte never continues the previous sequence, even in ill-formed text.
+ */
+int32_t findBoundary(const Normalizer2 &n2, const uint8_t *s, int32_t start, int32_t length) {
+    int32_t i = start;
+    while (i < length) {
+        int32_t cpStart = i;
+        UChar32 c;
+        U8_NEXT(s, i, length, c);
+        if (c >= 0 && n2.hasBoundaryBefore(c)) {
+            return cpStart;
+        }
+    }
+    return length;
+}
+
+class CharStringByteSink : public ByteSink {
+public:
+    CharStringByteSink(CharString &dest, UErrorCode &errorCode) :
+        dest_(dest), errorCode_(errorCode) {}
+    virtual void Append(const char *bytes, int32_t n) {
+        dest_.append(bytes, n, errorCode_);
+    }
+private:
+    CharString &dest_;
+    UErrorCode &errorCode_;
+};
+
+// Forwards to another sink and counts the bytes.
+// Flush() is deferred to the end of the batch.
+class CountingByteSink : public ByteSink {
+public:
+    CountingByteSink(ByteSink &sink) : sink_(sink), count_(0) {}
+    virtual void Append(const char *bytes, int32_t n) {
+        sink_.Append(bytes, n);
+        count_ += n;
+    }
+    virtual char *GetAppendBuffer(int32_t min_capacity, int32_t desired_capacity_hint,
+                                  char *scratch, int32_t scratch_capacity,
+                                  int32_t *result_capacity) {
+        return sink_.GetAppendBuffer(min_capacity, desired_capacity_hint,
+                                     scratch, scratch_capacity, result_capacity);
+    }
+    int32_t count() const { return count_; }
+private:
+    ByteSink &sink_;
+    int32_t count_;
+};
+
+class NormalizeBulkTask : public UMemory {
+public:
+    NormalizeBulkTask() : n2(NULL), options(0), src16(NULL), src8(NULL), length(0),
+                          withEdits(FALSE), errorCode(U_ZERO_ERROR), pRemaining(NULL) {}
+
+    void normalize() {
+        if (src16 != NULL) {
+            n2->normalize(UnicodeString(FALSE, src16, length), dest16, errorCode);
+        } else {
+            CharStringByteSink sink(dest8, errorCode);
+            n2->normalizeUTF8(options, StringPiece(src8, length), sink,
+                              withEdits ? &edits : NULL, errorCode);
+        }
+    }
+
+    const Normalizer2 *n2;
+    uint32_t options;
+    const UChar *src16;
+    const char *src8;
+    int32_t length;
+    UBool withEdits;
+
+    UnicodeString dest16;
+    CharString dest8;
+    Edits edits;
+    UErrorCode errorCode;
+
+    // Number of tasks of this call that have not finished, guarded by gNormBulkMutex.
+    int32_t *pRemaining;
+};
+
+void U_CALLCONV runNormalizeBulkTask(void *task) {
+    NormalizeBulkTask *bulkTask = static_cast<NormalizeBulkTask *>(task);
+    bulkTask->normalize();
+    umtx_lock(&gNormBulkMutex);
+    if (--*bulkTask->pRemaining == 0) {
+        umtx_condBroadcast(&gNormBulkCondition);
+    }
+    umtx_unlock(&gNormBulkMutex);
+}
+
+/**
+ * Splits the text, normalizes the chunks, and returns them in text order.
+ * The caller owns the returned array.
+ */
+template<typename CharType>
+NormalizeBulkTask *
+normalizeChunks(const Normalizer2 &n2, uint32_t options, const CharType *s, int32_t length,
+                UBool withEdits, int32_t chunkLength,
+                UExecutorFn *executor, const void *executorContext,
+                int32_t &count, UErrorCode &errorCode) {
+    if (chunkLength <= 0) {
+        chunkLength = DEFAULT_CHUNK_LENGTH;
+    }
+    MaybeStackArray<int32_t, 16> starts;
+    count = 1;
+    starts[0] = 0;
+    if (executor != NULL) {
+        int32_t start = 0;
+        while ((length - start) > chunkLength) {
+            int32_t p = findBoundary(n2, s, start + chunkLength, length);
+            if (p == length) {
+                break;
+            }
+            if (count == starts.getCapacity() &&
+                    starts.resize(2 * count, count) == NULL) {
+                errorCode = U_MEMORY_ALLOCATION_ERROR;
+                return NULL;
+            }
+            starts[count++] = start = p;
+        }
+    }
+
+    NormalizeBulkTask *tasks = new NormalizeBulkTask[count];
+    if (tasks == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    int32_t remaining = count - 1;
+    for (int32_t i = 0; i < count; ++i) {
+        NormalizeBulkTask &task = tasks[i];
+        task.n2 = &n2;
+        task.options = options;
+        int32_t limit = i + 1 < count ? starts[i + 1] : length;
+        if (sizeof(CharType) == 2) {
+            task.src16 = reinterpret_cast<const UChar *>(s) + starts[i];
+        } else {
+            task.src8 = reinterpret_cast<const char *>(s) + starts[i];
+        }
+        task.length = limit - starts[i];
+        task.withEdits = withEdits;
+        task.pRemaining = &remaining;
+    }
+
+    // Hand out all but the first chunk, then normalize the first one on this thread.
+    for (int32_t i = 1; i < count; ++i) {
+        executor(executorContext, runNormalizeBulkTask, &tasks[i]);
+    }
+    tasks[0].normalize();
+    if (count > 1) {
+        umtx_lock(&gNormBulkMutex);
+        while (remaining > 0) {
+            umtx_condWait(&gNormBulkCondition, &gNormBulkMutex);
+        }
+        umtx_unlock(&gNormBulkMutex);
+    }
+
+    // Report the first failure in text order.
+    for (int32_t i = 0; i < count; ++i) {
+        if (U_FAILURE(tasks[i].errorCode)) {
+            errorCode = tasks[i].errorCode;
+            delete[] tasks;
+            return NULL;
+        }
+    }
+    return tasks;
+}
+
+}  // namespace
+
+UnicodeString &
+Normalizer2::normalizeBulk(const UnicodeString &src, UnicodeString &dest,
+                           int32_t chunkLength, UExecutorFn *executor, const void *executorContext,
+                           UErrorCode &errorCode) const {
+    if (U_FAILURE(errorCode)) {
+        dest.setToBogus();
+        return dest;
+    }
+    const UChar *s = src.getBuffer();
+    if (&dest == &src || s == NULL) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        dest.setToBogus();
+        return dest;
+    }
+    int32_t count;
+    LocalArray<NormalizeBulkTask> tasks(
+        normalizeChunks(*this, 0, s, src.length(), FALSE, chunkLength,
+                        executor, executorContext, count, errorCode));
+    if (U_FAILURE(errorCode)) {
+        dest.setToBogus();
+        return dest;
+    }
+    if (count == 1) {
+        dest.fastCopyFrom(tasks[0].dest16);
+        return dest;
+    }
+    int32_t length = 0;
+    for (int32_t i = 0; i < count; ++i) {
+        length += tasks[i].dest16.length();
+    }
+    dest.remove();
+    if (dest.getBuffer(length) == NULL) {  // reserve the capacity
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return dest;
+    }
+    dest.releaseBuffer(0);
+    for (int32_t i = 0; i < count; ++i) {
+        dest.append(tasks[i].dest16);
+    }
+    if (dest.isBogus()) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+    }
+    return dest;
+}
+
+void
+Normalizer2::normalizeUTF8Bulk(uint32_t options, StringPiece src, ByteSink &sink, Edits *edits,
+                               int32_t chunkLength, UExecutorFn *executor,
+                               const void *executorContext, UErrorCode &errorCode) const {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (edits != NULL && (options & U_EDITS_NO_RESET) == 0) {
+        edits->reset();
+    }
+    int32_t count;
+    LocalArray<NormalizeBulkTask> tasks(
+        normalizeChunks(*this, options & ~U_EDITS_NO_RESET,
+                        reinterpret_cast<const uint8_t *>(src.data()), src.length(),
+                        edits != NULL, chunkLength,
+                        executor, executorContext, count, errorCode));
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    for (int32_t i = 0; i < count; ++i) {
+        const NormalizeBulkTask &task = tasks[i];
+        if (!task.dest8.isEmpty()) {
+            sink.Append(task.dest8.data(), task.dest8.length());
+        }
+        if (edits != NULL) {
+            // Append this chunk's edits one by one, so that they are recorded
+            // exactly like from a single normalizeUTF8() call.
+            Edits::Iterator ei = task.edits.getFineIterator();
+            while (ei.next(errorCode)) {
+                if (ei.hasChange()) {
+                    edits->addReplace(ei.oldLength(), ei.newLength());
+                } else {
+                    edits->addUnchanged(ei.oldLength());
+                }
+            }
+        }
+    }
+    if (edits != NULL) {
+        edits->copyErrorTo(errorCode);
+    }
+    sink.Flush();
+}
+
+void
+Normalizer2::normalizeBatch(const UChar *const *srcs, const int32_t *lengths, int32_t count,
+                            UnicodeString &arena, int32_t *offsets, UBool *isNormalized,
+                            UErrorCode &errorCode) const {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (count < 0 || (srcs == NULL && count > 0) || offsets == NULL) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    // Reused for the rare string that does not start at a boundary,
+    // so that its buffer is allocated only once for the whole batch.
+    UnicodeString normalized;
+    for (int32_t i = 0; i < count; ++i) {
+        int32_t start = offsets[i] = arena.length();
+        int32_t length = lengths != NULL ? lengths[i] : -1;
+        if (srcs[i] == NULL && length != 0) {
+            errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+            return;
+        }
+        UnicodeString src(length < 0, ConstChar16Ptr(srcs[i]), length);  // read-only alias
+        int32_t spanLength = spanQuickCheckYes(src, errorCode);
+        if (U_FAILURE(errorCode)) {
+            return;
+        }
+        if (spanLength == src.length()) {
+            if (isNormalized != NULL) {
+                isNormalized[i] = TRUE;
+            } else {
+                arena.append(src);
+            }
+            continue;
+        }
+        // Normalize the rest directly into the arena after the quick check span.
+        // normalizeSecondAndAppend() would merge the text with the previous result
+        // unless this string starts at a boundary.
+        if (hasBoundaryBefore(src.char32At(0))) {
+            arena.append(src, 0, spanLength);
+            normalizeSecondAndAppend(arena, src.tempSubString(spanLength), errorCode);
+        } else {
+            arena.append(normalize(src, normalized, errorCode));
+        }
+        if (U_FAILURE(errorCode)) {
+            return;
+        }
+        if (isNormalized != NULL) {
+            // A "maybe" quick check result can turn out to be normalized after all.
+            isNormalized[i] = (arena.length() - start) == src.length() &&
+                arena.compare(start, src.length(), src) == 0;
+            if (isNormalized[i]) {
+                arena.truncate(start);
+            }
+        }
+    }
+    offsets[count] = arena.length();
+    if (arena.isBogus()) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+    }
+}
+
+void
+Normalizer2::normalizeUTF8Batch(const StringPiece *srcs, int32_t count,
+                                ByteSink &sink, int32_t *offsets, UBool *isNormalized,
+                                UErrorCode &errorCode) const {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (count < 0 || (srcs == NULL && count > 0) || offsets == NULL) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    CountingByteSink counter(sink);
+    // Reused for each string, so that their buffers are allocated only once for the whole batch.
+    CharString changed;
+    Edits edits;
+    // FALSE for a Normalizer2 subclass whose normalizeUTF8() does not support Edits.
+    UBool withEdits = isNormalized != NULL;
+    for (int32_t i = 0; i < count; ++i) {
+        offsets[i] = counter.count();
+        StringPiece src = srcs[i];
+        if (withEdits) {
+            // One pass per string: Normalize only the changed text into the scratch buffer,
+            // and write the result from the source and the changes only if there are any.
+            changed.clear();
+            CharStringByteSink changedSink(changed, errorCode);
+            normalizeUTF8(U_OMIT_UNCHANGED_TEXT, src, changedSink, &edits, errorCode);
+            if (errorCode == U_UNSUPPORTED_ERROR) {
+                errorCode = U_ZERO_ERROR;
+                withEdits = FALSE;
+            } else {
+                if (U_FAILURE(errorCode)) {
+                    return;
+                }
+                isNormalized[i] = !edits.hasChanges();
+                Edits::Iterator ei = edits.getCoarseIterator();
+                while (!isNormalized[i] && ei.next(errorCode)) {
+                    if (ei.hasChange()) {
+                        if (ei.newLength() > 0) {
+                            counter.Append(changed.data() + ei.replacementIndex(), ei.newLength());
+                        }
+                    } else {
+                        counter.Append(src.data() + ei.sourceIndex(), ei.oldLength());
+                    }
+                }
+                if (U_FAILURE(errorCode)) {
+                    return;
+                }
+                continue;
+            }
+        }
+        if (isNormalized != NULL) {
+            isNormalized[i] = isNormalizedUTF8(src, errorCode);
+            if (U_FAILURE(errorCode)) {
+                return;
+            }
+            if (isNormalized[i]) {
+                continue;
+            }
+        }
+        normalizeUTF8(0, src, counter, NULL, errorCode);
+        if (U_FAILURE(errorCode)) {
+            return;
+        }
+    }
+    offsets[count] = counter.count();
+    sink.Flush();
+}
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_NORMALIZATION
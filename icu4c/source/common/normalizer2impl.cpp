@@ -40,6 +40,7 @@
 #include "uassert.h"
 #include "ucptrie_impl.h"
 #include "uset_imp.h"
+#include "usimd.h"
 #include "uvector.h"
 
 U_NAMESPACE_BEGIN
@@ -607,9 +608,10 @@ Normalizer2Impl::decompose(const UChar *src, const UChar *limit,
     for(;;) {
         // count code units below the minimum or with irrelevant data for the quick check
         for(prevSrc=src; src!=limit;) {
-            if( (c=*src)<minNoCP ||
-                isMostDecompYesAndZeroCC(norm16=UCPTRIE_FAST_BMP_GET(normTrie, UCPTRIE_16, c))
-            ) {
+            if((c=*src)<minNoCP) {
+                ++src;
+                src+=uprv_skipUCharsBelow(src, (int32_t)(limit-src), (UChar)minNoCP);
+            } else if(isMostDecompYesAndZeroCC(norm16=UCPTRIE_FAST_BMP_GET(normTrie, UCPTRIE_16, c))) {
                 ++src;
             } else if(!U16_IS_LEAD(c)) {
                 break;
@@ -732,9 +734,12 @@ UBool Normalizer2Impl::decompose(UChar32 c, uint16_t norm16,
     return buffer.append((const UChar *)mapping+1, length, TRUE, leadCC, trailCC, errorCode);
 }
 
+// Decomposes up to the limit, or up to the first boundary of the stopAt type.
+// STOP_AT_DECOMP_BOUNDARY stops before a character with lccc==0,
+// or after one with tccc<=1 (which no later combining mark reorders across).
 const uint8_t *
 Normalizer2Impl::decomposeShort(const uint8_t *src, const uint8_t *limit,
-                                UBool stopAtCompBoundary, UBool onlyContiguous,
+                                StopAt stopAt, UBool onlyContiguous,
                                 ReorderingBuffer &buffer, UErrorCode &errorCode) const {
     if (U_FAILURE(errorCode)) {
         return nullptr;
@@ -747,21 +752,28 @@ Normalizer2Impl::decomposeShort(const uint8_t *src, const uint8_t *limit,
         UChar32 c = U_SENTINEL;
         if (norm16 >= limitNoNo) {
             if (isMaybeOrNonZeroCC(norm16)) {
-                // No boundaries around this character.
+                // No comp boundaries around this character.
+                uint8_t cc = getCCFromYesOrMaybe(norm16);
+                if (cc == 0 && stopAt == STOP_AT_DECOMP_BOUNDARY) {
+                    return prevSrc;
+                }
                 c = codePointFromValidUTF8(prevSrc, src);
-                if (!buffer.append(c, getCCFromYesOrMaybe(norm16), errorCode)) {
+                if (!buffer.append(c, cc, errorCode)) {
                     return nullptr;
                 }
+                if (stopAt == STOP_AT_DECOMP_BOUNDARY && buffer.getLastCC() <= 1) {
+                    return src;
+                }
                 continue;
             }
             // Maps to an isCompYesAndZeroCC.
-            if (stopAtCompBoundary) {
+            if (stopAt != STOP_AT_LIMIT) {
                 return prevSrc;
             }
             c = codePointFromValidUTF8(prevSrc, src);
             c = mapAlgorithmic(c, norm16);
             norm16 = getRawNorm16(c);
-        } else if (stopAtCompBoundary && norm16 < minNoNoCompNoMaybeCC) {
+        } else if (stopAt != STOP_AT_LIMIT && norm16 < minNoNoCompNoMaybeCC) {
             return prevSrc;
         }
         // norm16!=INERT guarantees that [prevSrc, src[ is valid UTF-8.
@@ -769,7 +781,8 @@ Normalizer2Impl::decomposeShort(const uint8_t *src, const uint8_t *limit,
         // its norm16==INERT is normalization-inert,
         // so it gets copied unchanged in the fast path,
         // and we stop the slow path where invalid UTF-8 begins.
-        U_ASSERT(norm16 != INERT);
+        // c >= 0 is the result of an algorithmic mapping.
+        U_ASSERT(c >= 0 || norm16 != INERT);
         if (norm16 < minYesNo) {
             if (c < 0) {
                 c = codePointFromValidUTF8(prevSrc, src);
@@ -799,11 +812,15 @@ Normalizer2Impl::decomposeShort(const uint8_t *src, const uint8_t *limit,
             } else {
                 leadCC = 0;
             }
+            if (leadCC == 0 && stopAt == STOP_AT_DECOMP_BOUNDARY) {
+                return prevSrc;
+            }
             if (!buffer.append((const char16_t *)mapping+1, length, TRUE, leadCC, trailCC, errorCode)) {
                 return nullptr;
             }
         }
-        if (stopAtCompBoundary && norm16HasCompBoundaryAfter(norm16, onlyContiguous)) {
+        if ((stopAt == STOP_AT_COMP_BOUNDARY && norm16HasCompBoundaryAfter(norm16, onlyContiguous)) ||
+                (stopAt == STOP_AT_DECOMP_BOUNDARY && buffer.getLastCC() <= 1)) {
             return src;
         }
     }
@@ -924,6 +941,128 @@ void Normalizer2Impl::decomposeAndAppend(const UChar *src, const UChar *limit,
     }
 }
 
+// Dual functionality:
+// sink!=nullptr: normalize
+// sink==nullptr: isNormalized/spanQuickCheckYes
+const uint8_t *
+Normalizer2Impl::decomposeUTF8(uint32_t options,
+                               const uint8_t *src, const uint8_t *limit,
+                               ByteSink *sink, Edits *edits, UErrorCode &errorCode) const {
+    U_ASSERT(limit != nullptr);
+    UnicodeString s16;
+    uint8_t minNoLead = leadByteForCP(minDecompNoCP);
+
+    const uint8_t *prevBoundary = src;
+    // only for quick check
+    uint8_t prevCC = 0;
+
+    for (;;) {
+        // Fast path: Scan over a sequence of characters below the minimum "no" code point,
+        // or with (decompYes && ccc==0) properties.
+        const uint8_t *fastStart = src;
+        const uint8_t *prevSrc;
+        uint16_t norm16 = 0;
+        for (;;) {
+            if (src == limit) {
+                if (prevBoundary != limit && sink != nullptr) {
+                    ByteSinkUtil::appendUnchanged(prevBoundary, limit,
+                                                  *sink, options, edits, errorCode);
+                }
+                return src;
+            }
+            if (*src < minNoLead) {
+                ++src;
+                src += uprv_skipBytesBelow(src, (int32_t)(limit - src), minNoLead);
+            } else {
+                prevSrc = src;
+                UCPTRIE_FAST_U8_NEXT(normTrie, UCPTRIE_16, src, limit, norm16);
+                if (!isMostDecompYesAndZeroCC(norm16)) {
+                    break;
+                }
+            }
+        }
+        // isMostDecompYesAndZeroCC(norm16) is false, that is, norm16>=minYesNo,
+        // and the current character at [prevSrc..src[ is not a common case with cc=0
+        // (MIN_NORMAL_MAYBE_YES or JAMO_VT).
+        // It could still be a maybeYes with cc=0.
+        if (prevSrc != fastStart) {
+            // The fast path looped over yes/0 characters before the current one.
+            if (sink != nullptr &&
+                    !ByteSinkUtil::appendUnchanged(prevBoundary, prevSrc,
+                                                   *sink, options, edits, errorCode)) {
+                break;
+            }
+            prevBoundary = prevSrc;
+            prevCC = 0;
+        }
+
+        // Medium-fast path: Quick check.
+        if (isMaybeOrNonZeroCC(norm16)) {
+            // Does not decompose.
+            uint8_t cc = getCCFromYesOrMaybe(norm16);
+            if (prevCC <= cc || cc == 0) {
+                prevCC = cc;
+                if (cc <= 1) {
+                    if (sink != nullptr &&
+                            !ByteSinkUtil::appendUnchanged(prevBoundary, src,
+                                                           *sink, options, edits, errorCode)) {
+                        break;
+                    }
+                    prevBoundary = src;
+                }
+                continue;
+            }
+        }
+        if (sink == nullptr) {
+            return prevBoundary;  // quick check: "no" or cc out of order
+        }
+
+        // Slow path
+        // Decompose up to and including the current character.
+        if (prevBoundary != prevSrc && norm16HasDecompBoundaryBefore(norm16)) {
+            if (!ByteSinkUtil::appendUnchanged(prevBoundary, prevSrc,
+                                               *sink, options, edits, errorCode)) {
+                break;
+            }
+            prevBoundary = prevSrc;
+        }
+        ReorderingBuffer buffer(*this, s16, errorCode);
+        if (U_FAILURE(errorCode)) {
+            break;
+        }
+        decomposeShort(prevBoundary, src, STOP_AT_LIMIT, FALSE /* onlyContiguous */,
+                       buffer, errorCode);
+        // Decompose until the next boundary.
+        if (buffer.getLastCC() > 1) {
+            src = decomposeShort(src, limit, STOP_AT_DECOMP_BOUNDARY, FALSE /* onlyContiguous */,
+                                 buffer, errorCode);
+        }
+        if (U_FAILURE(errorCode)) {
+            break;
+        }
+        if ((src - prevBoundary) > INT32_MAX) {  // guard before buffer.equals()
+            errorCode = U_INDEX_OUTOFBOUNDS_ERROR;
+            break;
+        }
+        // We already know there was a change if the original character decomposed;
+        // otherwise compare.
+        if (isMaybeOrNonZeroCC(norm16) && buffer.equals(prevBoundary, src)) {
+            if (!ByteSinkUtil::appendUnchanged(prevBoundary, src,
+                                               *sink, options, edits, errorCode)) {
+                break;
+            }
+        } else {
+            if (!ByteSinkUtil::appendChange(prevBoundary, src, buffer.getStart(), buffer.length(),
+                                            *sink, edits, errorCode)) {
+                break;
+            }
+        }
+        prevBoundary = src;
+        prevCC = 0;
+    }
+    return src;
+}
+
 UBool Normalizer2Impl::hasDecompBoundaryBefore(UChar32 c) const {
     return c < minLcccCP || (c <= 0xffff && !singleLeadMightHaveNonZeroFCD16(c)) ||
         norm16HasDecompBoundaryBefore(getNorm16(c));
@@ -1340,9 +1479,10 @@ Normalizer2Impl::compose(const UChar *src, const UChar *limit,
                 }
                 return TRUE;
             }
-            if( (c=*src)<minNoMaybeCP ||
-                isCompYesAndZeroCC(norm16=UCPTRIE_FAST_BMP_GET(normTrie, UCPTRIE_16, c))
-            ) {
+            if((c=*src)<minNoMaybeCP) {
+                ++src;
+                src+=uprv_skipUCharsBelow(src, (int32_t)(limit-src), (UChar)minNoMaybeCP);
+            } else if(isCompYesAndZeroCC(norm16=UCPTRIE_FAST_BMP_GET(normTrie, UCPTRIE_16, c))) {
                 ++src;
             } else {
                 prevSrc = src++;
@@ -1601,9 +1741,10 @@ Normalizer2Impl::composeQuickCheck(const UChar *src, const UChar *limit,
             if(src==limit) {
                 return src;
             }
-            if( (c=*src)<minNoMaybeCP ||
-                isCompYesAndZeroCC(norm16=UCPTRIE_FAST_BMP_GET(normTrie, UCPTRIE_16, c))
-            ) {
+            if((c=*src)<minNoMaybeCP) {
+                ++src;
+                src+=uprv_skipUCharsBelow(src, (int32_t)(limit-src), (UChar)minNoMaybeCP);
+            } else if(isCompYesAndZeroCC(norm16=UCPTRIE_FAST_BMP_GET(normTrie, UCPTRIE_16, c))) {
                 ++src;
             } else {
                 prevSrc = src++;
@@ -1754,6 +1895,7 @@ Normalizer2Impl::composeUTF8(uint32_t options, UBool onlyContiguous,
             }
             if (*src < minNoMaybeLead) {
                 ++src;
+                src += uprv_skipBytesBelow(src, (int32_t)(limit - src), minNoMaybeLead);
             } else {
                 prevSrc = src;
                 UCPTRIE_FAST_U8_NEXT(normTrie, UCPTRIE_16, src, limit, norm16);
@@ -1955,10 +2097,10 @@ Normalizer2Impl::composeUTF8(uint32_t options, UBool onlyContiguous,
             break;
         }
         // We know there is not a boundary here.
-        decomposeShort(prevSrc, src, FALSE /* !stopAtCompBoundary */, onlyContiguous,
+        decomposeShort(prevSrc, src, STOP_AT_LIMIT, onlyContiguous,
                        buffer, errorCode);
         // Decompose until the next boundary.
-        src = decomposeShort(src, limit, TRUE /* stopAtCompBoundary */, onlyContiguous,
+        src = decomposeShort(src, limit, STOP_AT_COMP_BOUNDARY, onlyContiguous,
                              buffer, errorCode);
         if (U_FAILURE(errorCode)) {
             break;
@@ -2165,8 +2307,9 @@ Normalizer2Impl::makeFCD(const UChar *src, const UChar *limit,
         // count code units with lccc==0
         for(prevSrc=src; src!=limit;) {
             if((c=*src)<minLcccCP) {
-                prevFCD16=~c;
                 ++src;
+                src+=uprv_skipUCharsBelow(src, (int32_t)(limit-src), (UChar)minLcccCP);
+                prevFCD16=~src[-1];
             } else if(!singleLeadMightHaveNonZeroFCD16(c)) {
                 prevFCD16=0;
                 ++src;
@@ -2300,6 +2443,105 @@ void Normalizer2Impl::makeFCDAndAppend(const UChar *src, const UChar *limit,
     }
 }
 
+// Dual functionality:
+// sink!=nullptr: normalize
+// sink==nullptr: isNormalized/spanQuickCheckYes
+const uint8_t *
+Normalizer2Impl::makeFCDUTF8(uint32_t options,
+                             const uint8_t *src, const uint8_t *limit,
+                             ByteSink *sink, Edits *edits, UErrorCode &errorCode) const {
+    U_ASSERT(limit != nullptr);
+    UnicodeString s16;
+    uint8_t minLcccLead = leadByteForCP(minLcccCP);
+
+    // Tracks the last FCD-safe boundary, before lccc=0 or after properly-ordered tccc<=1.
+    // Similar to the prevBoundary in the makeFCD() implementation.
+    // Unlike with a ReorderingBuffer, we cannot take back output from the sink,
+    // so the text since unchangedStart is written only at the end or before a change.
+    const uint8_t *prevBoundary = src;
+    const uint8_t *unchangedStart = src;
+    uint16_t prevFCD16 = 0;
+
+    for (;;) {
+        // Fast path: Scan over a sequence of characters with lccc==0.
+        const uint8_t *fastStart = src;
+        const uint8_t *prevSrc;
+        uint16_t norm16;
+        for (;;) {
+            if (src == limit) {
+                if (unchangedStart != limit && sink != nullptr) {
+                    ByteSinkUtil::appendUnchanged(unchangedStart, limit,
+                                                  *sink, options, edits, errorCode);
+                }
+                return src;
+            }
+            if (*src < minLcccLead) {
+                ++src;
+                src += uprv_skipBytesBelow(src, (int32_t)(limit - src), minLcccLead);
+            } else {
+                prevSrc = src;
+                UCPTRIE_FAST_U8_NEXT(normTrie, UCPTRIE_16, src, limit, norm16);
+                if (!norm16HasDecompBoundaryBefore(norm16)) {
+                    break;
+                }
+            }
+        }
+        // The current character at [prevSrc..src[ has a non-zero lead combining class,
+        // which implies that it is well-formed.
+        uint16_t fcd16 = getFCD16FromNormData(codePointFromValidUTF8(prevSrc, src));
+        if (prevSrc != fastStart) {
+            // The previous character has lccc==0.
+            // Fetch its tccc, which the fast path did not look up.
+            int32_t prevStart = (int32_t)(prevSrc - fastStart);
+            UChar32 prev;
+            U8_PREV(fastStart, 0, prevStart, prev);
+            prevFCD16 = prev < 0 ? 0 : getFCD16(prev);
+            prevBoundary = prevFCD16 > 1 ? fastStart + prevStart : prevSrc;
+        }
+
+        // Check for proper order, and decompose locally if necessary.
+        if ((prevFCD16 & 0xff) <= (fcd16 >> 8)) {
+            // proper order: prev tccc <= current lccc
+            if ((fcd16 & 0xff) <= 1) {
+                prevBoundary = src;
+            }
+            prevFCD16 = fcd16;
+            continue;
+        } else if (sink == nullptr) {
+            return prevBoundary;  // quick check "no"
+        }
+        // The source text does not fulfill the conditions for FCD.
+        // Decompose and reorder a limited piece of the text,
+        // up to the next safe boundary.
+        src = findNextFCDBoundary(src, limit);
+        if (unchangedStart != prevBoundary &&
+                !ByteSinkUtil::appendUnchanged(unchangedStart, prevBoundary,
+                                               *sink, options, edits, errorCode)) {
+            break;
+        }
+        ReorderingBuffer buffer(*this, s16, errorCode);
+        if (U_FAILURE(errorCode)) {
+            break;
+        }
+        decomposeShort(prevBoundary, src, STOP_AT_LIMIT, FALSE /* onlyContiguous */,
+                       buffer, errorCode);
+        if (U_FAILURE(errorCode)) {
+            break;
+        }
+        if ((src - prevBoundary) > INT32_MAX) {
+            errorCode = U_INDEX_OUTOFBOUNDS_ERROR;
+            break;
+        }
+        if (!ByteSinkUtil::appendChange(prevBoundary, src, buffer.getStart(), buffer.length(),
+                                        *sink, edits, errorCode)) {
+            break;
+        }
+        unchangedStart = prevBoundary = src;
+        prevFCD16 = 0;
+    }
+    return src;
+}
+
 const UChar *Normalizer2Impl::findPreviousFCDBoundary(const UChar *start, const UChar *p) const {
     while(start<p) {
         const UChar *codePointLimit = p;
@@ -2332,6 +2574,21 @@ const UChar *Normalizer2Impl::findNextFCDBoundary(const UChar *p, const UChar *l
     return p;
 }
 
+const uint8_t *Normalizer2Impl::findNextFCDBoundary(const uint8_t *p, const uint8_t *limit) const {
+    while (p < limit) {
+        const uint8_t *codePointStart = p;
+        uint16_t norm16;
+        UCPTRIE_FAST_U8_NEXT(normTrie, UCPTRIE_16, p, limit, norm16);
+        if (norm16HasDecompBoundaryBefore(norm16)) {
+            return codePointStart;
+        }
+        if (norm16HasDecompBoundaryAfter(norm16)) {
+            return p;
+        }
+    }
+    return p;
+}
+
 // CanonicalIterator data -------------------------------------------------- ***
 
 CanonIterData::CanonIterData(UErrorCode &errorCode) :
@@ -490,6 +490,12 @@ class U_COMMON_API Normalizer2Impl : public UObject {
                             UnicodeString &safeMiddle,
                             ReorderingBuffer &buffer,
                             UErrorCode &errorCode) const;
+
+    /** sink==nullptr: isNormalized()/spanQuickCheckYes() */
+    const uint8_t *decomposeUTF8(uint32_t options,
+                                 const uint8_t *src, const uint8_t *limit,
+                                 ByteSink *sink, icu::Edits *edits, UErrorCode &errorCode) const;
+
     UBool compose(const UChar *src, const UChar *limit,
                   UBool onlyContiguous,
                   UBool doCompose,
@@ -518,6 +524,11 @@ class U_COMMON_API Normalizer2Impl : public UObject {
                           ReorderingBuffer &buffer,
                           UErrorCode &errorCode) const;
 
+    /** sink==nullptr: isNormalized()/spanQuickCheckYes() */
+    const uint8_t *makeFCDUTF8(uint32_t options,
+                               const uint8_t *src, const uint8_t *limit,
+                               ByteSink *sink, icu::Edits *edits, UErrorCode &errorCode) const;
+
     UBool hasDecompBoundaryBefore(UChar32 c) const;
     UBool norm16HasDecompBoundaryBefore(uint16_t norm16) const;
     UBool hasDecompBoundaryAfter(UChar32 c) const;
@@ -654,8 +665,11 @@ class U_COMMON_API Normalizer2Impl : public UObject {
     UBool decompose(UChar32 c, uint16_t norm16,
                     ReorderingBuffer &buffer, UErrorCode &errorCode) const;
 
+    /** Where the UTF-8 decomposeShort() stops before its limit. */
+    enum StopAt { STOP_AT_LIMIT, STOP_AT_DECOMP_BOUNDARY, STOP_AT_COMP_BOUNDARY };
+
     const uint8_t *decomposeShort(const uint8_t *src, const uint8_t *limit,
-                                  UBool stopAtCompBoundary, UBool onlyContiguous,
+                                  StopAt stopAt, UBool onlyContiguous,
                                   ReorderingBuffer &buffer, UErrorCode &errorCode) const;
 
     static int32_t combine(const uint16_t *list, UChar32 trail);
@@ -690,6 +704,7 @@ class U_COMMON_API Normalizer2Impl : public UObject {
 
     const UChar *findPreviousFCDBoundary(const UChar *start, const UChar *p) const;
     const UChar *findNextFCDBoundary(const UChar *p, const UChar *limit) const;
+    const uint8_t *findNextFCDBoundary(const uint8_t *p, const uint8_t *limit) const;
 
     void makeCanonIterDataFromNorm16(UChar32 start, UChar32 end, const uint16_t norm16,
                                      CanonIterData &newData, UErrorCode &errorCode) const;
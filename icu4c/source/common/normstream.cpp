@@ -0,0 +1,197 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// normstream.cpp
+// NormalizerStream: Normalizer2 on text chunks, keeping only the tail
+// after the last boundary between calls.
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_NORMALIZATION
+
+#include "unicode/appendable.h"
+#include "unicode/bytestream.h"
+#include "unicode/normalizer2.h"
+#include "unicode/normstream.h"
+#include "unicode/utf16.h"
+#include "unicode/utf8.h"
+#include "charstr.h"
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+// A character with hasBoundaryBefore() does not interact with the text before it,
+// so the text up to there can be normalized without waiting for more input.
+// A truncated sequence at the end of a chunk does not count:
+// The next chunk might complete it to a combining mark.
+
+/**
+ * Returns the index of the first code point in s[0..length[ with a boundary before it,
+ * or length if there is none.
+ * Leading trail bytes continue a character from the previous chunk and are skipped.
+ */
+int32_t firstBoundaryUTF8(const Normalizer2 &n2, const uint8_t *s, int32_t length) {
+    int32_t i = 0;
+    while (i < length && i < 3 && U8_IS_TRAIL(s[i])) {
+        ++i;
+    }
+    while (i < length) {
+        int32_t start = i;
+        UChar32 c;
+        U8_NEXT(s, i, length, c);
+        if (c < 0 ? i < length : n2.hasBoundaryBefore(c)) {
+            return start;
+        }
+    }
+    return length;
+}
+
+/**
+ * Returns the index of the last code point in s[0..length[ with a boundary before it,
+ * or 0 if there is none.
+ */
+int32_t lastBoundaryUTF8(const Normalizer2 &n2, const uint8_t *s, int32_t length) {
+    int32_t i = length;
+    while (i > 0) {
+        int32_t end = i;
+        UChar32 c;
+        U8_PREV(s, 0, i, c);
+        if (c < 0 ? end < length : n2.hasBoundaryBefore(c)) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+int32_t firstBoundaryUTF16(const Normalizer2 &n2, const UChar *s, int32_t length) {
+    int32_t i = 0;
+    if (i < length && U16_IS_TRAIL(s[i])) {
+        ++i;
+    }
+    while (i < length) {
+        int32_t start = i;
+        UChar32 c;
+        U16_NEXT(s, i, length, c);
+        if (U16_IS_LEAD(c) && i == length) {
+            break;
+        }
+        if (n2.hasBoundaryBefore(c)) {
+            return start;
+        }
+    }
+    return length;
+}
+
+int32_t lastBoundaryUTF16(const Normalizer2 &n2, const UChar *s, int32_t length) {
+    int32_t i = length;
+    while (i > 0) {
+        UChar32 c;
+        U16_PREV(s, 0, i, c);
+        if (!(U16_IS_LEAD(c) && i + 1 == length) && n2.hasBoundaryBefore(c)) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+NormalizerStream::~NormalizerStream() {
+    delete pending8_;
+}
+
+void NormalizerStream::reset() {
+    if (pending8_ != NULL) {
+        pending8_->clear();
+    }
+    pending16_.remove();
+}
+
+void NormalizerStream::normalizeUTF8(StringPiece chunk, ByteSink &sink, UBool flush,
+                                     UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (!pending16_.isEmpty()) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    const char *s = chunk.data();
+    int32_t length = chunk.length();
+    if (pending8_ != NULL && !pending8_->isEmpty()) {
+        // The kept text continues up to the first boundary in this chunk.
+        int32_t first = firstBoundaryUTF8(n2_, reinterpret_cast<const uint8_t *>(s), length);
+        pending8_->append(s, first, errorCode);
+        s += first;
+        length -= first;
+        if (U_FAILURE(errorCode) || (length == 0 && !flush)) {
+            return;
+        }
+        n2_.normalizeUTF8(0, pending8_->toStringPiece(), sink, NULL, errorCode);
+        pending8_->clear();
+    }
+    int32_t limit = flush ? length :
+        lastBoundaryUTF8(n2_, reinterpret_cast<const uint8_t *>(s), length);
+    if (limit > 0) {
+        n2_.normalizeUTF8(0, StringPiece(s, limit), sink, NULL, errorCode);
+    }
+    if (limit < length && U_SUCCESS(errorCode)) {
+        if (pending8_ == NULL) {
+            pending8_ = new CharString();
+            if (pending8_ == NULL) {
+                errorCode = U_MEMORY_ALLOCATION_ERROR;
+                return;
+            }
+        }
+        pending8_->append(s + limit, length - limit, errorCode);
+    }
+}
+
+void NormalizerStream::normalize(const UnicodeString &chunk, Appendable &dest, UBool flush,
+                                 UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    const UChar *s = chunk.getBuffer();
+    if ((pending8_ != NULL && !pending8_->isEmpty()) || s == NULL) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    int32_t length = chunk.length();
+    if (!pending16_.isEmpty()) {
+        // The kept text continues up to the first boundary in this chunk.
+        int32_t first = firstBoundaryUTF16(n2_, s, length);
+        if (pending16_.append(s, 0, first).isBogus()) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        s += first;
+        length -= first;
+        if (length == 0 && !flush) {
+            return;
+        }
+        n2_.normalize(pending16_, normalized16_, errorCode);
+        pending16_.remove();
+        if (U_FAILURE(errorCode)) {
+            return;
+        }
+        dest.appendString(normalized16_.getBuffer(), normalized16_.length());
+    }
+    int32_t limit = flush ? length : lastBoundaryUTF16(n2_, s, length);
+    if (limit > 0) {
+        n2_.normalize(UnicodeString(FALSE, s, limit), normalized16_, errorCode);
+        if (U_FAILURE(errorCode)) {
+            return;
+        }
+        dest.appendString(normalized16_.getBuffer(), normalized16_.length());
+    }
+    if (limit < length &&
+            pending16_.append(s + limit, length - limit).isBogus()) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+    }
+}
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_NORMALIZATION
@@ -89,6 +89,13 @@ class U_COMMON_API SharedObject : public UObject {
      */
     int32_t getRefCount() const;
 
+    /**
+     * Returns an estimate of the number of bytes of heap memory owned by
+     * this object, including the object itself. Reported in UnifiedCache
+     * statistics. The default implementation returns 0, meaning unknown.
+     */
+    virtual int32_t getMemoryFootprint() const;
+
     /**
      * If noHardReferences() == TRUE then this object has no hard references.
      * Must be called only from within the internals of UnifiedCache.
@@ -165,9 +172,10 @@ class U_COMMON_API SharedObject : public UObject {
      * The number of references from the UnifiedCache, which is
      * the number of times that the sharedObject is stored as a hash table value.
      * For use by UnifiedCache implementation code only.
-     * All access is synchronized by UnifiedCache's gCacheMutex
+     * Keys referring to the same value may live in different shards of the
+     * cache, so all access is atomic.
      */
-    mutable int32_t softRefCount;
+    mutable u_atomic_int32_t softRefCount;
     friend class UnifiedCache;
 
     /**
@@ -211,6 +211,121 @@ pointerTOCPrefixBinarySearch(const char *s, const PointerTOCEntry *toc, int32_t
     return -1;
 }
 
+U_CAPI uint32_t U_EXPORT2
+udata_hashTOCName(const char *name, uint32_t seed) {
+    /* FNV-1a, with a final avalanche so that different seeds give unrelated hashes */
+    uint32_t hash=0x811c9dc5u^seed;
+    uint8_t c;
+    while((c=(uint8_t)*name++)!=0) {
+        hash=(hash^c)*0x01000193u;
+    }
+    hash^=hash>>16;
+    hash*=0x85ebca6bu;
+    hash^=hash>>13;
+    hash*=0xc2b2ae35u;
+    hash^=hash>>16;
+    return hash;
+}
+
+U_CAPI uint32_t U_EXPORT2
+udata_checksumTOC(const UDataOffsetTOCEntry *entries, uint32_t count) {
+    uint32_t checksum=count;
+    uint32_t i;
+    for(i=0; i<count; ++i) {
+        checksum=checksum*31+entries[i].nameOffset;
+        checksum=checksum*31+entries[i].dataOffset;
+    }
+    return checksum;
+}
+
+static int32_t
+offsetTOCHashLookup(const char *s, const char *names,
+                    const UDataOffsetTOCEntry *toc, const uint32_t *tocHash) {
+    uint32_t count=tocHash[UDATA_TOC_HASH_IX_ITEM_COUNT];
+    uint32_t bucketCount=tocHash[UDATA_TOC_HASH_IX_BUCKET_COUNT];
+    uint32_t seed=tocHash[UDATA_TOC_HASH_IX_SEED];
+    const uint32_t *displacements=tocHash+UDATA_TOC_HASH_IX_COUNT;
+    const uint32_t *entries=displacements+bucketCount;
+    uint32_t d=displacements[udata_hashTOCName(s, seed)%bucketCount];
+    uint32_t number=entries[udata_hashTOCName(s, UDATA_TOC_HASH_SLOT_SEED(seed, d))%count];
+    if(number<count && 0==uprv_strcmp(s, names+toc[number].nameOffset)) {
+        return (int32_t)number;
+    }
+    return -1;
+}
+
+/*
+ * Finds and validates the optional hash index item of an offset TOC.
+ * Leaves udm->tocHash NULL if there is none or if it does not fit the TOC.
+ */
+static void
+offsetTOCFindHash(UDataMemory *udm) {
+    const UDataOffsetTOC *toc=(const UDataOffsetTOC *)udm->toc;
+    const char *base=(const char *)toc;
+    int32_t count=(int32_t)toc->count;
+    if(count<2) {
+        return;
+    }
+
+    /* the index item has the same package name prefix as the other items */
+    char name[64];
+    const char *firstName=base+toc->entry[0].nameOffset;
+    const char *prefixLimit=uprv_strchr(firstName, U_TREE_ENTRY_SEP_CHAR);
+    if(prefixLimit==NULL) {
+        return;
+    }
+    int32_t prefixLength=(int32_t)(prefixLimit-firstName)+1;
+    if((prefixLength+(int32_t)sizeof(UDATA_TOC_HASH_ITEM_NAME))>(int32_t)sizeof(name)) {
+        return;
+    }
+    uprv_memcpy(name, firstName, prefixLength);
+    uprv_strcpy(name+prefixLength, UDATA_TOC_HASH_ITEM_NAME);
+    int32_t number=offsetTOCPrefixBinarySearch(name, base, toc->entry, count);
+    if(number<0) {
+        return;
+    }
+
+    /*
+     * The length of the index item is bounded by the start of the next item.
+     * The last item's length is not known; then the index must fit the length
+     * derived from its own counts, as for the other last items in a package.
+     */
+    const DataHeader *pHeader=(const DataHeader *)(base+toc->entry[number].dataOffset);
+    int32_t length=-1;
+    if((number+1)<count) {
+        length=(int32_t)(toc->entry[number+1].dataOffset-toc->entry[number].dataOffset);
+        if(length<(int32_t)sizeof(DataHeader)) {
+            return;
+        }
+    }
+    if(!(pHeader->dataHeader.magic1==0xda &&
+        pHeader->dataHeader.magic2==0x27 &&
+        pHeader->info.isBigEndian==U_IS_BIG_ENDIAN &&
+        pHeader->info.charsetFamily==U_CHARSET_FAMILY &&
+        pHeader->info.dataFormat[0]==0x54 &&   /* dataFormat="TocH" */
+        pHeader->info.dataFormat[1]==0x6f &&
+        pHeader->info.dataFormat[2]==0x63 &&
+        pHeader->info.dataFormat[3]==0x48 &&
+        pHeader->info.formatVersion[0]==1)
+    ) {
+        return;
+    }
+    int32_t headerSize=pHeader->dataHeader.headerSize;
+    if((length>=0 && (headerSize+UDATA_TOC_HASH_IX_COUNT*4)>length) || (headerSize&3)!=0) {
+        return;
+    }
+    const uint32_t *tocHash=(const uint32_t *)((const char *)pHeader+headerSize);
+    uint32_t bucketCount=tocHash[UDATA_TOC_HASH_IX_BUCKET_COUNT];
+    if(tocHash[UDATA_TOC_HASH_IX_ITEM_COUNT]!=(uint32_t)count ||
+            bucketCount==0 || bucketCount>(uint32_t)count ||
+            (length>=0 &&
+                (UDATA_TOC_HASH_IX_COUNT+bucketCount+(uint32_t)count)>(uint32_t)(length-headerSize)/4) ||
+            tocHash[UDATA_TOC_HASH_IX_TOC_CHECKSUM]!=udata_checksumTOC(toc->entry, (uint32_t)count)) {
+        return;
+    }
+    udm->tocHash=tocHash;
+}
+
 U_CDECL_BEGIN
 static uint32_t U_CALLCONV
 offsetTOCEntryCount(const UDataMemory *pData) {
@@ -233,14 +348,21 @@ offsetTOCLookupFn(const UDataMemory *pData,
         const char *base=(const char *)toc;
         int32_t number, count=(int32_t)toc->count;
 
-        /* perform a binary search for the data in the common data's table of contents */
+        /*
+         * look up the data in the common data's table of contents,
+         * with its hash index if there is one, otherwise with a binary search
+         */
 #if defined (UDATA_DEBUG_DUMP)
         /* list the contents of the TOC each time .. not recommended */
         for(number=0; number<count; ++number) {
             fprintf(stderr, "\tx%d: %s\n", number, &base[toc->entry[number].nameOffset]);
         }
 #endif
-        number=offsetTOCPrefixBinarySearch(tocEntryName, base, toc->entry, count);
+        if(pData->tocHash!=NULL) {
+            number=offsetTOCHashLookup(tocEntryName, base, toc->entry, pData->tocHash);
+        } else {
+            number=offsetTOCPrefixBinarySearch(tocEntryName, base, toc->entry, count);
+        }
         if(number>=0) {
             /* found it */
             const UDataOffsetTOCEntry *entry=toc->entry+number;
@@ -347,6 +469,8 @@ U_CFUNC void udata_checkCommonData(UDataMemory *udm, UErrorCode *err) {
         /* dataFormat="CmnD" */
         udm->vFuncs = &CmnDFuncs;
         udm->toc=(const char *)udm->pHeader+udata_getHeaderSize(udm->pHeader);
+        udm->tocHash=NULL;
+        offsetTOCFindHash(udm);
     }
     else if(udm->pHeader->info.dataFormat[0]==0x54 &&
         udm->pHeader->info.dataFormat[1]==0x6f &&
@@ -59,6 +59,61 @@ typedef struct {
     UDataOffsetTOCEntry entry[1];
 } UDataOffsetTOC;
 
+/*
+ * Optional hash index over the offset TOC of a common data package.
+ *
+ * Package writers store it as a regular data item with the base name
+ * UDATA_TOC_HASH_ITEM_NAME and dataFormat "TocH". Its data is a minimal
+ * perfect hash function ("hash, displace and compress" without the compression)
+ * from item names to TOC entry numbers:
+ *
+ *   uint32_t indexes[UDATA_TOC_HASH_IX_COUNT];
+ *   uint32_t displacements[bucketCount];
+ *   uint32_t entries[itemCount];
+ *
+ *   d=displacements[udata_hashTOCName(name, seed)%bucketCount];
+ *   number=entries[udata_hashTOCName(name, UDATA_TOC_HASH_SLOT_SEED(seed, d))%itemCount];
+ *
+ * The lookup then compares the name of TOC entry number with the requested one,
+ * so that unknown names are rejected.
+ * The index is used only if its checksum matches the TOC
+ * and if it is in the platform's endianness and charset family,
+ * otherwise the TOC is binary-searched as before.
+ * The index item may be the last item in the package; since the TOC does not
+ * give that item's length, it is then derived from the index's own counts.
+ * Package tools rebuild the index when they write a package and do not list
+ * or extract it like the other items.
+ */
+#define UDATA_TOC_HASH_ITEM_NAME "tochash.icu"
+
+enum {
+    /** Number of TOC entries, including the index item itself. */
+    UDATA_TOC_HASH_IX_ITEM_COUNT,
+    UDATA_TOC_HASH_IX_BUCKET_COUNT,
+    UDATA_TOC_HASH_IX_SEED,
+    /** udata_checksumTOC() of the TOC that the index was built for. */
+    UDATA_TOC_HASH_IX_TOC_CHECKSUM,
+    UDATA_TOC_HASH_IX_COUNT
+};
+
+/** Seed for the second-level hash of a name in a bucket with displacement d. */
+#define UDATA_TOC_HASH_SLOT_SEED(seed, d) ((uint32_t)(seed)+0x9e3779b9u*((uint32_t)(d)+1))
+
+/**
+ * Hash function for item names in the TOC hash index.
+ * @internal
+ */
+U_CAPI uint32_t U_EXPORT2
+udata_hashTOCName(const char *name, uint32_t seed);
+
+/**
+ * Checksum over the TOC entry offsets, in platform endianness,
+ * to detect a TOC hash index that does not belong to its TOC.
+ * @internal
+ */
+U_CAPI uint32_t U_EXPORT2
+udata_checksumTOC(const UDataOffsetTOCEntry *entries, uint32_t count);
+
 /**
  * Get the header size from a const DataHeader *udh.
  * Handles opposite-endian data.
@@ -0,0 +1,504 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// ucnv_bulk.cpp
+// ucnv_convertBulk(): Splits a large source buffer into chunks at positions
+// where the source converter is in its initial state, converts the chunks
+// with ucnv_convertEx() on the threads of a caller-supplied executor,
+// and concatenates the results.
+//
+// A split position is only chosen where the single-threaded conversion
+// would also have finished a character and returned to its initial state.
+// Together with a stateless target converter, this makes each chunk's output
+// independent of the text before it, so that the concatenation is identical
+// to converting the whole buffer at once.
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_CONVERSION
+
+#include "unicode/ucnv.h"
+#include "unicode/uobject.h"
+#include "cmemory.h"
+#include "cstring.h"
+#include "ucnv_bld.h"
+#include "ucnv_ext.h"
+#include "ucnvmbcs.h"
+#include "umutex.h"
+#include "ustr_imp.h"
+
+U_NAMESPACE_USE
+
+namespace {
+
+const int32_t DEFAULT_CHUNK_LENGTH = 0x40000;
+
+// Pivot buffer size for each chunk, in UChars.
+const int32_t PIVOT_CAPACITY = 1024;
+
+// All tasks of all ucnv_convertBulk() calls report their completion via these.
+// Each call waits until its own count of outstanding tasks reaches zero.
+UMutex gBulkMutex = U_MUTEX_INITIALIZER;
+UConditionVar gBulkCondition = U_CONDITION_INITIALIZER;
+
+enum SplitType {
+    SPLIT_NONE,             // the source must be converted in one piece
+    SPLIT_ANYWHERE,         // single-byte charsets without state
+    SPLIT_AFTER_SAFE_BYTE,  // after any byte whose safeBytes[] flag is set
+    SPLIT_UTF16BE,          // at an even index, not after a lead surrogate
+    SPLIT_UTF16LE,
+    SPLIT_UTF32             // at an index divisible by 4
+};
+
+struct Splitter {
+    SplitType type;
+    // For SPLIT_AFTER_SAFE_BYTE: TRUE if the source converter is in its
+    // initial state after any byte sequence that ends with this byte.
+    UBool safeBytes[256];
+};
+
+#if !UCONFIG_NO_LEGACY_CONVERSION
+
+// Marks each byte that continues a partial match in a section of the
+// extension toUnicode table, and recurses into the following sections.
+void removePartialMatchBytes(const uint32_t *toUTable, int32_t index, UBool safeBytes[256]) {
+    const uint32_t *section = toUTable + index;
+    int32_t length = (int32_t)UCNV_EXT_TO_U_GET_BYTE(*section++);
+    for (int32_t i = 0; i < length; ++i) {
+        uint32_t value = UCNV_EXT_TO_U_GET_VALUE(section[i]);
+        if (value != 0 && UCNV_EXT_TO_U_IS_PARTIAL(value)) {
+            safeBytes[UCNV_EXT_TO_U_GET_BYTE(section[i])] = FALSE;
+            removePartialMatchBytes(toUTable, (int32_t)UCNV_EXT_TO_U_GET_PARTIAL_INDEX(value),
+                                    safeBytes);
+        }
+    }
+}
+
+/**
+ * Sets safeBytes[b] for each byte b that always ends a character:
+ * It is a final entry leading back to state 0 in every state,
+ * and it does not continue any multi-byte extension mapping.
+ * Where b is illegal in a non-initial state, the converter backs out of the
+ * illegal sequence and reprocesses b in the initial state, ending there.
+ * @return FALSE if the converter is stateful so that no byte is safe
+ */
+UBool setMBCSSafeBytes(const UConverterMBCSTable &mbcs, UBool safeBytes[256]) {
+    if ((mbcs.outputType & 0xff) == MBCS_OUTPUT_2_SISO || mbcs.dbcsOnlyState != 0) {
+        return FALSE;
+    }
+    for (int32_t b = 0; b < 256; ++b) {
+        safeBytes[b] = TRUE;
+    }
+    for (int32_t state = 0; state < mbcs.countStates; ++state) {
+        const int32_t *row = mbcs.stateTable[state];
+        for (int32_t b = 0; b < 256; ++b) {
+            int32_t entry = row[b];
+            if (MBCS_ENTRY_IS_TRANSITION(entry) || MBCS_ENTRY_FINAL_STATE(entry) != 0 ||
+                    MBCS_ENTRY_FINAL_ACTION(entry) == MBCS_STATE_CHANGE_ONLY) {
+                safeBytes[b] = FALSE;
+            }
+        }
+    }
+    const int32_t *cx = mbcs.extIndexes;
+    if (cx != NULL && cx[UCNV_EXT_TO_U_LENGTH] > 0) {
+        removePartialMatchBytes(UCNV_EXT_ARRAY(cx, UCNV_EXT_TO_U_INDEX, uint32_t), 0, safeBytes);
+    }
+    return TRUE;
+}
+
+/**
+ * Returns TRUE if some extension fromUnicode mapping has more than one code point.
+ * Its input could straddle a chunk boundary.
+ */
+UBool hasMultiCodePointFromUMappings(const int32_t *cx) {
+    const uint32_t *stage3b = UCNV_EXT_ARRAY(cx, UCNV_EXT_FROM_U_STAGE_3B_INDEX, uint32_t);
+    int32_t length = cx[UCNV_EXT_FROM_U_STAGE_3B_LENGTH];
+    for (int32_t i = 0; i < length; ++i) {
+        uint32_t value = stage3b[i];
+        if (value != 0 && UCNV_EXT_FROM_U_IS_PARTIAL(value)) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+#endif  // !UCONFIG_NO_LEGACY_CONVERSION
+
+void initSplitter(const UConverter *cnv, Splitter &splitter) {
+    splitter.type = SPLIT_NONE;
+    switch (ucnv_getType(cnv)) {
+    case UCNV_LATIN_1:
+    case UCNV_US_ASCII:
+        splitter.type = SPLIT_ANYWHERE;
+        break;
+    case UCNV_UTF8:
+        // Any byte sequence ends with an ASCII byte only at a character boundary.
+        for (int32_t b = 0; b < 256; ++b) {
+            splitter.safeBytes[b] = b < 0x80;
+        }
+        splitter.type = SPLIT_AFTER_SAFE_BYTE;
+        break;
+    // The version 1 UTF-16BE/LE converters (UnicodeBig, UnicodeLittle)
+    // handle a BOM at the start of the stream.
+    case UCNV_UTF16_BigEndian:
+        if (UCNV_GET_VERSION(cnv) == 0) {
+            splitter.type = SPLIT_UTF16BE;
+        }
+        break;
+    case UCNV_UTF16_LittleEndian:
+        if (UCNV_GET_VERSION(cnv) == 0) {
+            splitter.type = SPLIT_UTF16LE;
+        }
+        break;
+    case UCNV_UTF32_BigEndian:
+    case UCNV_UTF32_LittleEndian:
+        splitter.type = SPLIT_UTF32;
+        break;
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    case UCNV_SBCS:
+    case UCNV_DBCS:
+    case UCNV_MBCS:
+        if (setMBCSSafeBytes(cnv->sharedData->mbcs, splitter.safeBytes)) {
+            splitter.type = SPLIT_AFTER_SAFE_BYTE;
+        }
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+/**
+ * Returns TRUE if the converter writes each code point's bytes
+ * independent of the surrounding text.
+ */
+UBool isStatelessFromUnicode(const UConverter *cnv) {
+    switch (ucnv_getType(cnv)) {
+    case UCNV_LATIN_1:
+    case UCNV_US_ASCII:
+    case UCNV_UTF8:
+    case UCNV_UTF32_BigEndian:
+    case UCNV_UTF32_LittleEndian:
+        return TRUE;
+    case UCNV_UTF16_BigEndian:
+    case UCNV_UTF16_LittleEndian:
+        // The version 1 converters write a BOM first.
+        return UCNV_GET_VERSION(cnv) == 0;
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    case UCNV_SBCS:
+    case UCNV_DBCS:
+    case UCNV_MBCS: {
+        const int32_t *cx = cnv->sharedData->mbcs.extIndexes;
+        return cx == NULL || !hasMultiCodePointFromUMappings(cx);
+    }
+#endif
+    default:
+        return FALSE;
+    }
+}
+
+/**
+ * Returns the first split position p with start<=p<limit,
+ * so that s[p-1] ends a character, or -1 if there is none.
+ */
+int32_t findSplit(const Splitter &splitter, const uint8_t *s, int32_t start, int32_t limit) {
+    int32_t p = start;
+    switch (splitter.type) {
+    case SPLIT_ANYWHERE:
+        return p < limit ? p : -1;
+    case SPLIT_AFTER_SAFE_BYTE:
+        for (; p < limit; ++p) {
+            if (splitter.safeBytes[s[p - 1]]) {
+                return p;
+            }
+        }
+        return -1;
+    case SPLIT_UTF16BE:
+    case SPLIT_UTF16LE:
+        for (p += p & 1; p < limit; p += 2) {
+            uint8_t high = splitter.type == SPLIT_UTF16BE ? s[p - 2] : s[p - 1];
+            if ((high & 0xfc) != 0xd8) {
+                return p;
+            }
+        }
+        return -1;
+    case SPLIT_UTF32:
+        p = (p + 3) & ~3;
+        return p < limit ? p : -1;
+    default:
+        return -1;
+    }
+}
+
+class BulkTask : public UMemory {
+public:
+    BulkTask() : targetCnv(NULL), sourceCnv(NULL), ownsConverters(FALSE),
+                 source(NULL), sourceLength(0), withOffsets(FALSE),
+                 length(0), errorCode(U_ZERO_ERROR), pRemaining(NULL) {}
+    ~BulkTask() {
+        if (ownsConverters) {
+            ucnv_close(targetCnv);
+            ucnv_close(sourceCnv);
+        }
+    }
+
+    void convert();
+
+    UConverter *targetCnv;
+    UConverter *sourceCnv;
+    UBool ownsConverters;
+    const char *source;
+    int32_t sourceLength;
+    UBool withOffsets;
+
+    MaybeStackArray<char, 40> output;
+    // Source indexes relative to the start of this chunk, if withOffsets.
+    MaybeStackArray<int32_t, 40> offsets;
+    int32_t length;
+    UErrorCode errorCode;
+
+    // Number of tasks of this ucnv_convertBulk() call that have not finished,
+    // guarded by gBulkMutex.
+    int32_t *pRemaining;
+
+private:
+    UBool grow();
+    void convertWithOffsets();
+};
+
+UBool BulkTask::grow() {
+    int32_t capacity = output.getCapacity();
+    int32_t newCapacity = capacity <= 0x3fffffff ? 2 * capacity : 0x7fffffff;
+    if (newCapacity == capacity || output.resize(newCapacity, length) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void BulkTask::convert() {
+    if (withOffsets) {
+        convertWithOffsets();
+        return;
+    }
+    if (output.resize(sourceLength + 16) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    const char *s = source;
+    const char *sourceLimit = source + sourceLength;
+    UChar pivot[PIVOT_CAPACITY];
+    UChar *pivotSource = pivot, *pivotTarget = pivot;
+    UBool reset = TRUE;
+    for (;;) {
+        char *t = output.getAlias() + length;
+        ucnv_convertEx(targetCnv, sourceCnv,
+                       &t, output.getAlias() + output.getCapacity(),
+                       &s, sourceLimit,
+                       pivot, &pivotSource, &pivotTarget, pivot + PIVOT_CAPACITY,
+                       reset, TRUE, &errorCode);
+        length = (int32_t)(t - output.getAlias());
+        if (errorCode != U_BUFFER_OVERFLOW_ERROR) {
+            break;
+        }
+        // Continue where the conversion stopped.
+        errorCode = U_ZERO_ERROR;
+        reset = FALSE;
+        if (!grow()) {
+            break;
+        }
+    }
+}
+
+// ucnv_convertEx() does not provide offsets, so this converts the whole
+// chunk to UTF-16 and then from UTF-16, and composes the two sets of offsets.
+// Bytes or UChars that overflow the target are buffered in the converter and
+// get offsets of -1 when they are written by the next call, so on overflow
+// each pass starts over with a larger buffer, rather than continuing.
+void BulkTask::convertWithOffsets() {
+    MaybeStackArray<UChar, 40> pivot;
+    MaybeStackArray<int32_t, 40> pivotOffsets;
+    int32_t pivotCapacity = sourceLength + 16;
+    int32_t pivotLength;
+    do {
+        if (pivot.resize(pivotCapacity) == NULL || pivotOffsets.resize(pivotCapacity) == NULL) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        errorCode = U_ZERO_ERROR;
+        ucnv_resetToUnicode(sourceCnv);
+        const char *s = source;
+        UChar *p = pivot.getAlias();
+        ucnv_toUnicode(sourceCnv, &p, p + pivotCapacity, &s, source + sourceLength,
+                       pivotOffsets.getAlias(), TRUE, &errorCode);
+        pivotLength = (int32_t)(p - pivot.getAlias());
+        pivotCapacity *= 2;
+    } while (errorCode == U_BUFFER_OVERFLOW_ERROR);
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+
+    int32_t capacity = UCNV_GET_MAX_BYTES_FOR_STRING(pivotLength, ucnv_getMaxCharSize(targetCnv));
+    do {
+        if (output.resize(capacity) == NULL || offsets.resize(capacity) == NULL) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        errorCode = U_ZERO_ERROR;
+        ucnv_resetFromUnicode(targetCnv);
+        const UChar *ps = pivot.getAlias();
+        char *t = output.getAlias();
+        ucnv_fromUnicode(targetCnv, &t, t + capacity, &ps, ps + pivotLength,
+                         offsets.getAlias(), TRUE, &errorCode);
+        length = (int32_t)(t - output.getAlias());
+        capacity *= 2;
+    } while (errorCode == U_BUFFER_OVERFLOW_ERROR);
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+
+    // Map target-to-pivot offsets to target-to-source offsets.
+    int32_t *o = offsets.getAlias();
+    const int32_t *po = pivotOffsets.getAlias();
+    for (int32_t i = 0; i < length; ++i) {
+        if (o[i] >= 0) {
+            o[i] = po[o[i]];
+        }
+    }
+}
+
+void U_CALLCONV runBulkTask(void *task) {
+    BulkTask *bulkTask = static_cast<BulkTask *>(task);
+    bulkTask->convert();
+    umtx_lock(&gBulkMutex);
+    if (--*bulkTask->pRemaining == 0) {
+        umtx_condBroadcast(&gBulkCondition);
+    }
+    umtx_unlock(&gBulkMutex);
+}
+
+}  // namespace
+
+U_CAPI int32_t U_EXPORT2
+ucnv_convertBulk(UConverter *targetCnv, UConverter *sourceCnv,
+                 char *target, int32_t targetCapacity,
+                 const char *source, int32_t sourceLength,
+                 int32_t *offsets, int32_t chunkLength,
+                 UExecutorFn *executor, const void *executorContext,
+                 UErrorCode *pErrorCode) {
+    if (U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if (targetCnv == NULL || sourceCnv == NULL ||
+            targetCapacity < 0 || (target == NULL && targetCapacity > 0) ||
+            sourceLength < -1 || (source == NULL && sourceLength != 0)) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    if (sourceLength < 0) {
+        sourceLength = (int32_t)uprv_strlen(source);
+    }
+    if (chunkLength <= 0) {
+        chunkLength = DEFAULT_CHUNK_LENGTH;
+    }
+
+    // Find the chunk boundaries.
+    MaybeStackArray<int32_t, 16> starts;
+    int32_t count = 1;
+    starts[0] = 0;
+    if (executor != NULL && isStatelessFromUnicode(targetCnv)) {
+        Splitter splitter;
+        initSplitter(sourceCnv, splitter);
+        const uint8_t *s = reinterpret_cast<const uint8_t *>(source);
+        int32_t start = 0;
+        while (splitter.type != SPLIT_NONE && (sourceLength - start) > chunkLength) {
+            int32_t p = findSplit(splitter, s, start + chunkLength, sourceLength);
+            if (p < 0) {
+                break;
+            }
+            if (count == starts.getCapacity() &&
+                    starts.resize(2 * count, count) == NULL) {
+                *pErrorCode = U_MEMORY_ALLOCATION_ERROR;
+                return 0;
+            }
+            starts[count++] = start = p;
+        }
+    }
+
+    LocalArray<BulkTask> tasks(new BulkTask[count]);
+    if (tasks.isNull()) {
+        *pErrorCode = U_MEMORY_ALLOCATION_ERROR;
+        return 0;
+    }
+    int32_t remaining = count - 1;
+    for (int32_t i = 0; i < count; ++i) {
+        BulkTask &task = tasks[i];
+        if (i == 0) {
+            // The first chunk is converted with the caller's converters.
+            task.targetCnv = targetCnv;
+            task.sourceCnv = sourceCnv;
+        } else {
+            // Clones allocate memory and set a warning code that is not passed on.
+            UErrorCode cloneErrorCode = U_ZERO_ERROR;
+            task.ownsConverters = TRUE;
+            task.targetCnv = ucnv_safeClone(targetCnv, NULL, NULL, &cloneErrorCode);
+            task.sourceCnv = ucnv_safeClone(sourceCnv, NULL, NULL, &cloneErrorCode);
+            if (U_FAILURE(cloneErrorCode)) {
+                *pErrorCode = cloneErrorCode;
+                return 0;
+            }
+        }
+        int32_t limit = i + 1 < count ? starts[i + 1] : sourceLength;
+        task.source = source + starts[i];
+        task.sourceLength = limit - starts[i];
+        task.withOffsets = offsets != NULL;
+        task.pRemaining = &remaining;
+    }
+
+    // Hand out all but the first chunk, then convert the first one on this thread.
+    for (int32_t i = 1; i < count; ++i) {
+        executor(executorContext, runBulkTask, &tasks[i]);
+    }
+    tasks[0].convert();
+    if (count > 1) {
+        umtx_lock(&gBulkMutex);
+        while (remaining > 0) {
+            umtx_condWait(&gBulkCondition, &gBulkMutex);
+        }
+        umtx_unlock(&gBulkMutex);
+    }
+
+    // Report the first failure in text order, and concatenate.
+    int32_t length = 0;
+    for (int32_t i = 0; i < count; ++i) {
+        const BulkTask &task = tasks[i];
+        if (U_FAILURE(task.errorCode)) {
+            *pErrorCode = task.errorCode;
+            return 0;
+        }
+        if (task.length > 0x7fffffff - length) {
+            *pErrorCode = U_INDEX_OUTOFBOUNDS_ERROR;
+            return 0;
+        }
+        length += task.length;
+    }
+    if (length <= targetCapacity) {
+        char *t = target;
+        for (int32_t i = 0; i < count; ++i) {
+            const BulkTask &task = tasks[i];
+            uprv_memcpy(t, task.output.getAlias(), task.length);
+            if (offsets != NULL) {
+                const int32_t *taskOffsets = task.offsets.getAlias();
+                int32_t sourceStart = starts[i];
+                for (int32_t j = 0; j < task.length; ++j) {
+                    int32_t offset = taskOffsets[j];
+                    *offsets++ = offset >= 0 ? sourceStart + offset : -1;
+                }
+            }
+            t += task.length;
+        }
+    }
+    return u_terminateChars(target, targetCapacity, length, pErrorCode);
+}
+
+#endif  // !UCONFIG_NO_CONVERSION
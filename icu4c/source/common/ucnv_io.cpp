@@ -115,6 +115,19 @@
  * and all strings lowercased. In the future, the options in section 7 may state
  * other types of normalization.
  *
+ * 10) Starting in ICU 63, this can be a hash table for the sorted unique aliases
+ * in section 3, so that an alias lookup does not need a binary search.
+ * It is only written together with section 9. Its first 16-bit unit is the
+ * charset family of the strings that were hashed, followed by a power-of-2
+ * number of slots. Each slot is either 0 (empty) or 1 + an index into
+ * section 3. A normalized alias is looked up with open addressing:
+ * Start at slot ucnv_io_hashNormalizedName(alias) & (number of slots - 1),
+ * and move to the following slot (with wraparound) until the slot is empty
+ * or its normalized alias string in section 9 equals the one looked for.
+ * At most half of the slots are used. The table is ignored if its charset
+ * family differs from the platform's, for example after swapping the data
+ * to another charset family, which also re-sorts section 3.
+ *
  * Here is the concept of section 5 and 6. It's a 3D cube. Each tag
  * has a unique alias among all converters. That same alias can
  * be mentioned in other standards on different converters,
@@ -188,6 +201,7 @@ enum {
     tableOptionsIndex=7,
     stringTableIndex=8,
     normalizedStringTableIndex=9,
+    aliasHashTableIndex=10,
     offsetsCount,    /* length of the swapper's temporary offsets[] */
     minTocLength=8 /* min. tocLength in the file, does not count the tocLengthIndex! */
 };
@@ -198,6 +212,17 @@ static const UConverterAliasOptions defaultTableOptions = {
 };
 static UConverterAlias gMainTable;
 
+/*
+ * Cache of recently found aliases, indexed by a case-insensitive hash of the
+ * name that was looked up. Each entry is 1 + an index into gMainTable.aliasList,
+ * or 0 if empty. An entry is used only if the name equals the alias string
+ * itself except for case. It stores no name copies, so it needs no locking.
+ * Charset names in protocols are usually spelled the same way as in convrtrs.txt,
+ * and such names are found without normalizing them.
+ */
+#define RECENT_ALIASES_LENGTH 64
+static icu::u_atomic_int32_t gRecentAliases[RECENT_ALIASES_LENGTH];
+
 #define GET_STRING(idx) (const char *)(gMainTable.stringTable + (idx))
 #define GET_NORMALIZED_STRING(idx) (const char *)(gMainTable.normalizedStringTable + (idx))
 
@@ -225,6 +250,9 @@ static UBool U_CALLCONV ucnv_io_cleanup(void)
     gAliasDataInitOnce.reset();
 
     uprv_memset(&gMainTable, 0, sizeof(gMainTable));
+    for (int32_t i = 0; i < RECENT_ALIASES_LENGTH; ++i) {
+        icu::umtx_storeRelease(gRecentAliases[i], 0);
+    }
 
     return TRUE;                   /* Everything was cleaned up */
 }
@@ -267,6 +295,9 @@ static void U_CALLCONV initAliasData(UErrorCode &errCode) {
     if (tableStart > 8) {
         gMainTable.normalizedStringTableSize = sectionSizes[9];
     }
+    if (tableStart > 9) {
+        gMainTable.aliasHashTableSize = sectionSizes[10];
+    }
 
     currOffset = tableStart * (sizeof(uint32_t)/sizeof(uint16_t)) + (sizeof(uint32_t)/sizeof(uint16_t));
     gMainTable.converterList = table + currOffset;
@@ -306,6 +337,24 @@ static void U_CALLCONV initAliasData(UErrorCode &errCode) {
     currOffset += gMainTable.stringTableSize;
     gMainTable.normalizedStringTable = ((gMainTable.optionTable->stringNormalizationType == UCNV_IO_UNNORMALIZED)
         ? gMainTable.stringTable : (table + currOffset));
+
+    currOffset += gMainTable.normalizedStringTableSize;
+    /* The first unit is the charset family, followed by a power-of-2 number of slots. */
+    uint32_t hashTableSize = gMainTable.aliasHashTableSize - 1;
+    if (gMainTable.aliasHashTableSize > 1
+        && (hashTableSize & (hashTableSize - 1)) == 0
+        && hashTableSize >= 2 * gMainTable.aliasListSize
+        && gMainTable.optionTable->stringNormalizationType == UCNV_IO_STD_NORMALIZED
+        && table[currOffset] == U_CHARSET_FAMILY)
+    {
+        gMainTable.aliasHashTable = table + currOffset + 1;
+        gMainTable.aliasHashTableSize = hashTableSize;
+    }
+    else {
+        /* No alias hash table, or one for another charset family. Use binary search. */
+        gMainTable.aliasHashTable = NULL;
+        gMainTable.aliasHashTableSize = 0;
+    }
 }
 
 
@@ -544,12 +593,36 @@ ucnv_compareNames(const char *name1, const char *name2) {
     }
 }
 
+U_CAPI uint32_t U_EXPORT2
+ucnv_io_hashNormalizedName(const char *name) {
+    /* FNV-1a */
+    uint32_t hash = 0x811c9dc5;
+    uint8_t c;
+    while ((c = (uint8_t)*name++) != 0) {
+        hash = (hash ^ c) * 0x01000193;
+    }
+    return hash;
+}
+
 /*
- * search for an alias
- * return the converter number index for gConverterList
+ * Hash function for gRecentAliases, ignoring case like uprv_stricmp().
  */
 static inline uint32_t
-findConverter(const char *alias, UBool *containsOption, UErrorCode *pErrorCode) {
+hashRecentAlias(const char *alias) {
+    uint32_t hash = 0;
+    char c;
+    while ((c = *alias++) != 0) {
+        hash = hash * 37 + (uint8_t)uprv_tolower(c);
+    }
+    return hash & (RECENT_ALIASES_LENGTH - 1);
+}
+
+/*
+ * search for an alias
+ * return the alias number index for gAliasList
+ */
+static uint32_t
+findAlias(const char *alias, UErrorCode *pErrorCode) {
     uint32_t mid, start, limit;
     uint32_t lastMid;
     int result;
@@ -565,6 +638,22 @@ findConverter(const char *alias, UBool *containsOption, UErrorCode *pErrorCode)
         /* Lower case and remove ignoreable characters. */
         ucnv_io_stripForCompare(strippedName, alias);
         alias = strippedName;
+
+        if (gMainTable.aliasHashTable != NULL) {
+            /* look up the alias in the hash table; at most half of the slots are used */
+            uint32_t mask = gMainTable.aliasHashTableSize - 1;
+            uint32_t slot = ucnv_io_hashNormalizedName(alias) & mask;
+            uint32_t value;
+            while ((value = gMainTable.aliasHashTable[slot]) != 0) {
+                if (value <= gMainTable.aliasListSize
+                    && uprv_strcmp(alias, GET_NORMALIZED_STRING(gMainTable.aliasList[value - 1])) == 0)
+                {
+                    return value - 1;
+                }
+                slot = (slot + 1) & mask;
+            }
+            return UINT32_MAX;
+        }
     }
 
     /* do a binary search for the alias */
@@ -591,28 +680,56 @@ findConverter(const char *alias, UBool *containsOption, UErrorCode *pErrorCode)
         } else if (result > 0) {
             start = mid;
         } else {
-            /* Since the gencnval tool folds duplicates into one entry,
-             * this alias in gAliasList is unique, but different standards
-             * may map an alias to different converters.
-             */
-            if (gMainTable.untaggedConvArray[mid] & UCNV_AMBIGUOUS_ALIAS_MAP_BIT) {
-                *pErrorCode = U_AMBIGUOUS_ALIAS_WARNING;
-            }
-            /* State whether the canonical converter name contains an option.
-            This information is contained in this list in order to maintain backward & forward compatibility. */
-            if (containsOption) {
-                UBool containsCnvOptionInfo = (UBool)gMainTable.optionTable->containsCnvOptionInfo;
-                *containsOption = (UBool)((containsCnvOptionInfo
-                    && ((gMainTable.untaggedConvArray[mid] & UCNV_CONTAINS_OPTION_BIT) != 0))
-                    || !containsCnvOptionInfo);
-            }
-            return gMainTable.untaggedConvArray[mid] & UCNV_CONVERTER_INDEX_MASK;
+            return mid;
         }
     }
 
     return UINT32_MAX;
 }
 
+/*
+ * search for an alias
+ * return the converter number index for gConverterList
+ */
+static inline uint32_t
+findConverter(const char *alias, UBool *containsOption, UErrorCode *pErrorCode) {
+    uint32_t aliasNum;
+    uint32_t recentIndex = hashRecentAlias(alias);
+    uint32_t recent = (uint32_t)icu::umtx_loadAcquire(gRecentAliases[recentIndex]);
+
+    if (recent != 0 && recent <= gMainTable.aliasListSize
+        && uprv_stricmp(alias, GET_STRING(gMainTable.aliasList[recent - 1])) == 0)
+    {
+        aliasNum = recent - 1;
+    }
+    else {
+        aliasNum = findAlias(alias, pErrorCode);
+        if (aliasNum == UINT32_MAX) {
+            return UINT32_MAX;
+        }
+        if (uprv_stricmp(alias, GET_STRING(gMainTable.aliasList[aliasNum])) == 0) {
+            icu::umtx_storeRelease(gRecentAliases[recentIndex], (int32_t)(aliasNum + 1));
+        }
+    }
+
+    /* Since the gencnval tool folds duplicates into one entry,
+     * this alias in gAliasList is unique, but different standards
+     * may map an alias to different converters.
+     */
+    if (gMainTable.untaggedConvArray[aliasNum] & UCNV_AMBIGUOUS_ALIAS_MAP_BIT) {
+        *pErrorCode = U_AMBIGUOUS_ALIAS_WARNING;
+    }
+    /* State whether the canonical converter name contains an option.
+    This information is contained in this list in order to maintain backward & forward compatibility. */
+    if (containsOption) {
+        UBool containsCnvOptionInfo = (UBool)gMainTable.optionTable->containsCnvOptionInfo;
+        *containsOption = (UBool)((containsCnvOptionInfo
+            && ((gMainTable.untaggedConvArray[aliasNum] & UCNV_CONTAINS_OPTION_BIT) != 0))
+            || !containsCnvOptionInfo);
+    }
+    return gMainTable.untaggedConvArray[aliasNum] & UCNV_CONVERTER_INDEX_MASK;
+}
+
 /*
  * Is this alias in this list?
  * alias and listOffset should be non-NULL.
@@ -1342,6 +1459,19 @@ ucnv_swapAliases(const UDataSwapper *ds,
                             outTable+offsets[taggedAliasArrayIndex],
                             pErrorCode);
         }
+
+        /*
+         * swap the alias hash table
+         * If the charset family changes, then its slots no longer match the re-sorted
+         * alias list, but the table is also ignored because of its charset family field.
+         */
+        if(tocLength>=aliasHashTableIndex) {
+            ds->swapArray16(ds,
+                            inTable+offsets[aliasHashTableIndex],
+                            2*(int32_t)toc[aliasHashTableIndex],
+                            outTable+offsets[aliasHashTableIndex],
+                            pErrorCode);
+        }
     }
 
     return headerSize+2*(int32_t)topOffset;
@@ -48,6 +48,8 @@ typedef struct UConverterAlias {
     const UConverterAliasOptions *optionTable;
     const uint16_t *stringTable;
     const uint16_t *normalizedStringTable;
+    /* Slots of the alias hash table, or NULL if there is none or it is unusable. */
+    const uint16_t *aliasHashTable;
 
     uint32_t converterListSize;
     uint32_t tagListSize;
@@ -58,6 +60,8 @@ typedef struct UConverterAlias {
     uint32_t optionTableSize;
     uint32_t stringTableSize;
     uint32_t normalizedStringTableSize;
+    /* Number of slots in aliasHashTable, a power of 2. */
+    uint32_t aliasHashTableSize;
 } UConverterAlias;
 
 /**
@@ -83,6 +87,16 @@ ucnv_io_stripASCIIForCompare(char *dst, const char *name);
 U_CAPI char * U_CALLCONV
 ucnv_io_stripEBCDICForCompare(char *dst, const char *name);
 
+/**
+ * Hash function for normalized alias names in the alias hash table
+ * of cnvalias.icu. See ucnv_io.cpp for the data format.
+ * @param name a name normalized with ucnv_io_stripForCompare()
+ * @return the hash code
+ * @internal
+ */
+U_CAPI uint32_t U_EXPORT2
+ucnv_io_hashNormalizedName(const char *name);
+
 /**
  * Map a converter alias name to a canonical converter name.
  * The alias is searched for case-insensitively, the converter name
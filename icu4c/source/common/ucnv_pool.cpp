@@ -0,0 +1,190 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// ucnv_pool.cpp
+// Pool of idle converters for ucnv_acquireFromPool() and ucnv_releaseToPool().
+//
+// An idle converter keeps its reference to the shared converter data,
+// so taking it out of the pool neither allocates memory
+// nor touches the shared-data cache and its global mutex.
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_CONVERSION
+
+#include "unicode/ucnv.h"
+#include "cmemory.h"
+#include "cstring.h"
+#include "ucnv_bld.h"
+#include "ucnv_imp.h"
+#include "ucnv_io.h"
+#include "umutex.h"
+
+U_NAMESPACE_USE
+
+namespace {
+
+struct PoolEntry {
+    // Canonical name from ucnv_getName(), owned by the converter.
+    const char *name;
+    UConverter *cnv;
+};
+
+// Pools do not allocate their own mutexes because a UMutex must be statically
+// initialized. Each pool uses one of these, assigned round-robin.
+// Pools are meant to be used by one thread at a time,
+// so sharing a mutex between pools rarely causes any contention.
+const int32_t POOL_MUTEX_COUNT = 8;
+
+UMutex gPoolMutexes[POOL_MUTEX_COUNT] = {
+    U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER,
+    U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER
+};
+
+u_atomic_int32_t gNextPoolMutex = ATOMIC_INT32_T_INITIALIZER(0);
+
+/**
+ * Returns TRUE if ucnv_reset() returns the converter to the state
+ * that ucnv_open() would have created it in.
+ */
+UBool isResettable(const UConverter *cnv) {
+    const UConverterStaticData *staticData = cnv->sharedData->staticData;
+    return
+        !cnv->isCopyLocal &&
+        cnv->fromCharErrorBehaviour == UCNV_TO_U_DEFAULT_CALLBACK &&
+        cnv->fromUCharErrorBehaviour == UCNV_FROM_U_DEFAULT_CALLBACK &&
+        cnv->toUContext == NULL && cnv->fromUContext == NULL &&
+        !cnv->useFallback &&
+        cnv->subChars == (uint8_t *)cnv->subUChars &&
+        cnv->subCharLen == staticData->subCharLen &&
+        uprv_memcmp(cnv->subChars, staticData->subChar, cnv->subCharLen) == 0 &&
+        cnv->subChar1 == staticData->subChar1;
+}
+
+}  // namespace
+
+U_CDECL_BEGIN
+
+struct UConverterPool {
+    UMutex *mutex;
+    int32_t capacity;
+    int32_t length;
+    PoolEntry *entries;  // capacity entries follow the struct in the same block
+};
+
+U_CDECL_END
+
+U_CAPI UConverterPool * U_EXPORT2
+ucnv_openPool(int32_t capacity, UErrorCode *pErrorCode) {
+    if (U_FAILURE(*pErrorCode)) {
+        return NULL;
+    }
+    if (capacity < 0 || capacity > 0x10000) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    UConverterPool *pool = (UConverterPool *)uprv_malloc(
+        sizeof(UConverterPool) + capacity * sizeof(PoolEntry));
+    if (pool == NULL) {
+        *pErrorCode = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    int32_t i = umtx_atomic_inc(&gNextPoolMutex);
+    pool->mutex = &gPoolMutexes[i & (POOL_MUTEX_COUNT - 1)];
+    pool->capacity = capacity;
+    pool->length = 0;
+    pool->entries = (PoolEntry *)(pool + 1);
+    return pool;
+}
+
+U_CAPI void U_EXPORT2
+ucnv_closePool(UConverterPool *pool) {
+    if (pool == NULL) {
+        return;
+    }
+    for (int32_t i = 0; i < pool->length; ++i) {
+        ucnv_close(pool->entries[i].cnv);
+    }
+    uprv_free(pool);
+}
+
+U_CAPI UConverter * U_EXPORT2
+ucnv_acquireFromPool(UConverterPool *pool, const char *converterName, UErrorCode *pErrorCode) {
+    if (U_FAILURE(*pErrorCode)) {
+        return NULL;
+    }
+    if (pool == NULL) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    if (converterName == NULL || *converterName == 0) {
+        converterName = ucnv_getDefaultName();
+    }
+
+    // Find the name that ucnv_getName() returns for this converter.
+    // Names with explicit options are passed straight to ucnv_open().
+    const char *key = NULL;
+    if (UCNV_FAST_IS_UTF8(converterName)) {
+        key = "UTF-8";
+    } else if (uprv_strchr(converterName, UCNV_OPTION_SEP_CHAR) == NULL) {
+        UErrorCode errorCode = U_ZERO_ERROR;
+        UBool containsOption;
+        key = ucnv_io_getConverterName(converterName, &containsOption, &errorCode);
+        if (U_FAILURE(errorCode) || key == NULL) {
+            // Not an alias, for example an algorithmic converter name
+            // or a .cnv file in a custom data package.
+            key = converterName;
+        }
+    }
+
+    if (key != NULL) {
+        UConverter *cnv = NULL;
+        umtx_lock(pool->mutex);
+        // The most recently released converters are the most likely ones to match.
+        for (int32_t i = pool->length; i > 0;) {
+            PoolEntry &entry = pool->entries[--i];
+            if (uprv_strcmp(entry.name, key) == 0) {
+                cnv = entry.cnv;
+                entry = pool->entries[--pool->length];
+                break;
+            }
+        }
+        umtx_unlock(pool->mutex);
+        if (cnv != NULL) {
+            return cnv;
+        }
+    }
+    return ucnv_open(converterName, pErrorCode);
+}
+
+U_CAPI void U_EXPORT2
+ucnv_releaseToPool(UConverterPool *pool, UConverter *cnv) {
+    if (cnv == NULL) {
+        return;
+    }
+    if (pool == NULL || !isResettable(cnv)) {
+        ucnv_close(cnv);
+        return;
+    }
+    UErrorCode errorCode = U_ZERO_ERROR;
+    const char *name = ucnv_getName(cnv, &errorCode);
+    if (U_FAILURE(errorCode)) {
+        ucnv_close(cnv);
+        return;
+    }
+    ucnv_reset(cnv);
+
+    umtx_lock(pool->mutex);
+    UBool isPooled = pool->length < pool->capacity;
+    if (isPooled) {
+        PoolEntry &entry = pool->entries[pool->length++];
+        entry.name = name;
+        entry.cnv = cnv;
+    }
+    umtx_unlock(pool->mutex);
+    if (!isPooled) {
+        ucnv_close(cnv);
+    }
+}
+
+#endif  // !UCONFIG_NO_CONVERSION
@@ -33,6 +33,7 @@
 #include "ucnv_cnv.h"
 #include "cmemory.h"
 #include "ustr_imp.h"
+#include "usimd.h"
 
 /* Prototypes --------------------------------------------------------------- */
 
@@ -73,7 +74,7 @@ static void  U_CALLCONV ucnv_toUnicode_UTF8 (UConverterToUnicodeArgs * args,
     unsigned char *toUBytes = cnv->toUBytes;
     UBool isCESU8 = hasCESU8Data(cnv);
     uint32_t ch, ch2 = 0;
-    int32_t i, inBytes;
+    int32_t i, inBytes, count;
 
     /* Restore size of current sequence */
     if (cnv->toULength > 0 && myTarget < targetLimit)
@@ -94,6 +95,16 @@ static void  U_CALLCONV ucnv_toUnicode_UTF8 (UConverterToUnicodeArgs * args,
         if (U8_IS_SINGLE(ch))        /* Simple case */
         {
             *(myTarget++) = (UChar) ch;
+            /* Copy a following run of ASCII bytes in bulk. */
+            count = (int32_t)(sourceLimit - mySource);
+            if (count > (targetLimit - myTarget)) {
+                count = (int32_t)(targetLimit - myTarget);
+            }
+            if (count >= 16) {
+                count = uprv_copyASCIIToUTF16(mySource, myTarget, count);
+                mySource += count;
+                myTarget += count;
+            }
         }
         else
         {
@@ -191,7 +202,7 @@ static void  U_CALLCONV ucnv_toUnicode_UTF8_OFFSETS_LOGIC (UConverterToUnicodeAr
     unsigned char *toUBytes = cnv->toUBytes;
     UBool isCESU8 = hasCESU8Data(cnv);
     uint32_t ch, ch2 = 0;
-    int32_t i, inBytes;
+    int32_t i, inBytes, count;
 
     /* Restore size of current sequence */
     if (cnv->toULength > 0 && myTarget < targetLimit)
@@ -212,6 +223,20 @@ static void  U_CALLCONV ucnv_toUnicode_UTF8_OFFSETS_LOGIC (UConverterToUnicodeAr
         {
             *(myTarget++) = (UChar) ch;
             *(myOffsets++) = offsetNum++;
+            /* Copy a following run of ASCII bytes in bulk. */
+            count = (int32_t)(sourceLimit - mySource);
+            if (count > (targetLimit - myTarget)) {
+                count = (int32_t)(targetLimit - myTarget);
+            }
+            if (count >= 16) {
+                count = uprv_copyASCIIToUTF16(mySource, myTarget, count);
+                mySource += count;
+                myTarget += count;
+                while (count > 0) {
+                    *(myOffsets++) = offsetNum++;
+                    --count;
+                }
+            }
         }
         else
         {
@@ -308,7 +333,7 @@ U_CFUNC void  U_CALLCONV ucnv_fromUnicode_UTF8 (UConverterFromUnicodeArgs * args
     uint8_t *tempPtr;
     UChar32 ch;
     uint8_t tempBuf[4];
-    int32_t indexToWrite;
+    int32_t indexToWrite, count;
     UBool isNotCESU8 = !hasCESU8Data(cnv);
 
     if (cnv->fromUChar32 && myTarget < targetLimit)
@@ -325,6 +350,16 @@ U_CFUNC void  U_CALLCONV ucnv_fromUnicode_UTF8 (UConverterFromUnicodeArgs * args
         if (ch < 0x80)        /* Single byte */
         {
             *(myTarget++) = (uint8_t) ch;
+            /* Copy a following run of ASCII UChars in bulk. */
+            count = (int32_t)(sourceLimit - mySource);
+            if (count > (targetLimit - myTarget)) {
+                count = (int32_t)(targetLimit - myTarget);
+            }
+            if (count >= 16) {
+                count = uprv_copyASCIIToUTF8(mySource, myTarget, count);
+                mySource += count;
+                myTarget += count;
+            }
         }
         else if (ch < 0x800)  /* Double byte */
         {
@@ -423,7 +458,7 @@ U_CFUNC void  U_CALLCONV ucnv_fromUnicode_UTF8_OFFSETS_LOGIC (UConverterFromUnic
     uint8_t *tempPtr;
     UChar32 ch;
     int32_t offsetNum, nextSourceIndex;
-    int32_t indexToWrite;
+    int32_t indexToWrite, count;
     uint8_t tempBuf[4];
     UBool isNotCESU8 = !hasCESU8Data(cnv);
 
@@ -446,6 +481,20 @@ U_CFUNC void  U_CALLCONV ucnv_fromUnicode_UTF8_OFFSETS_LOGIC (UConverterFromUnic
         {
             *(myOffsets++) = offsetNum++;
             *(myTarget++) = (char) ch;
+            /* Copy a following run of ASCII UChars in bulk. */
+            count = (int32_t)(sourceLimit - mySource);
+            if (count > (targetLimit - myTarget)) {
+                count = (int32_t)(targetLimit - myTarget);
+            }
+            if (count >= 16) {
+                count = uprv_copyASCIIToUTF8(mySource, myTarget, count);
+                mySource += count;
+                myTarget += count;
+                while (count > 0) {
+                    *(myOffsets++) = offsetNum++;
+                    --count;
+                }
+            }
         }
         else if (ch < 0x800)  /* Double byte */
         {
@@ -723,9 +772,16 @@ ucnv_UTF8FromUTF8(UConverterFromUnicodeArgs *pFromUArgs,
     while(count>0) {
         b=*source++;
         if(U8_IS_SINGLE(b)) {
-            /* convert ASCII */
+            /* convert ASCII, and copy a following run of ASCII bytes in bulk */
             *target++=b;
             --count;
+            if(count>=16) {
+                int32_t n=uprv_skipASCII(source, count);
+                uprv_memcpy(target, source, n);
+                source+=n;
+                target+=n;
+                count-=n;
+            }
             continue;
         } else {
             if(b>=0xe0) {
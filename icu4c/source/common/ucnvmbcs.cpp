@@ -59,6 +59,7 @@
 #include "cmemory.h"
 #include "cstring.h"
 #include "umutex.h"
+#include "usimd.h"
 #include "ustr_imp.h"
 
 /* control optimizations according to the platform */
@@ -431,6 +432,11 @@ ucnv_DBCSFromUTF8(UConverterFromUnicodeArgs *pFromUArgs,
                   UConverterToUnicodeArgs *pToUArgs,
                   UErrorCode *pErrorCode);
 
+static void U_CALLCONV
+ucnv_MBCSToUTF8(UConverterFromUnicodeArgs *pFromUArgs,
+                UConverterToUnicodeArgs *pToUArgs,
+                UErrorCode *pErrorCode);
+
 static const UConverterImpl _SBCSUTF8Impl={
     UCNV_MBCS,
 
@@ -453,7 +459,7 @@ static const UConverterImpl _SBCSUTF8Impl={
     NULL,
     ucnv_MBCSGetUnicodeSet,
 
-    NULL,
+    ucnv_MBCSToUTF8,
     ucnv_SBCSFromUTF8
 };
 
@@ -479,7 +485,7 @@ static const UConverterImpl _DBCSUTF8Impl={
     NULL,
     ucnv_MBCSGetUnicodeSet,
 
-    NULL,
+    ucnv_MBCSToUTF8,
     ucnv_DBCSFromUTF8
 };
 
@@ -504,7 +510,8 @@ static const UConverterImpl _MBCSImpl={
     ucnv_MBCSWriteSub,
     NULL,
     ucnv_MBCSGetUnicodeSet,
-    NULL,
+
+    ucnv_MBCSToUTF8,
     NULL
 };
 
@@ -2000,6 +2007,28 @@ U_CDECL_END
 
 /* MBCS-to-Unicode conversion functions ------------------------------------- */
 
+/*
+ * Converts a run of ASCII bytes in bulk.
+ * Only for tables where all of ASCII round-trips (IS_ALL_ASCII_ROUNDTRIP),
+ * and only in state 0.
+ * Advances *pSource and *pTarget and returns the number of bytes converted.
+ */
+static inline int32_t
+copyASCIIToUnicode(const uint8_t **pSource, const uint8_t *sourceLimit,
+                   UChar **pTarget, const UChar *targetLimit) {
+    int32_t length=(int32_t)(sourceLimit-*pSource);
+    if(length>(targetLimit-*pTarget)) {
+        length=(int32_t)(targetLimit-*pTarget);
+    }
+    if(length<16) {
+        return 0;
+    }
+    length=uprv_copyASCIIToUTF16(*pSource, *pTarget, length);
+    *pSource+=length;
+    *pTarget+=length;
+    return length;
+}
+
 static UChar32 U_CALLCONV
 ucnv_MBCSGetFallback(UConverterMBCSTable *mbcsTable, uint32_t offset) {
     const _MBCSToUFallback *toUFallbacks;
@@ -2196,6 +2225,7 @@ ucnv_MBCSSingleToBMPWithOffsets(UConverterToUnicodeArgs *pArgs,
 
     int32_t entry;
     uint8_t action;
+    UBool isAllASCII;
 
     /* set up the local pointers */
     cnv=pArgs->converter;
@@ -2210,6 +2240,7 @@ ucnv_MBCSSingleToBMPWithOffsets(UConverterToUnicodeArgs *pArgs,
     } else {
         stateTable=cnv->sharedData->mbcs.stateTable;
     }
+    isAllASCII=IS_ALL_ASCII_ROUNDTRIP(cnv->sharedData->mbcs.asciiRoundtrips);
 
     /* sourceIndex=-1 if the current character began in the previous buffer */
     sourceIndex=0;
@@ -2233,6 +2264,12 @@ ucnv_MBCSSingleToBMPWithOffsets(UConverterToUnicodeArgs *pArgs,
 
         loops=count=targetCapacity>>4;
         do {
+            /* copy a block of 16 ASCII bytes without table lookups */
+            if(isAllASCII && uprv_copyASCIIToUTF16(source, target, 16)==16) {
+                source+=16;
+                target+=16;
+                continue;
+            }
             oredEntries=entry=stateTable[0][*source++];
             *target++=(UChar)MBCS_ENTRY_FINAL_VALUE_16(entry);
             oredEntries|=entry=stateTable[0][*source++];
@@ -2483,6 +2520,7 @@ ucnv_MBCSToUnicodeWithOffsets(UConverterToUnicodeArgs *pArgs,
     int32_t entry;
     UChar c;
     uint8_t action;
+    UBool isAllASCII;
 
     /* use optimized function if possible */
     cnv=pArgs->converter;
@@ -2521,6 +2559,7 @@ ucnv_MBCSToUnicodeWithOffsets(UConverterToUnicodeArgs *pArgs,
         stateTable=cnv->sharedData->mbcs.stateTable;
     }
     unicodeCodeUnits=cnv->sharedData->mbcs.unicodeCodeUnits;
+    isAllASCII=IS_ALL_ASCII_ROUNDTRIP(cnv->sharedData->mbcs.asciiRoundtrips);
 
     /* get the converter state from UConverter */
     offset=cnv->toUnicodeStatus;
@@ -2587,6 +2626,10 @@ ucnv_MBCSToUnicodeWithOffsets(UConverterToUnicodeArgs *pArgs,
                             ++source;
                             *target++=(UChar)MBCS_ENTRY_FINAL_VALUE_16(entry);
                             state=(uint8_t)MBCS_ENTRY_FINAL_STATE(entry); /* typically 0 */
+                            if(isAllASCII && state==0 && *(source-1)<=0x7f) {
+                                /* continue with a run of ASCII bytes */
+                                copyASCIIToUnicode(&source, sourceLimit, &target, targetLimit);
+                            }
                         } else {
                             /* leave the optimized loop */
                             break;
@@ -2631,6 +2674,15 @@ ucnv_MBCSToUnicodeWithOffsets(UConverterToUnicodeArgs *pArgs,
                                 sourceIndex=++nextSourceIndex;
                             }
                             state=(uint8_t)MBCS_ENTRY_FINAL_STATE(entry); /* typically 0 */
+                            if(isAllASCII && state==0 && *(source-1)<=0x7f) {
+                                /* continue with a run of ASCII bytes */
+                                int32_t count=copyASCIIToUnicode(&source, sourceLimit, &target, targetLimit);
+                                while(count>0) {
+                                    *offsets++=sourceIndex;
+                                    sourceIndex=++nextSourceIndex;
+                                    --count;
+                                }
+                            }
                         } else {
                             /* leave the optimized loop */
                             break;
@@ -3401,6 +3453,27 @@ ucnv_MBCSSimpleGetNextUChar(UConverterSharedData *sharedData,
 
 /* MBCS-from-Unicode conversion functions ----------------------------------- */
 
+/*
+ * Converts a run of ASCII characters in bulk.
+ * Only for tables where all of ASCII round-trips (IS_ALL_ASCII_ROUNDTRIP).
+ * Advances *pSource and *pTarget and returns the number of characters converted.
+ */
+static inline int32_t
+copyASCIIFromUnicode(const UChar **pSource, const UChar *sourceLimit,
+                     uint8_t **pTarget, int32_t targetCapacity) {
+    int32_t length=(int32_t)(sourceLimit-*pSource);
+    if(length>targetCapacity) {
+        length=targetCapacity;
+    }
+    if(length<16) {
+        return 0;
+    }
+    length=uprv_copyASCIIToUTF8(*pSource, *pTarget, length);
+    *pSource+=length;
+    *pTarget+=length;
+    return length;
+}
+
 /* This version of ucnv_MBCSFromUnicodeWithOffsets() is optimized for double-byte codepages. */
 static void
 ucnv_MBCSDoubleFromUnicodeWithOffsets(UConverterFromUnicodeArgs *pArgs,
@@ -3481,6 +3554,20 @@ ucnv_MBCSDoubleFromUnicodeWithOffsets(UConverterFromUnicodeArgs *pArgs,
                 }
                 --targetCapacity;
                 c=0;
+                if(IS_ALL_ASCII_ROUNDTRIP(asciiRoundtrips)) {
+                    /* continue with a run of ASCII characters */
+                    int32_t count=copyASCIIFromUnicode(&source, sourceLimit, &target, targetCapacity);
+                    targetCapacity-=count;
+                    if(offsets!=NULL) {
+                        while(count>0) {
+                            *offsets++=nextSourceIndex++;
+                            --count;
+                        }
+                        sourceIndex=nextSourceIndex;
+                    } else {
+                        nextSourceIndex+=count;
+                    }
+                }
                 continue;
             }
             /*
@@ -3940,6 +4027,10 @@ ucnv_MBCSSingleFromBMPWithOffsets(UConverterFromUnicodeArgs *pArgs,
             *target++=(uint8_t)c;
             --targetCapacity;
             c=0;
+            if(IS_ALL_ASCII_ROUNDTRIP(asciiRoundtrips)) {
+                /* continue with a run of ASCII characters; offsets are set after the loop */
+                targetCapacity-=copyASCIIFromUnicode(&source, sourceLimit, &target, targetCapacity);
+            }
             continue;
         }
         value=MBCS_SINGLE_RESULT_FROM_U(table, results, c);
@@ -4211,6 +4302,21 @@ ucnv_MBCSFromUnicodeWithOffsets(UConverterFromUnicodeArgs *pArgs,
                 }
                 --targetCapacity;
                 c=0;
+                if(IS_ALL_ASCII_ROUNDTRIP(asciiRoundtrips)) {
+                    /* continue with a run of ASCII characters */
+                    int32_t count=copyASCIIFromUnicode(&source, sourceLimit, &target, targetCapacity);
+                    targetCapacity-=count;
+                    if(offsets!=NULL) {
+                        while(count>0) {
+                            prevSourceIndex=nextSourceIndex;
+                            *offsets++=nextSourceIndex++;
+                            --count;
+                        }
+                        sourceIndex=nextSourceIndex;
+                    } else {
+                        nextSourceIndex+=count;
+                    }
+                }
                 continue;
             }
             /*
@@ -5010,6 +5116,174 @@ ucnv_MBCSSingleFromUChar32(UConverterSharedData *sharedData,
 }
 #endif
 
+/* MBCS-to-UTF-8 conversion functions --------------------------------------- */
+
+/*
+ * Convert directly from a codepage to UTF-8, without pivoting through UTF-16.
+ *
+ * This handles the common cases: round-trip and fallback mappings in the
+ * main table, and the GB 18030 four-byte ranges.
+ * Anything else (unassigned and illegal sequences, extension mappings,
+ * fallbacks via the toUFallbacks table, state changes without output,
+ * partial sequences at the end of the input, and output that does not fit
+ * into the target) is left to the standard converters:
+ * We stop before that character and set U_USING_DEFAULT_WARNING,
+ * and ucnv_convertEx() pivots for a short while and then calls us again.
+ */
+static void U_CALLCONV
+ucnv_MBCSToUTF8(UConverterFromUnicodeArgs *pFromUArgs,
+                UConverterToUnicodeArgs *pToUArgs,
+                UErrorCode *pErrorCode) {
+    UConverter *cnv;
+    const uint8_t *source, *sourceLimit, *start;
+    uint8_t *target;
+    int32_t targetCapacity, length;
+
+    const int32_t (*stateTable)[256];
+    const uint16_t *unicodeCodeUnits;
+
+    uint32_t offset;
+    uint8_t state, nextState;
+    int32_t entry;
+    uint8_t action;
+    UChar32 c;
+    UBool isAllASCII, isGB18030;
+
+    cnv=pToUArgs->converter;
+    if(cnv->toULength>0 || pFromUArgs->converter->fromUChar32!=0) {
+        /* let the standard converters finish a partial character */
+        *pErrorCode=U_USING_DEFAULT_WARNING;
+        return;
+    }
+
+    /* set up the local pointers */
+    source=(const uint8_t *)pToUArgs->source;
+    sourceLimit=(const uint8_t *)pToUArgs->sourceLimit;
+    target=(uint8_t *)pFromUArgs->target;
+    targetCapacity=(int32_t)(pFromUArgs->targetLimit-pFromUArgs->target);
+
+    if((cnv->options&UCNV_OPTION_SWAP_LFNL)!=0) {
+        stateTable=(const int32_t (*)[256])cnv->sharedData->mbcs.swapLFNLStateTable;
+    } else {
+        stateTable=cnv->sharedData->mbcs.stateTable;
+    }
+    unicodeCodeUnits=cnv->sharedData->mbcs.unicodeCodeUnits;
+    isAllASCII=IS_ALL_ASCII_ROUNDTRIP(cnv->sharedData->mbcs.asciiRoundtrips);
+    /* extension mappings take precedence over the GB 18030 ranges, see _extToU() */
+    isGB18030=(UBool)((cnv->options&_MBCS_OPTION_GB18030)!=0 && cnv->sharedData->mbcs.extIndexes==NULL);
+
+    /* get the converter state, see ucnv_MBCSToUnicodeWithOffsets() */
+    if((state=(uint8_t)(cnv->mode))==0) {
+        state=cnv->sharedData->mbcs.dbcsOnlyState;
+    }
+
+    /* conversion loop */
+    while(source<sourceLimit) {
+        if(targetCapacity<=0) {
+            /* target is full */
+            *pErrorCode=U_BUFFER_OVERFLOW_ERROR;
+            break;
+        }
+
+        if(isAllASCII && state==0 && U8_IS_SINGLE(*source)) {
+            /* copy a run of ASCII bytes */
+            start=source;
+            length=(int32_t)(sourceLimit-source);
+            if(length>targetCapacity) {
+                length=targetCapacity;
+            }
+            source+=uprv_skipASCII(source, length);
+            while(source<start+length && U8_IS_SINGLE(*source)) {
+                ++source;
+            }
+            length=(int32_t)(source-start);
+            uprv_memcpy(target, start, length);
+            target+=length;
+            targetCapacity-=length;
+            continue;
+        }
+
+        /* read one complete byte sequence */
+        start=source;
+        nextState=state;
+        offset=0;
+        entry=stateTable[nextState][*source++];
+        while(MBCS_ENTRY_IS_TRANSITION(entry) && source<sourceLimit) {
+            nextState=(uint8_t)MBCS_ENTRY_TRANSITION_STATE(entry);
+            offset+=MBCS_ENTRY_TRANSITION_OFFSET(entry);
+            entry=stateTable[nextState][*source++];
+        }
+
+        c=U_SENTINEL;
+        if(MBCS_ENTRY_IS_FINAL(entry)) {
+            action=(uint8_t)(MBCS_ENTRY_FINAL_ACTION(entry));
+            if( action==MBCS_STATE_VALID_DIRECT_16 ||
+                (action==MBCS_STATE_FALLBACK_DIRECT_16 && UCNV_TO_U_USE_FALLBACK(cnv))
+            ) {
+                c=MBCS_ENTRY_FINAL_VALUE_16(entry);
+            } else if(action==MBCS_STATE_VALID_16) {
+                c=unicodeCodeUnits[offset+MBCS_ENTRY_FINAL_VALUE_16(entry)];
+                if(c>=0xfffe) {
+                    /* unassigned, fallback or illegal */
+                    c=U_SENTINEL;
+                }
+            } else if(action==MBCS_STATE_VALID_16_PAIR) {
+                offset+=MBCS_ENTRY_FINAL_VALUE_16(entry);
+                c=unicodeCodeUnits[offset++];
+                if(c<0xd800) {
+                    /* BMP code point below 0xd800 */
+                } else if(UCNV_TO_U_USE_FALLBACK(cnv) ? c<=0xdfff : c<=0xdbff) {
+                    /* roundtrip or fallback surrogate pair */
+                    c=U16_GET_SUPPLEMENTARY(c&0xdbff, unicodeCodeUnits[offset]);
+                } else if(UCNV_TO_U_USE_FALLBACK(cnv) ? (c&0xfffe)==0xe000 : c==0xe000) {
+                    /* roundtrip BMP code point above 0xd800 or fallback BMP code point */
+                    c=unicodeCodeUnits[offset];
+                } else {
+                    c=U_SENTINEL;
+                }
+            } else if( action==MBCS_STATE_VALID_DIRECT_20 ||
+                       (action==MBCS_STATE_FALLBACK_DIRECT_20 && UCNV_TO_U_USE_FALLBACK(cnv))
+            ) {
+                c=(UChar32)MBCS_ENTRY_FINAL_VALUE(entry)+0x10000;
+            } else if(action==MBCS_STATE_UNASSIGNED && isGB18030 && (source-start)==4) {
+                const uint32_t *range;
+                uint32_t linear;
+                int32_t i;
+
+                linear=LINEAR_18030(start[0], start[1], start[2], start[3]);
+                range=gb18030Ranges[0];
+                for(i=0; i<UPRV_LENGTHOF(gb18030Ranges); range+=4, ++i) {
+                    if(range[2]<=linear && linear<=range[3]) {
+                        c=(UChar32)(range[0]+(linear-range[2]));
+                        break;
+                    }
+                }
+            }
+        }
+
+        if(c<0 || U_IS_SURROGATE(c) || (length=U8_LENGTH(c))>targetCapacity) {
+            /* back out and let the standard converters handle this character */
+            source=start;
+            *pErrorCode=U_USING_DEFAULT_WARNING;
+            break;
+        }
+
+        /* write the UTF-8 bytes */
+        length=0;
+        U8_APPEND_UNSAFE(target, length, c);
+        target+=length;
+        targetCapacity-=length;
+        state=(uint8_t)MBCS_ENTRY_FINAL_STATE(entry); /* typically 0 */
+    }
+
+    /* set the converter state back into UConverter */
+    cnv->mode=state;
+
+    /* write back the updated pointers */
+    pToUArgs->source=(const char *)source;
+    pFromUArgs->target=(char *)target;
+}
+
 /* MBCS-from-UTF-8 conversion functions ------------------------------------- */
 
 /* offsets for n-byte UTF-8 sequences that were calculated with ((lead<<6)+trail)<<6+trail... */
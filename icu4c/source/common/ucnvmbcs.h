@@ -295,6 +295,9 @@ enum {
 
 #define IS_ASCII_ROUNDTRIP(b, asciiRoundtrips) (((asciiRoundtrips) & (1<<((b)>>2)))!=0)
 
+/* all ASCII bytes and characters round-trip, so that runs of them can be copied in bulk */
+#define IS_ALL_ASCII_ROUNDTRIP(asciiRoundtrips) ((asciiRoundtrips)==0xffffffff)
+
 /* single-byte fromUnicode: get the 16-bit result word */
 #define MBCS_SINGLE_RESULT_FROM_U(table, results, c) (results)[ (table)[ (table)[(c)>>10] +(((c)>>4)&0x3f) ] +((c)&0xf) ]
 
@@ -37,6 +37,7 @@
 #include "unicode/ucnv.h"
 #include "unicode/ustring.h"
 #include "unicode/uchriter.h"
+#include "unicode/icudataver.h"
 #include "utrie2.h"
 #include "propsvec.h"
 #include "uassert.h"
@@ -45,6 +46,7 @@
 #include "uenumimp.h"
 #include "cmemory.h"
 #include "cstring.h"
+#include "usimd.h"
 
 U_NAMESPACE_USE
 
@@ -57,8 +59,40 @@ struct UConverterSelector {
   int32_t encodingStrLength;
   uint8_t* swapped;
   UBool ownPv, ownEncodingStrings;
+  // Cache key for ucnvsel_openWithCache(), other than the encoding names.
+  // whichSet is -1 if unknown, for data serialized before formatVersion 1.1.
+  int32_t whichSet;
+  int32_t excludedHash;
+  // Start/end pairs of the excluded code point ranges.
+  int32_t* excludedRanges;
+  int32_t excludedRangesLength;
+  UBool ownExcludedRanges;
+  UVersionInfo dataVersion;
 };
 
+namespace {
+
+// One converter's Unicode set, walked in code point order while building
+// the property vectors. The set membership flips at each boundary:
+// at each range start and after each range end.
+struct SetCursor : public UMemory {
+  UnicodeSet set;
+  int32_t boundaryCount;
+  int32_t boundaryIndex;
+  UChar32 next;  // next boundary, or 0x110000 after the last one
+
+  void advance() {
+    if (++boundaryIndex < boundaryCount) {
+      int32_t range = boundaryIndex >> 1;
+      next = (boundaryIndex & 1) == 0 ? set.getRangeStart(range) : set.getRangeEnd(range) + 1;
+    } else {
+      next = 0x110000;
+    }
+  }
+};
+
+}  // namespace
+
 static void generateSelectorData(UConverterSelector* result,
                                  UPropsVectors *upvec,
                                  const USet* excludedCodePoints,
@@ -76,49 +110,58 @@ static void generateSelectorData(UConverterSelector* result,
                    col, static_cast<uint32_t>(~0), static_cast<uint32_t>(~0), status);
   }
 
+  LocalArray<SetCursor> cursors(new SetCursor[result->encodingsCount]);
+  MaybeStackArray<uint32_t, 8> row;
+  if (cursors.isNull() || row.resize(columns) == NULL) {
+    *status = U_MEMORY_ALLOCATION_ERROR;
+    return;
+  }
   for (int32_t i = 0; i < result->encodingsCount; ++i) {
-    uint32_t mask;
-    uint32_t column;
-    int32_t item_count;
-    int32_t j;
+    SetCursor &cursor = cursors[i];
     UConverter* test_converter = ucnv_open(result->encodings[i], status);
     if (U_FAILURE(*status)) {
       return;
     }
-    USet* unicode_point_set;
-    unicode_point_set = uset_open(1, 0);  // empty set
-
-    ucnv_getUnicodeSet(test_converter, unicode_point_set,
+    // Strings in the set are ignored: Only its ranges are walked.
+    ucnv_getUnicodeSet(test_converter, cursor.set.toUSet(),
                        whichSet, status);
+    ucnv_close(test_converter);
     if (U_FAILURE(*status)) {
-      ucnv_close(test_converter);
       return;
     }
+    cursor.boundaryCount = 2 * cursor.set.getRangeCount();
+    cursor.boundaryIndex = -1;
+    cursor.advance();
+  }
 
-    column = i / 32;
-    mask = 1 << (i%32);
-    // now iterate over intervals on set i!
-    item_count = uset_getItemCount(unicode_point_set);
-
-    for (j = 0; j < item_count; ++j) {
-      UChar32 start_char;
-      UChar32 end_char;
-      UErrorCode smallStatus = U_ZERO_ERROR;
-      uset_getItem(unicode_point_set, j, &start_char, &end_char, NULL, 0,
-                   &smallStatus);
-      if (U_FAILURE(smallStatus)) {
-        // this will be reached for the converters that fill the set with
-        // strings. Those should be ignored by our system
-      } else {
-        upvec_setValue(upvec, start_char, end_char, column, static_cast<uint32_t>(~0), mask,
+  // Setting each converter's ranges one by one would insert rows
+  // in the middle of the growing vectors table, moving all of the rows behind them.
+  // Instead, sweep over all of the sets at once, and set each row's
+  // bits for all of the converters in code point order, appending rows at the end.
+  uprv_memset(row.getAlias(), 0, columns * 4);
+  UChar32 start = 0;
+  while (start < 0x110000) {
+    UChar32 limit = 0x110000;
+    for (int32_t i = 0; i < result->encodingsCount; ++i) {
+      SetCursor &cursor = cursors[i];
+      if (cursor.next == start) {
+        row[i / 32] ^= (uint32_t)1 << (i % 32);
+        cursor.advance();
+      }
+      if (cursor.next < limit) {
+        limit = cursor.next;
+      }
+    }
+    for (int32_t col = 0; col < columns; col++) {
+      if (row[col] != 0) {
+        upvec_setValue(upvec, start, limit - 1, col, row[col], static_cast<uint32_t>(~0),
                        status);
       }
     }
-    ucnv_close(test_converter);
-    uset_close(unicode_point_set);
     if (U_FAILURE(*status)) {
       return;
     }
+    start = limit;
   }
 
   // handle excluded encodings! Simply set their values to all 1's in the upvec
@@ -145,6 +188,48 @@ static void generateSelectorData(UConverterSelector* result,
   result->ownPv = TRUE;
 }
 
+// Returns NULL if no code points are excluded.
+static const UnicodeSet* getExcludedSet(const USet* excludedCodePoints) {
+  if (excludedCodePoints == NULL || uset_isEmpty(excludedCodePoints)) {
+    return NULL;
+  }
+  return UnicodeSet::fromUSet(excludedCodePoints);
+}
+
+static int32_t hashExcludedCodePoints(const USet* excludedCodePoints) {
+  const UnicodeSet* excluded = getExcludedSet(excludedCodePoints);
+  return excluded != NULL ? excluded->hashCode() : 0;
+}
+
+static void setCacheKey(UConverterSelector* sel,
+                        const USet* excludedCodePoints,
+                        const UConverterUnicodeSet whichSet,
+                        UErrorCode* status) {
+  if (U_FAILURE(*status)) {
+    return;
+  }
+  sel->whichSet = whichSet;
+  sel->excludedHash = hashExcludedCodePoints(excludedCodePoints);
+  const UnicodeSet* excluded = getExcludedSet(excludedCodePoints);
+  if (excluded != NULL) {
+    int32_t rangeCount = excluded->getRangeCount();
+    sel->excludedRanges = (int32_t*)uprv_malloc(rangeCount * 2 * 4);
+    if (sel->excludedRanges == NULL) {
+      *status = U_MEMORY_ALLOCATION_ERROR;
+      return;
+    }
+    sel->ownExcludedRanges = TRUE;
+    for (int32_t i = 0; i < rangeCount; ++i) {
+      sel->excludedRanges[2 * i] = excluded->getRangeStart(i);
+      sel->excludedRanges[2 * i + 1] = excluded->getRangeEnd(i);
+    }
+    sel->excludedRangesLength = rangeCount * 2;
+  }
+  // Without version data, the selector matches only other ones also built without it.
+  UErrorCode localStatus = U_ZERO_ERROR;
+  u_getDataVersion(sel->dataVersion, &localStatus);
+}
+
 /* open a selector. If converterListSize is 0, build for all converters.
    If excludedCodePoints is NULL, don't exclude any codepoints */
 U_CAPI UConverterSelector* U_EXPORT2
@@ -214,6 +299,7 @@ ucnvsel_open(const char* const*  converterList, int32_t converterListSize,
 
   newSelector->ownEncodingStrings = TRUE;
   newSelector->encodingsCount = converterListSize;
+  setCacheKey(newSelector.getAlias(), excludedCodePoints, whichSet, status);
   UPropsVectors *upvec = upvec_open((converterListSize+31)/32, status);
   generateSelectorData(newSelector.getAlias(), upvec, excludedCodePoints, whichSet, status);
   upvec_close(upvec);
@@ -238,6 +324,9 @@ ucnvsel_close(UConverterSelector *sel) {
   if (sel->ownPv) {
     uprv_free(sel->pv);
   }
+  if (sel->ownExcludedRanges) {
+    uprv_free(sel->excludedRanges);
+  }
   utrie2_close(sel->trie);
   uprv_free(sel->swapped);
   uprv_free(sel);
@@ -253,7 +342,7 @@ static const UDataInfo dataInfo = {
   0,
 
   { 0x43, 0x53, 0x65, 0x6c },   /* dataFormat="CSel" */
-  { 1, 0, 0, 0 },               /* formatVersion */
+  { 1, 1, 0, 0 },               /* formatVersion */
   { 0, 0, 0, 0 }                /* dataVersion */
 };
 
@@ -262,6 +351,9 @@ enum {
   UCNVSEL_INDEX_PV_COUNT,       // number of uint32_t in the bit vectors
   UCNVSEL_INDEX_NAMES_COUNT,    // number of encoding names
   UCNVSEL_INDEX_NAMES_LENGTH,   // number of encoding name bytes including padding
+  UCNVSEL_INDEX_WHICH_SET,      // (formatVersion 1.1) UConverterUnicodeSet + 1, or 0 if unknown
+  UCNVSEL_INDEX_EXCLUDED_HASH,  // (formatVersion 1.1) hash of the excluded code points
+  UCNVSEL_INDEX_EXCLUDED_RANGES_LENGTH,  // (formatVersion 1.1) number of int32_t range limits
   UCNVSEL_INDEX_SIZE = 15,      // bytes following the DataHeader
   UCNVSEL_INDEX_COUNT = 16
 };
@@ -271,13 +363,52 @@ enum {
  *
  * The serialized form begins with a standard ICU DataHeader with a UDataInfo
  * as the template above.
+ * Since formatVersion 1.1, its dataVersion is the u_getDataVersion()
+ * of the converter data the selector was built from.
  * This is followed by:
  *   int32_t indexes[UCNVSEL_INDEX_COUNT];          // see index entry constants above
  *   serialized UTrie2;                             // indexes[UCNVSEL_INDEX_TRIE_SIZE] bytes
  *   uint32_t pv[indexes[UCNVSEL_INDEX_PV_COUNT]];  // bit vectors
  *   char* encodingNames[indexes[UCNVSEL_INDEX_NAMES_LENGTH]];  // NUL-terminated strings + padding
+ *   // (formatVersion 1.1) start/end pairs of the excluded code point ranges
+ *   int32_t excludedRanges[indexes[UCNVSEL_INDEX_EXCLUDED_RANGES_LENGTH]];
  */
 
+/*
+ * Returns TRUE if the section lengths in the indexes are not negative
+ * and the sections fit into the indexes[UCNVSEL_INDEX_SIZE] bytes after the header.
+ * Serialized data may come from a cache file, and must not be trusted.
+ */
+static UBool
+sectionsFit(const int32_t indexes[], const UVersionInfo formatVersion) {
+  int32_t rangesLength =
+    formatVersion[1] >= 1 ? indexes[UCNVSEL_INDEX_EXCLUDED_RANGES_LENGTH] : 0;
+  const int32_t lengths[] = {
+    indexes[UCNVSEL_INDEX_TRIE_SIZE],
+    indexes[UCNVSEL_INDEX_PV_COUNT],
+    indexes[UCNVSEL_INDEX_NAMES_LENGTH],
+    rangesLength
+  };
+  static const int32_t unitSizes[] = { 1, 4, 1, 4 };
+  int32_t remaining = indexes[UCNVSEL_INDEX_SIZE] - UCNVSEL_INDEX_COUNT * 4;
+  if (remaining < 0) {
+    return FALSE;
+  }
+  for (int32_t i = 0; i < UPRV_LENGTHOF(lengths); ++i) {
+    if (lengths[i] < 0 || lengths[i] > remaining / unitSizes[i]) {
+      return FALSE;
+    }
+    remaining -= lengths[i] * unitSizes[i];
+  }
+  // The uint32_t pv[] and excludedRanges[] must be 4-aligned.
+  // Each name has at least one character plus its NUL terminator.
+  return (indexes[UCNVSEL_INDEX_TRIE_SIZE] & 3) == 0 &&
+    (indexes[UCNVSEL_INDEX_NAMES_LENGTH] & 3) == 0 &&
+    indexes[UCNVSEL_INDEX_NAMES_COUNT] >= 0 &&
+    indexes[UCNVSEL_INDEX_NAMES_COUNT] <= indexes[UCNVSEL_INDEX_NAMES_LENGTH] / 2 &&
+    (rangesLength & 1) == 0;
+}
+
 /* serialize a selector */
 U_CAPI int32_t U_EXPORT2
 ucnvsel_serialize(const UConverterSelector* sel,
@@ -307,12 +438,16 @@ ucnvsel_serialize(const UConverterSelector* sel,
   header.dataHeader.magic1 = 0xda;
   header.dataHeader.magic2 = 0x27;
   uprv_memcpy(&header.info, &dataInfo, sizeof(dataInfo));
+  uprv_memcpy(header.info.dataVersion, sel->dataVersion, sizeof(UVersionInfo));
 
   int32_t indexes[UCNVSEL_INDEX_COUNT] = {
     serializedTrieSize,
     sel->pvCount,
     sel->encodingsCount,
-    sel->encodingStrLength
+    sel->encodingStrLength,
+    sel->whichSet + 1,
+    sel->excludedHash,
+    sel->excludedRangesLength
   };
 
   int32_t totalSize =
@@ -320,7 +455,8 @@ ucnvsel_serialize(const UConverterSelector* sel,
     (int32_t)sizeof(indexes) +
     serializedTrieSize +
     sel->pvCount * 4 +
-    sel->encodingStrLength;
+    sel->encodingStrLength +
+    indexes[UCNVSEL_INDEX_EXCLUDED_RANGES_LENGTH] * 4;
   indexes[UCNVSEL_INDEX_SIZE] = totalSize - header.dataHeader.headerSize;
   if (totalSize > bufferCapacity) {
     *status = U_BUFFER_OVERFLOW_ERROR;
@@ -346,6 +482,12 @@ ucnvsel_serialize(const UConverterSelector* sel,
   uprv_memcpy(p, sel->encodings[0], sel->encodingStrLength);
   p += sel->encodingStrLength;
 
+  length = sel->excludedRangesLength * 4;
+  if (length > 0) {
+    uprv_memcpy(p, sel->excludedRanges, length);
+    p += length;
+  }
+
   return totalSize;
 }
 
@@ -418,6 +560,12 @@ ucnvsel_swap(const UDataSwapper *ds,
     indexes[i] = udata_readInt32(ds, inIndexes[i]);
   }
 
+  if(!sectionsFit(indexes, pInfo->formatVersion)) {
+    udata_printError(ds, "ucnvsel_swap(): the UConverterSelector data sections do not fit\n");
+    *status = U_INVALID_FORMAT_ERROR;
+    return 0;
+  }
+
   /* get the total length of the data */
   int32_t size = indexes[UCNVSEL_INDEX_SIZE];
   if(length >= 0) {
@@ -455,12 +603,51 @@ ucnvsel_swap(const UDataSwapper *ds,
     ds->swapInvChars(ds, inBytes + offset, count, outBytes + offset, status);
     offset += count;
 
+    /* swap the int32_t excludedRanges[] (formatVersion 1.1) */
+    if(pInfo->formatVersion[1] >= 1) {
+      count = indexes[UCNVSEL_INDEX_EXCLUDED_RANGES_LENGTH]*4;
+      ds->swapArray32(ds, inBytes + offset, count, outBytes + offset, status);
+      offset += count;
+    }
+
     U_ASSERT(offset == size);
   }
 
   return headerSize + size;
 }
 
+namespace {
+
+struct PvIndexCheck {
+  int32_t maxIndex;
+  UBool inRange;
+};
+
+}  // namespace
+
+static UBool U_CALLCONV
+checkPvIndex(const void *context, UChar32 /*start*/, UChar32 /*end*/, uint32_t value) {
+  PvIndexCheck* check = (PvIndexCheck*)context;
+  if ((int32_t)value > check->maxIndex) {
+    check->inRange = FALSE;
+  }
+  return check->inRange;
+}
+
+/*
+ * Returns TRUE if each trie value, including the one for ill-formed UTF-8,
+ * is the start of a whole row of bit vectors.
+ */
+static UBool
+pvIndexesFit(const UConverterSelector* sel) {
+  PvIndexCheck check = { sel->pvCount - (sel->encodingsCount + 31) / 32, TRUE };
+  checkPvIndex(&check, 0, 0, sel->trie->errorValue);
+  if (check.inRange) {
+    utrie2_enum(sel->trie, NULL, checkPvIndex, &check);
+  }
+  return check.inRange;
+}
+
 /* unserialize a selector */
 U_CAPI UConverterSelector* U_EXPORT2
 ucnvsel_openFromSerialized(const void* buffer, int32_t length, UErrorCode* status) {
@@ -546,6 +733,11 @@ ucnvsel_openFromSerialized(const void* buffer, int32_t length, UErrorCode* statu
     *status = U_INDEX_OUTOFBOUNDS_ERROR;
     return NULL;
   }
+  if (!sectionsFit(indexes, pHeader->info.formatVersion)) {
+    uprv_free(swapped);
+    *status = U_INVALID_FORMAT_ERROR;
+    return NULL;
+  }
   p += UCNVSEL_INDEX_COUNT * 4;
   // create and populate the selector object
   UConverterSelector* sel = (UConverterSelector*)uprv_malloc(sizeof(UConverterSelector));
@@ -565,6 +757,14 @@ ucnvsel_openFromSerialized(const void* buffer, int32_t length, UErrorCode* statu
   sel->encodingsCount = indexes[UCNVSEL_INDEX_NAMES_COUNT];
   sel->encodingStrLength = indexes[UCNVSEL_INDEX_NAMES_LENGTH];
   sel->swapped = swapped;
+  if (pHeader->info.formatVersion[1] >= 1) {
+    sel->whichSet = indexes[UCNVSEL_INDEX_WHICH_SET] - 1;
+    sel->excludedHash = indexes[UCNVSEL_INDEX_EXCLUDED_HASH];
+    uprv_memcpy(sel->dataVersion, pHeader->info.dataVersion, sizeof(UVersionInfo));
+  } else {
+    sel->whichSet = -1;
+  }
+
   // trie
   sel->trie = utrie2_openFromSerialized(UTRIE2_16_VALUE_BITS,
                                         p, indexes[UCNVSEL_INDEX_TRIE_SIZE], NULL,
@@ -577,17 +777,117 @@ ucnvsel_openFromSerialized(const void* buffer, int32_t length, UErrorCode* statu
   // bit vectors
   sel->pv = (uint32_t *)p;
   p += sel->pvCount * 4;
+  if (!pvIndexesFit(sel)) {
+    ucnvsel_close(sel);
+    *status = U_INVALID_FORMAT_ERROR;
+    return NULL;
+  }
   // encoding names
   char* s = (char*)p;
+  const char* namesLimit = s + sel->encodingStrLength;
   for (int32_t i = 0; i < sel->encodingsCount; ++i) {
     sel->encodings[i] = s;
-    s += uprv_strlen(s) + 1;
+    while (s < namesLimit && *s != 0) {
+      ++s;
+    }
+    if (s == namesLimit || s == sel->encodings[i]) {
+      // not NUL-terminated, or empty
+      ucnvsel_close(sel);
+      *status = U_INVALID_FORMAT_ERROR;
+      return NULL;
+    }
+    ++s;
   }
   p += sel->encodingStrLength;
+  // excluded code point ranges
+  if (pHeader->info.formatVersion[1] >= 1) {
+    sel->excludedRanges = (int32_t*)p;
+    sel->excludedRangesLength = indexes[UCNVSEL_INDEX_EXCLUDED_RANGES_LENGTH];
+  }
 
   return sel;
 }
 
+static UBool matchesCacheKey(const UConverterSelector* sel,
+                             const char* const* converterList, int32_t converterListSize,
+                             const USet* excludedCodePoints,
+                             const UConverterUnicodeSet whichSet) {
+  // The hash is only a quick check: Compare the excluded ranges themselves.
+  int32_t excludedHash = hashExcludedCodePoints(excludedCodePoints);
+  if (sel->whichSet != whichSet || sel->excludedHash != excludedHash) {
+    return FALSE;
+  }
+  const UnicodeSet* excluded = getExcludedSet(excludedCodePoints);
+  int32_t rangeCount = excluded != NULL ? excluded->getRangeCount() : 0;
+  if (sel->excludedRangesLength != rangeCount * 2) {
+    return FALSE;
+  }
+  for (int32_t i = 0; i < rangeCount; ++i) {
+    if (sel->excludedRanges[2 * i] != excluded->getRangeStart(i) ||
+        sel->excludedRanges[2 * i + 1] != excluded->getRangeEnd(i)) {
+      return FALSE;
+    }
+  }
+  UVersionInfo dataVersion = { 0, 0, 0, 0 };
+  UErrorCode localStatus = U_ZERO_ERROR;
+  u_getDataVersion(dataVersion, &localStatus);
+  if (uprv_memcmp(sel->dataVersion, dataVersion, sizeof(UVersionInfo)) != 0) {
+    return FALSE;
+  }
+  if (converterListSize == 0) {
+    converterList = NULL;
+    converterListSize = ucnv_countAvailable();
+  }
+  if (sel->encodingsCount != converterListSize) {
+    return FALSE;
+  }
+  for (int32_t i = 0; i < converterListSize; ++i) {
+    const char* name = converterList != NULL ? converterList[i] : ucnv_getAvailableName(i);
+    if (uprv_strcmp(sel->encodings[i], name) != 0) {
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+
+/* open a selector from cached data if that was built the same way, otherwise build it */
+U_CAPI UConverterSelector* U_EXPORT2
+ucnvsel_openWithCache(const char* const* converterList, int32_t converterListSize,
+                      const USet* excludedCodePoints,
+                      const UConverterUnicodeSet whichSet,
+                      const void* cache, int32_t cacheLength,
+                      UBool* pIsFromCache, UErrorCode* status) {
+  if (pIsFromCache != NULL) {
+    *pIsFromCache = FALSE;
+  }
+  // check if already failed
+  if (U_FAILURE(*status)) {
+    return NULL;
+  }
+  // ensure args make sense!
+  if (converterListSize < 0 || (converterList == NULL && converterListSize != 0) ||
+      cacheLength < 0 || (cache == NULL && cacheLength != 0)) {
+    *status = U_ILLEGAL_ARGUMENT_ERROR;
+    return NULL;
+  }
+  if (cacheLength > 0) {
+    // Unusable or stale cached data is not an error:
+    // The selector is rebuilt, and the caller replaces the cached data.
+    UErrorCode cacheStatus = U_ZERO_ERROR;
+    LocalUConverterSelectorPointer cached(
+      ucnvsel_openFromSerialized(cache, cacheLength, &cacheStatus));
+    if (U_SUCCESS(cacheStatus) &&
+        matchesCacheKey(cached.getAlias(), converterList, converterListSize,
+                        excludedCodePoints, whichSet)) {
+      if (pIsFromCache != NULL) {
+        *pIsFromCache = TRUE;
+      }
+      return cached.orphan();
+    }
+  }
+  return ucnvsel_open(converterList, converterListSize, excludedCodePoints, whichSet, status);
+}
+
 // a bunch of functions for the enumeration thingie! Nothing fancy here. Just
 // iterate over the selected encodings
 struct Enumerator {
@@ -666,9 +966,31 @@ static const UEnumeration defaultEncodings = {
 // internal fn to intersect two sets of masks
 // returns whether the mask has reduced to all zeros
 static UBool intersectMasks(uint32_t* dest, const uint32_t* source1, int32_t len) {
-  int32_t i;
+  int32_t i = 0;
   uint32_t oredDest = 0;
-  for (i = 0 ; i < len ; ++i) {
+#if UPRV_HAVE_SSE2
+  if (len >= 4) {
+    __m128i ored = _mm_setzero_si128();
+    for (; i + 4 <= len; i += 4) {
+      __m128i v = _mm_and_si128(_mm_loadu_si128((const __m128i *)(dest + i)),
+                                _mm_loadu_si128((const __m128i *)(source1 + i)));
+      _mm_storeu_si128((__m128i *)(dest + i), v);
+      ored = _mm_or_si128(ored, v);
+    }
+    oredDest = _mm_movemask_epi8(_mm_cmpeq_epi8(ored, _mm_setzero_si128())) != 0xffff;
+  }
+#elif UPRV_HAVE_NEON
+  if (len >= 4) {
+    uint32x4_t ored = vdupq_n_u32(0);
+    for (; i + 4 <= len; i += 4) {
+      uint32x4_t v = vandq_u32(vld1q_u32(dest + i), vld1q_u32(source1 + i));
+      vst1q_u32(dest + i, v);
+      ored = vorrq_u32(ored, v);
+    }
+    oredDest = vmaxvq_u32(ored);
+  }
+#endif
+  for (; i < len ; ++i) {
     oredDest |= (dest[i] &= source1[i]);
   }
   return oredDest == 0;
@@ -768,12 +1090,18 @@ ucnvsel_selectForString(const UConverterSelector* sel,
       limit = NULL;
     }
     
+    // Runs of characters with the same row, such as letters of one script,
+    // need to be intersected only once.
+    int32_t prevIndex = -1;
     while (limit == NULL ? *s != 0 : s != limit) {
       UChar32 c;
       uint16_t pvIndex;
       UTRIE2_U16_NEXT16(sel->trie, s, limit, c, pvIndex);
-      if (intersectMasks(mask, sel->pv+pvIndex, columns)) {
-        break;
+      if (pvIndex != prevIndex) {
+        if (intersectMasks(mask, sel->pv+pvIndex, columns)) {
+          break;
+        }
+        prevIndex = pvIndex;
       }
     }
   }
@@ -809,11 +1137,15 @@ ucnvsel_selectForUTF8(const UConverterSelector* sel,
   if(s!=NULL) {
     const char *limit = s + length;
     
+    int32_t prevIndex = -1;
     while (s != limit) {
       uint16_t pvIndex;
       UTRIE2_U8_NEXT16(sel->trie, s, limit, pvIndex);
-      if (intersectMasks(mask, sel->pv+pvIndex, columns)) {
-        break;
+      if (pvIndex != prevIndex) {
+        if (intersectMasks(mask, sel->pv+pvIndex, columns)) {
+          break;
+        }
+        prevIndex = pvIndex;
       }
     }
   }
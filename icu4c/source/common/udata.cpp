@@ -80,6 +80,7 @@ U_NAMESPACE_USE
  *  Forward declarations
  */
 static UDataMemory *udata_findCachedData(const char *path, UErrorCode &err);
+static void udata_cleanupCache();
 
 /***********************************************************************
 *
@@ -104,12 +105,12 @@ static UDataMemory *udata_findCachedData(const char *path, UErrorCode &err);
  * of this.
  */
 static UDataMemory *gCommonICUDataArray[10] = { NULL };   // Access protected by icu global mutex.
+// Number of non-NULL gCommonICUDataArray[] entries. Entries are only appended,
+// so the first ones can be read without the mutex.
+static u_atomic_int32_t gCommonICUDataCount = ATOMIC_INT32_T_INITIALIZER(0);
 
 static u_atomic_int32_t gHaveTriedToLoadCommonData = ATOMIC_INT32_T_INITIALIZER(0);  //  See extendICUData().
 
-static UHashtable  *gCommonDataCache = NULL;  /* Global hash table of opened ICU data files.  */
-static icu::UInitOnce gCommonDataCacheInitOnce = U_INITONCE_INITIALIZER;
-
 #if U_PLATFORM_HAS_WINUWP_API == 0 
 static UDataFileAccess  gDataFileAccess = UDATA_DEFAULT_ACCESS;  // Access not synchronized.
                                                                  // Modifying is documented as thread-unsafe.
@@ -122,16 +123,13 @@ udata_cleanup(void)
 {
     int32_t i;
 
-    if (gCommonDataCache) {             /* Delete the cache of user data mappings.  */
-        uhash_close(gCommonDataCache);  /*   Table owns the contents, and will delete them. */
-        gCommonDataCache = NULL;        /*   Cleanup is not thread safe.                */
-    }
-    gCommonDataCacheInitOnce.reset();
+    udata_cleanupCache();               /* Delete the cache of user data mappings.  */
 
     for (i = 0; i < UPRV_LENGTHOF(gCommonICUDataArray) && gCommonICUDataArray[i] != NULL; ++i) {
         udata_close(gCommonICUDataArray[i]);
         gCommonICUDataArray[i] = NULL;
     }
+    gCommonICUDataCount = 0;
     gHaveTriedToLoadCommonData = 0;
 
     return TRUE;                   /* Everything was cleaned up */
@@ -186,6 +184,7 @@ setCommonICUData(UDataMemory *pData,     /*  The new common data.  Belongs to ca
     for (i = 0; i < UPRV_LENGTHOF(gCommonICUDataArray); ++i) {
         if (gCommonICUDataArray[i] == NULL) {
             gCommonICUDataArray[i] = newCommonData;
+            umtx_storeRelease(gCommonICUDataCount, i + 1);
             didUpdate = TRUE;
             break;
         } else if (gCommonICUDataArray[i]->pHeader == pData->pHeader) {
@@ -264,7 +263,26 @@ typedef struct DataCacheElement {
     UDataMemory   *item;
 } DataCacheElement;
 
+/*
+ * The cache is looked up without locking, because every udata_open() of a
+ * packaged data item looks up its package here.
+ * Elements are only added (until cleanup), into a fixed-size open-addressing
+ * hash table. Each slot is written before it is published via its
+ * gDataCacheIsSet[] flag with release semantics, and a slot that is not yet
+ * published ends a lookup. Adding elements is serialized by gDataCacheMutex.
+ *
+ * When the table is full, further elements go into a UHashtable
+ * that is accessed only with gDataCacheMutex held.
+ */
+#define DATA_CACHE_CAPACITY 64   /* must be a power of 2 */
+#define DATA_CACHE_MAX_COUNT 48  /* leaves empty slots that end lookups */
 
+static DataCacheElement *gDataCache[DATA_CACHE_CAPACITY] = { NULL };
+static u_atomic_int32_t gDataCacheIsSet[DATA_CACHE_CAPACITY];
+static int32_t gDataCacheCount = 0;                  // Protected by gDataCacheMutex.
+static UHashtable *gDataCacheOverflow = NULL;        // Protected by gDataCacheMutex.
+static u_atomic_int32_t gHaveDataCacheOverflow = ATOMIC_INT32_T_INITIALIZER(0);
+static UMutex gDataCacheMutex = U_MUTEX_INITIALIZER;
 
 /*
  * Deleter function for DataCacheElements.
@@ -278,44 +296,60 @@ static void U_CALLCONV DataCacheElement_deleter(void *pDCEl) {
     uprv_free(pDCEl);                  /* delete 'this'          */
 }
 
-static void U_CALLCONV udata_initHashTable(UErrorCode &err) {
-    U_ASSERT(gCommonDataCache == NULL);
-    gCommonDataCache = uhash_open(uhash_hashChars, uhash_compareChars, NULL, &err);
-    if (U_FAILURE(err)) {
-       return;
+/* Not thread safe, like all cleanup. */
+static void udata_cleanupCache() {
+    for (int32_t i = 0; i < DATA_CACHE_CAPACITY; ++i) {
+        if (gDataCache[i] != NULL) {
+            DataCacheElement_deleter(gDataCache[i]);
+            gDataCache[i] = NULL;
+        }
+        gDataCacheIsSet[i] = 0;
     }
-    U_ASSERT(gCommonDataCache != NULL);
-    uhash_setValueDeleter(gCommonDataCache, DataCacheElement_deleter);
-    ucln_common_registerCleanup(UCLN_COMMON_UDATA, udata_cleanup);
+    gDataCacheCount = 0;
+    if (gDataCacheOverflow != NULL) {
+        uhash_close(gDataCacheOverflow);  /* Table owns the contents, and will delete them. */
+        gDataCacheOverflow = NULL;
+    }
+    gHaveDataCacheOverflow = 0;
 }
 
- /*   udata_getCacheHashTable()
-  *     Get the hash table used to store the data cache entries.
-  *     Lazy create it if it doesn't yet exist.
-  */
-static UHashtable *udata_getHashTable(UErrorCode &err) {
-    umtx_initOnce(gCommonDataCacheInitOnce, &udata_initHashTable, err);
-    return gCommonDataCache;
+static int32_t udata_getCacheSlot(const char *baseName) {
+    uint32_t hash = 0;
+    while (*baseName != 0) {
+        hash = hash * 37 + (uint8_t)*baseName++;
+    }
+    return (int32_t)(hash & (DATA_CACHE_CAPACITY - 1));
 }
 
-
+/* Lock-free lookup in the table, not in the overflow hash table. */
+static DataCacheElement *udata_findCacheElement(const char *baseName) {
+    int32_t i = udata_getCacheSlot(baseName);
+    while (umtx_loadAcquire(gDataCacheIsSet[i])) {
+        DataCacheElement *el = gDataCache[i];
+        if (uprv_strcmp(el->name, baseName) == 0) {
+            return el;
+        }
+        i = (i + 1) & (DATA_CACHE_CAPACITY - 1);
+    }
+    return NULL;
+}
 
 static UDataMemory *udata_findCachedData(const char *path, UErrorCode &err)
 {
-    UHashtable        *htable;
     UDataMemory       *retVal = NULL;
     DataCacheElement  *el;
     const char        *baseName;
 
-    htable = udata_getHashTable(err);
     if (U_FAILURE(err)) {
         return NULL;
     }
 
     baseName = findBasename(path);   /* Cache remembers only the base name, not the full path. */
-    umtx_lock(NULL);
-    el = (DataCacheElement *)uhash_get(htable, baseName);
-    umtx_unlock(NULL);
+    el = udata_findCacheElement(baseName);
+    if (el == NULL && umtx_loadAcquire(gHaveDataCacheOverflow)) {
+        Mutex lock(&gDataCacheMutex);
+        el = (DataCacheElement *)uhash_get(gDataCacheOverflow, baseName);
+    }
     if (el != NULL) {
         retVal = el->item;
     }
@@ -326,15 +360,42 @@ static UDataMemory *udata_findCachedData(const char *path, UErrorCode &err)
 }
 
 
+/* Call with gDataCacheMutex held. */
+static void udata_addCacheElement(DataCacheElement *newElement, UErrorCode &subErr) {
+    if (gDataCacheCount < DATA_CACHE_MAX_COUNT) {
+        int32_t i = udata_getCacheSlot(newElement->name);
+        while (gDataCache[i] != NULL) {
+            i = (i + 1) & (DATA_CACHE_CAPACITY - 1);
+        }
+        gDataCache[i] = newElement;
+        ++gDataCacheCount;
+        umtx_storeRelease(gDataCacheIsSet[i], 1);
+        return;
+    }
+    if (gDataCacheOverflow == NULL) {
+        gDataCacheOverflow = uhash_open(uhash_hashChars, uhash_compareChars, NULL, &subErr);
+        if (U_FAILURE(subErr)) {
+            return;
+        }
+        uhash_setValueDeleter(gDataCacheOverflow, DataCacheElement_deleter);
+    }
+    uhash_put(
+        gDataCacheOverflow,
+        newElement->name,               /* Key   */
+        newElement,                     /* Value */
+        &subErr);
+    if (U_SUCCESS(subErr)) {
+        umtx_storeRelease(gHaveDataCacheOverflow, 1);
+    }
+}
+
 static UDataMemory *udata_cacheDataItem(const char *path, UDataMemory *item, UErrorCode *pErr) {
     DataCacheElement *newElement;
     const char       *baseName;
     int32_t           nameLen;
-    UHashtable       *htable;
     DataCacheElement *oldValue = NULL;
     UErrorCode        subErr = U_ZERO_ERROR;
 
-    htable = udata_getHashTable(*pErr);
     if (U_FAILURE(*pErr)) {
         return NULL;
     }
@@ -365,21 +426,21 @@ static UDataMemory *udata_cacheDataItem(const char *path, UDataMemory *item, UEr
     }
     uprv_strcpy(newElement->name, baseName);
 
-    /* Stick the new DataCacheElement into the hash table.
+    /* Stick the new DataCacheElement into the cache.
     */
-    umtx_lock(NULL);
-    oldValue = (DataCacheElement *)uhash_get(htable, path);
-    if (oldValue != NULL) {
-        subErr = U_USING_DEFAULT_WARNING;
-    }
-    else {
-        uhash_put(
-            htable,
-            newElement->name,               /* Key   */
-            newElement,                     /* Value */
-            &subErr);
+    {
+        Mutex lock(&gDataCacheMutex);
+        oldValue = udata_findCacheElement(baseName);
+        if (oldValue == NULL && gDataCacheOverflow != NULL) {
+            oldValue = (DataCacheElement *)uhash_get(gDataCacheOverflow, baseName);
+        }
+        if (oldValue != NULL) {
+            subErr = U_USING_DEFAULT_WARNING;
+        }
+        else {
+            udata_addCacheElement(newElement, subErr);
+        }
     }
-    umtx_unlock(NULL);
 
 #ifdef UDATA_DEBUG
     fprintf(stderr, "Cache: [%s] <<< %p : %s. vFunc=%p\n", newElement->name, 
@@ -394,6 +455,7 @@ static UDataMemory *udata_cacheDataItem(const char *path, UDataMemory *item, UEr
         return oldValue ? oldValue->item : NULL;
     }
 
+    ucln_common_registerCleanup(UCLN_COMMON_UDATA, udata_cleanup);
     return newElement->item;
 }
 
@@ -685,6 +747,9 @@ openCommonData(const char *path,          /*  Path from OpenChoice?          */
         if(commonDataIndex >= UPRV_LENGTHOF(gCommonICUDataArray)) {
             return NULL;
         }
+        if(commonDataIndex < umtx_loadAcquire(gCommonICUDataCount)) {
+            return gCommonICUDataArray[commonDataIndex];
+        }
         {
             Mutex lock;
             if(gCommonICUDataArray[commonDataIndex] != NULL) {
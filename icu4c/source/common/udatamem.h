@@ -42,6 +42,8 @@ struct UDataMemory {
                                    /*  the associated data, and additional info       */
                                    /*   beyond the mapAddr is needed to do that.      */
     int32_t           length;      /* Length of the data in bytes; -1 if unknown.     */
+    const uint32_t   *tocHash;     /* For common memory with an offset TOC, its       */
+                                   /*   optional hash index, see ucmndata.h.          */
 };
 
 U_CFUNC UDataMemory *UDataMemory_createNewInstance(UErrorCode *pErr);
@@ -76,6 +76,9 @@
 #   define IS_MAP(map) ((map)!=NULL)
 #endif
 
+/* UDataMapPolicy flags, see udata_setMapPolicy() */
+static uint32_t gMapPolicy = UDATA_MAP_DEFAULT;
+
 /*----------------------------------------------------------------------------*
  *                                                                            *
  *   Memory Mapped File support.  Platform dependent implementation of        *
@@ -192,12 +195,57 @@
 
 
 #elif MAP_IMPLEMENTATION==MAP_POSIX
+#   if defined(MAP_ANONYMOUS) || defined(MAP_ANON)
+#       ifndef MAP_ANONYMOUS
+#           define MAP_ANONYMOUS MAP_ANON
+#       endif
+    /* huge pages are usually 2MB; align copies to that so that they can use them */
+#   define UMAP_HUGE_PAGE_SIZE (2*1024*1024)
+
+    /*
+     * Reads the file into an anonymous, read-only mapping.
+     * Returns the mapping and sets *pMapLength, or returns MAP_FAILED.
+     */
+    static void *
+    umap_copyFile(int fd, int length, uint32_t policy, size_t *pMapLength) {
+        size_t mapLength=(size_t)length;
+        if(policy&UDATA_MAP_HUGE_PAGES) {
+            mapLength=(mapLength+UMAP_HUGE_PAGE_SIZE-1)&~(size_t)(UMAP_HUGE_PAGE_SIZE-1);
+        }
+        void *data=mmap(0, mapLength, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+        if(data==MAP_FAILED) {
+            return MAP_FAILED;
+        }
+#       ifdef MADV_HUGEPAGE
+        if(policy&UDATA_MAP_HUGE_PAGES) {
+            madvise(data, mapLength, MADV_HUGEPAGE);
+        }
+#       endif
+        char *p=(char *)data;
+        int remaining=length;
+        while(remaining>0) {
+            ssize_t count=read(fd, p, remaining);
+            if(count<=0) {
+                munmap(data, mapLength);
+                return MAP_FAILED;
+            }
+            p+=count;
+            remaining-=(int)count;
+        }
+        mprotect(data, mapLength, PROT_READ);
+        *pMapLength=mapLength;
+        return data;
+    }
+#   endif
+
     U_CFUNC UBool
     uprv_mapFile(UDataMemory *pData, const char *path) {
         int fd;
         int length;
         struct stat mystat;
         void *data;
+        size_t mapLength;
+        uint32_t policy=gMapPolicy;
 
         UDataMemory_init(pData); /* Clear the output struct.        */
 
@@ -206,6 +254,7 @@
             return FALSE;
         }
         length=mystat.st_size;
+        mapLength=(size_t)length;
 
         /* open the file */
         fd=open(path, O_RDONLY);
@@ -213,20 +262,47 @@
             return FALSE;
         }
 
-        /* get a view of the mapping */
+#if defined(MAP_ANONYMOUS)
+        if(policy&UDATA_MAP_COPY) {
+            data=umap_copyFile(fd, length, policy, &mapLength);
+        } else
+#endif
+        {
+            /* get a view of the mapping */
+            int flags;
 #if U_PLATFORM != U_PF_HPUX
-        data=mmap(0, length, PROT_READ, MAP_SHARED,  fd, 0);
+            flags=MAP_SHARED;
 #else
-        data=mmap(0, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            flags=MAP_PRIVATE;
+#endif
+#ifdef MAP_POPULATE
+            if(policy&UDATA_MAP_PREFAULT) {
+                flags|=MAP_POPULATE;
+            }
+#endif
+            data=mmap(0, length, PROT_READ, flags, fd, 0);
+#ifdef MADV_HUGEPAGE
+            /* only effective where the kernel supports huge pages for file mappings */
+            if(data!=MAP_FAILED && (policy&UDATA_MAP_HUGE_PAGES)) {
+                madvise(data, length, MADV_HUGEPAGE);
+            }
 #endif
+            if(data!=MAP_FAILED && (policy&UDATA_MAP_PREFAULT)) {
+                posix_madvise(data, length, POSIX_MADV_WILLNEED);
+            }
+        }
         close(fd); /* no longer needed */
         if(data==MAP_FAILED) {
             return FALSE;
         }
 
-        pData->map = (char *)data + length;
+        pData->map = (char *)data + mapLength;
         pData->pHeader=(const DataHeader *)data;
         pData->mapAddr = data;
+        if(policy&UDATA_MAP_LOCK) {
+            /* best effort; fails without privileges or beyond RLIMIT_MEMLOCK */
+            mlock(data, mapLength);
+        }
 #if U_PLATFORM == U_PF_IPHONE
         posix_madvise(data, length, POSIX_MADV_RANDOM);
 #endif
@@ -496,3 +572,16 @@
 #else
 #   error MAP_IMPLEMENTATION is set incorrectly
 #endif
+
+U_CAPI void U_EXPORT2
+udata_setMapPolicy(uint32_t policy, UErrorCode *status) {
+    if(U_FAILURE(*status)) {
+        return;
+    }
+    if((policy&~(uint32_t)(UDATA_MAP_PREFAULT|UDATA_MAP_HUGE_PAGES|UDATA_MAP_LOCK|UDATA_MAP_COPY))!=0) {
+        *status=U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    // Note: this function is documented as not thread safe, like udata_setFileAccess().
+    gMapPolicy=policy;
+}
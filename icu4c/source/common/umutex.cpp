@@ -333,6 +333,15 @@ umtx_atomic_dec(u_atomic_int32_t *p) {
     return retVal;
 }
 
+U_COMMON_API int32_t U_EXPORT2
+umtx_atomic_add(u_atomic_int32_t *p, int32_t delta) {
+    int32_t retVal;
+    umtx_lock(&gIncDecMutex);
+    retVal = (*p += delta);
+    umtx_unlock(&gIncDecMutex);
+    return retVal;
+}
+
 U_COMMON_API int32_t U_EXPORT2
 umtx_loadAcquire(u_atomic_int32_t &var) {
     umtx_lock(&gIncDecMutex);
@@ -74,6 +74,10 @@ inline int32_t umtx_atomic_inc(u_atomic_int32_t *var) {
 inline int32_t umtx_atomic_dec(u_atomic_int32_t *var) {
     return var->fetch_sub(1) - 1;
 }
+
+inline int32_t umtx_atomic_add(u_atomic_int32_t *var, int32_t delta) {
+    return var->fetch_add(delta) + delta;
+}
 U_NAMESPACE_END
 
 #elif U_PLATFORM_HAS_WIN32_API
@@ -119,6 +123,10 @@ inline int32_t umtx_atomic_inc(u_atomic_int32_t *var) {
 inline int32_t umtx_atomic_dec(u_atomic_int32_t *var) {
     return InterlockedDecrement(var);
 }
+
+inline int32_t umtx_atomic_add(u_atomic_int32_t *var, int32_t delta) {
+    return InterlockedExchangeAdd(var, delta) + delta;
+}
 U_NAMESPACE_END
 
 
@@ -146,6 +154,10 @@ inline int32_t umtx_atomic_inc(u_atomic_int32_t *var) {
 inline int32_t umtx_atomic_dec(u_atomic_int32_t *var) {
     return __c11_atomic_fetch_sub(var, 1, __ATOMIC_SEQ_CST) - 1;
 }
+
+inline int32_t umtx_atomic_add(u_atomic_int32_t *var, int32_t delta) {
+    return __c11_atomic_fetch_add(var, delta, __ATOMIC_SEQ_CST) + delta;
+}
 U_NAMESPACE_END
 
 
@@ -176,6 +188,10 @@ inline int32_t umtx_atomic_inc(u_atomic_int32_t *p)  {
 inline int32_t umtx_atomic_dec(u_atomic_int32_t *p)  {
    return __sync_sub_and_fetch(p, 1);
 }
+
+inline int32_t umtx_atomic_add(u_atomic_int32_t *p, int32_t delta)  {
+   return __sync_add_and_fetch(p, delta);
+}
 U_NAMESPACE_END
 
 #else
@@ -203,6 +219,9 @@ umtx_atomic_inc(u_atomic_int32_t *p);
 U_COMMON_API int32_t U_EXPORT2 
 umtx_atomic_dec(u_atomic_int32_t *p);
 
+U_COMMON_API int32_t U_EXPORT2 
+umtx_atomic_add(u_atomic_int32_t *p, int32_t delta);
+
 U_NAMESPACE_END
 
 #endif  /* Low Level Atomic Ops Platfrom Chain */
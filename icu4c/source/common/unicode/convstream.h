@@ -0,0 +1,159 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// convstream.h
+
+#ifndef __CONVSTREAM_H__
+#define __CONVSTREAM_H__
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_CONVERSION
+
+#include "unicode/stringpiece.h"
+#include "unicode/ucnv.h"
+#include "unicode/uobject.h"
+
+/**
+ * \file
+ * \brief C++ API: Streaming conversion of scattered input to a ByteSink.
+ */
+
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * One piece of input text for ConverterStream::convert(), like a struct iovec.
+ * @draft ICU 63
+ */
+typedef struct UConverterSegment {
+    /**
+     * Pointer to the bytes of this segment.
+     * @draft ICU 63
+     */
+    const char *data;
+    /**
+     * Number of bytes in this segment.
+     * @draft ICU 63
+     */
+    int32_t length;
+} UConverterSegment;
+
+U_NAMESPACE_BEGIN
+
+class ByteSink;
+
+/**
+ * Converts a stream of text from one charset to another,
+ * reading input segments where they are and writing to a ByteSink.
+ *
+ * This works like a sequence of ucnv_convertEx() calls, with the pivot buffer
+ * inside this object. The input need not be copied into one contiguous buffer:
+ * A character may span several segments; the converters and the pivot buffer
+ * carry the state from one segment and one convert() call to the next.
+ * The output is written into buffers from ByteSink::GetAppendBuffer(),
+ * which are the destination memory itself for sinks like CheckedArrayByteSink.
+ *
+ * The object uses but does not own the two converters.
+ * They must not be used otherwise while the stream uses them.
+ *
+ * \code
+ * std::string out;
+ * StringByteSink<std::string> sink(&out);
+ * ConverterStream stream(utf8Cnv, sjisCnv);
+ * while (readSegments(segments, &count)) {
+ *     stream.convert(segments, count, sink, FALSE, errorCode);
+ * }
+ * stream.convert(NULL, 0, sink, TRUE, errorCode);  // flush
+ * \endcode
+ *
+ * @see ucnv_convertEx
+ * @draft ICU 63
+ */
+class U_COMMON_API ConverterStream U_FINAL : public UMemory {
+public:
+    /**
+     * Constructs a stream for converting from the source converter's charset
+     * to the target converter's charset.
+     * The first convert() call resets the converters.
+     *
+     * @param targetCnv Output converter, used to convert from the UTF-16 pivot
+     *                  to the target.
+     * @param sourceCnv Input converter, used to convert from the source to
+     *                  the UTF-16 pivot.
+     * @draft ICU 63
+     */
+    ConverterStream(UConverter *targetCnv, UConverter *sourceCnv)
+            : targetCnv_(targetCnv), sourceCnv_(sourceCnv),
+              pivotSource_(pivot_), pivotTarget_(pivot_), reset_(TRUE) {}
+
+    /**
+     * Starts a new stream: Discards buffered text, and the next convert() call
+     * resets the converters.
+     * @draft ICU 63
+     */
+    void reset() {
+        pivotSource_ = pivotTarget_ = pivot_;
+        reset_ = TRUE;
+    }
+
+    /**
+     * Converts the next segments of the input text and appends the output to the sink.
+     *
+     * If flush is FALSE, then an incomplete character at the end of the input
+     * is kept for the next call.
+     * If flush is TRUE, then this is the end of the stream, and the next call
+     * starts a new one.
+     *
+     * @param segments  The input segments, in text order.
+     * @param count     The number of segments. May be 0, for example for
+     *                  flushing without further input.
+     * @param sink      Receives the output.
+     * @param flush     TRUE if this is the end of the input.
+     * @param errorCode Reference to an in/out error code value
+     *                  which must not indicate a failure before the function call.
+     *                  After a conversion error, as from a stop callback,
+     *                  the output up to the error has been appended, and
+     *                  reset() must be called before further use.
+     * @see ucnv_convertEx
+     * @draft ICU 63
+     */
+    void convert(const UConverterSegment *segments, int32_t count,
+                 ByteSink &sink, UBool flush, UErrorCode &errorCode);
+
+    /**
+     * Converts the next segment of the input text and appends the output to the sink.
+     * Same as convert(const UConverterSegment *, int32_t, ...) with a single segment.
+     *
+     * @param segment   The input text.
+     * @param sink      Receives the output.
+     * @param flush     TRUE if this is the end of the input.
+     * @param errorCode Reference to an in/out error code value
+     *                  which must not indicate a failure before the function call.
+     * @draft ICU 63
+     */
+    void convert(StringPiece segment, ByteSink &sink, UBool flush, UErrorCode &errorCode);
+
+private:
+    ConverterStream(const ConverterStream &other) = delete;
+    ConverterStream &operator=(const ConverterStream &other) = delete;
+
+    void convertSegment(const char *s, const char *limit,
+                        ByteSink &sink, UBool flush, UErrorCode &errorCode);
+
+    static const int32_t PIVOT_CAPACITY = 512;
+
+    UConverter *targetCnv_;
+    UConverter *sourceCnv_;
+    UChar pivot_[PIVOT_CAPACITY];
+    UChar *pivotSource_;
+    UChar *pivotTarget_;
+    UBool reset_;
+};
+
+U_NAMESPACE_END
+
+#endif  // U_HIDE_DRAFT_API
+
+#endif  // !UCONFIG_NO_CONVERSION
+
+#endif  // __CONVSTREAM_H__
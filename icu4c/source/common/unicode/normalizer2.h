@@ -29,6 +29,7 @@
 #if !UCONFIG_NO_NORMALIZATION
 
 #include "unicode/stringpiece.h"
+#include "unicode/uexecutor.h"
 #include "unicode/uniset.h"
 #include "unicode/unistr.h"
 #include "unicode/unorm2.h"
@@ -223,10 +224,10 @@ class U_COMMON_API Normalizer2 : public UObject {
      * Normalizes a UTF-8 string and optionally records how source substrings
      * relate to changed and unchanged result substrings.
      *
-     * Currently implemented completely only for "compose" modes,
-     * such as for NFC, NFKC, and NFKC_Casefold
-     * (UNORM2_COMPOSE and UNORM2_COMPOSE_CONTIGUOUS).
-     * Otherwise currently converts to & from UTF-16 and does not support edits.
+     * Implemented directly on UTF-8 for the "compose", "decompose" and FCD modes,
+     * such as for NFC, NFD, NFKC, NFKD and NFKC_Casefold.
+     * Otherwise (for custom Normalizer2 subclasses) the default implementation
+     * converts to & from UTF-16 and does not support edits.
      *
      * @param options   Options bit set, usually 0. See U_OMIT_UNCHANGED_TEXT and U_EDITS_NO_RESET.
      * @param src       Source UTF-8 string.
@@ -247,6 +248,154 @@ class U_COMMON_API Normalizer2 : public UObject {
     normalizeUTF8(uint32_t options, StringPiece src, ByteSink &sink,
                   Edits *edits, UErrorCode &errorCode) const;
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Normalizes a large string using several threads.
+     *
+     * Splits the source into chunks of at least chunkLength UChars,
+     * each one starting with a code point for which hasBoundaryBefore() is true,
+     * normalizes the chunks with normalize() on a caller-supplied executor,
+     * and concatenates the results. At such a boundary the text before and after
+     * does not interact, so the result is the same as from normalize().
+     *
+     * The first chunk is normalized on the calling thread.
+     * This function returns only after all chunks are normalized.
+     * Without an executor, the whole string is normalized on the calling thread.
+     *
+     * @param src       source string
+     * @param dest      destination string; its contents is replaced with normalized src
+     * @param chunkLength The minimum number of UChars per chunk;
+     *                  0 or negative for a default of 256k.
+     * @param executor  The executor for all but the first chunk; can be NULL.
+     *                  See UExecutorFn for its requirements.
+     * @param executorContext The context pointer for the executor.
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     *                  If several chunks fail, then the failure of the earliest
+     *                  one in the text is returned.
+     * @return dest
+     * @see UExecutorFn
+     * @draft ICU 63
+     */
+    UnicodeString &
+    normalizeBulk(const UnicodeString &src, UnicodeString &dest,
+                  int32_t chunkLength, UExecutorFn *executor, const void *executorContext,
+                  UErrorCode &errorCode) const;
+
+    /**
+     * Normalizes a large UTF-8 string using several threads,
+     * and optionally records how source substrings
+     * relate to changed and unchanged result substrings.
+     *
+     * Splits the source like normalizeBulk() does, with chunkLength counting bytes,
+     * and normalizes the chunks with normalizeUTF8().
+     * Writes the output and records the edits in text order,
+     * after all chunks are normalized.
+     * The output and the edits are the same as from normalizeUTF8().
+     *
+     * @param options   Options bit set, usually 0. See U_OMIT_UNCHANGED_TEXT and U_EDITS_NO_RESET.
+     * @param src       Source UTF-8 string.
+     * @param sink      A ByteSink to which the normalized UTF-8 result string is written.
+     *                  sink.Flush() is called at the end.
+     * @param edits     Records edits for index mapping, working with styled text,
+     *                  and getting only changes (if any).
+     *                  The Edits contents is undefined if any error occurs.
+     *                  This function calls edits->reset() first unless
+     *                  options includes U_EDITS_NO_RESET. edits can be nullptr.
+     * @param chunkLength The minimum number of bytes per chunk;
+     *                  0 or negative for a default of 256kB.
+     * @param executor  The executor for all but the first chunk; can be NULL.
+     *                  See UExecutorFn for its requirements.
+     * @param executorContext The context pointer for the executor.
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     *                  If several chunks fail, then the failure of the earliest
+     *                  one in the text is returned, and nothing is written to the sink.
+     * @see UExecutorFn
+     * @draft ICU 63
+     */
+    void
+    normalizeUTF8Bulk(uint32_t options, StringPiece src, ByteSink &sink, Edits *edits,
+                      int32_t chunkLength, UExecutorFn *executor, const void *executorContext,
+                      UErrorCode &errorCode) const;
+
+    /**
+     * Normalizes each of an array of strings, for many short strings
+     * such as names or tags.
+     *
+     * Appends the normalized forms one after another to the arena string
+     * and sets offsets[i] to where the output for srcs[i] starts in the arena;
+     * offsets[count] is set to the arena length at the end.
+     * The result for srcs[i] is arena[offsets[i]..offsets[i+1][.
+     *
+     * If isNormalized is not NULL, then isNormalized[i] is set to TRUE for
+     * each source string which is already normalized, and such a string is not
+     * copied to the arena (offsets[i]==offsets[i+1]): The caller uses the source
+     * string itself. Otherwise all results are written to the arena.
+     *
+     * This is faster than calling normalize() for each string:
+     * The source strings are checked where they are, and only the parts
+     * after the quick check spans are normalized, directly into the arena.
+     *
+     * @param srcs      Array of count pointers to the source strings.
+     * @param lengths   Array of count lengths of the source strings,
+     *                  or -1 for a NUL-terminated string.
+     *                  If lengths is NULL, then all source strings are NUL-terminated.
+     * @param count     The number of source strings.
+     * @param arena     Receives the normalized strings; they are appended
+     *                  to its current contents. Must not alias any source string.
+     * @param offsets   Array of count+1 elements; receives the arena indexes
+     *                  of the results.
+     * @param isNormalized Array of count elements, or NULL; see above.
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     *                  Set to U_ILLEGAL_ARGUMENT_ERROR if count<0,
+     *                  if a required array is NULL, or if a source string is NULL.
+     * @draft ICU 63
+     */
+    void
+    normalizeBatch(const UChar *const *srcs, const int32_t *lengths, int32_t count,
+                   UnicodeString &arena, int32_t *offsets, UBool *isNormalized,
+                   UErrorCode &errorCode) const;
+
+    /**
+     * Normalizes each of an array of UTF-8 strings, for many short strings
+     * such as names or tags. Works like normalizeBatch(),
+     * with one normalizeUTF8() pass per string.
+     *
+     * Writes the normalized forms one after another to the sink.
+     * offsets[i] is set to the number of bytes that this function wrote
+     * before the output for srcs[i], and offsets[count] to the total number.
+     * If isNormalized is not NULL, then isNormalized[i] is set to TRUE for
+     * each source string which is already normalized, and such a string is not
+     * written to the sink. Otherwise all results are written to the sink.
+     * sink.Flush() is called at the end.
+     *
+     * @param srcs      Array of count source strings.
+     * @param count     The number of source strings.
+     * @param sink      A ByteSink to which the normalized UTF-8 strings are written.
+     * @param offsets   Array of count+1 elements; receives the output offsets.
+     * @param isNormalized Array of count elements, or NULL; see above.
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     *                  Set to U_ILLEGAL_ARGUMENT_ERROR if count<0
+     *                  or if a required array is NULL.
+     * @draft ICU 63
+     */
+    void
+    normalizeUTF8Batch(const StringPiece *srcs, int32_t count,
+                       ByteSink &sink, int32_t *offsets, UBool *isNormalized,
+                       UErrorCode &errorCode) const;
+#endif  // U_HIDE_DRAFT_API
+
     /**
      * Appends the normalized form of the second string to the first string
      * (merging them at the boundary) and returns the first string.
@@ -379,11 +528,11 @@ class U_COMMON_API Normalizer2 : public UObject {
      * resolves to "yes" or "no" to provide a definitive result,
      * at the cost of doing more work in those cases.
      *
-     * This works for all normalization modes,
-     * but it is currently optimized for UTF-8 only for "compose" modes,
-     * such as for NFC, NFKC, and NFKC_Casefold
-     * (UNORM2_COMPOSE and UNORM2_COMPOSE_CONTIGUOUS).
-     * For other modes it currently converts to UTF-16 and calls isNormalized().
+     * This works for all normalization modes.
+     * It is implemented directly on UTF-8 for the "compose", "decompose" and FCD modes,
+     * such as for NFC, NFD, NFKC, NFKD and NFKC_Casefold.
+     * Otherwise (for custom Normalizer2 subclasses) the default implementation
+     * converts to UTF-16 and calls isNormalized().
      *
      * @param s UTF-8 input string
      * @param errorCode Standard ICU error code. Its input value must
@@ -541,10 +690,10 @@ class U_COMMON_API FilteredNormalizer2 : public Normalizer2 {
      * Normalizes a UTF-8 string and optionally records how source substrings
      * relate to changed and unchanged result substrings.
      *
-     * Currently implemented completely only for "compose" modes,
-     * such as for NFC, NFKC, and NFKC_Casefold
-     * (UNORM2_COMPOSE and UNORM2_COMPOSE_CONTIGUOUS).
-     * Otherwise currently converts to & from UTF-16 and does not support edits.
+     * Implemented directly on UTF-8 for the "compose", "decompose" and FCD modes,
+     * such as for NFC, NFD, NFKC, NFKD and NFKC_Casefold.
+     * Otherwise (for custom Normalizer2 subclasses) the default implementation
+     * converts to & from UTF-16 and does not support edits.
      *
      * @param options   Options bit set, usually 0. See U_OMIT_UNCHANGED_TEXT and U_EDITS_NO_RESET.
      * @param src       Source UTF-8 string.
@@ -674,11 +823,11 @@ class U_COMMON_API FilteredNormalizer2 : public Normalizer2 {
      * resolves to "yes" or "no" to provide a definitive result,
      * at the cost of doing more work in those cases.
      *
-     * This works for all normalization modes,
-     * but it is currently optimized for UTF-8 only for "compose" modes,
-     * such as for NFC, NFKC, and NFKC_Casefold
-     * (UNORM2_COMPOSE and UNORM2_COMPOSE_CONTIGUOUS).
-     * For other modes it currently converts to UTF-16 and calls isNormalized().
+     * This works for all normalization modes.
+     * It is implemented directly on UTF-8 for the "compose", "decompose" and FCD modes,
+     * such as for NFC, NFD, NFKC, NFKD and NFKC_Casefold.
+     * Otherwise (for custom Normalizer2 subclasses) the default implementation
+     * converts to UTF-16 and calls isNormalized().
      *
      * @param s UTF-8 input string
      * @param errorCode Standard ICU error code. Its input value must
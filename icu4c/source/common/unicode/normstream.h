@@ -0,0 +1,146 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// normstream.h
+
+#ifndef __NORMSTREAM_H__
+#define __NORMSTREAM_H__
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_NORMALIZATION
+
+#include "unicode/stringpiece.h"
+#include "unicode/unistr.h"
+#include "unicode/uobject.h"
+
+/**
+ * \file
+ * \brief C++ API: Normalization of text that arrives in chunks.
+ */
+
+#ifndef U_HIDE_DRAFT_API
+
+U_NAMESPACE_BEGIN
+
+class Appendable;
+class ByteSink;
+class CharString;
+class Normalizer2;
+
+/**
+ * Normalizes a stream of text which is passed in as a sequence of chunks,
+ * with either UTF-8 or UTF-16 input and output.
+ *
+ * Each call normalizes and writes out the text up to the last
+ * Normalizer2::hasBoundaryBefore() code point of what it has seen so far.
+ * Only the text from there to the end of the chunk is kept for the next call,
+ * together with a character that is split across chunks.
+ * The output is the same as from normalizing the concatenated chunks,
+ * but the whole input need not be in memory at once.
+ * The kept text is normally short. It grows only for input with long sequences
+ * of characters that interact in normalization, such as
+ * thousands of combining marks in a row.
+ *
+ * Use either UTF-8 or UTF-16 chunks for one stream.
+ * After a flush, the next chunk starts a new stream which can use the other form.
+ *
+ * The object uses but does not own the Normalizer2.
+ *
+ * \code
+ * std::string out;
+ * StringByteSink<std::string> sink(&out);
+ * NormalizerStream stream(*Normalizer2::getNFCInstance(errorCode));
+ * while (readChunk(chunk)) {
+ *     stream.normalizeUTF8(chunk, sink, FALSE, errorCode);
+ * }
+ * stream.normalizeUTF8(StringPiece(), sink, TRUE, errorCode);  // flush
+ * \endcode
+ *
+ * @draft ICU 63
+ */
+class U_COMMON_API NormalizerStream U_FINAL : public UMemory {
+public:
+    /**
+     * Constructs a stream which normalizes with the given normalizer.
+     *
+     * @param n2 Normalizer2 instance, for example
+     *           Normalizer2::getNFCInstance() or a FilteredNormalizer2.
+     *           It must outlive the stream.
+     * @draft ICU 63
+     */
+    explicit NormalizerStream(const Normalizer2 &n2) : n2_(n2), pending8_(NULL) {}
+
+    /**
+     * Destructor.
+     * @draft ICU 63
+     */
+    ~NormalizerStream();
+
+    /**
+     * Starts a new stream: Discards the text kept from previous chunks.
+     * @draft ICU 63
+     */
+    void reset();
+
+    /**
+     * Normalizes the next chunk of UTF-8 text and appends the output to the sink,
+     * except for a tail of text which might still change with the next chunk.
+     *
+     * A chunk may end in the middle of a character.
+     * Ill-formed sequences are copied to the output like
+     * with Normalizer2::normalizeUTF8().
+     *
+     * @param chunk     The next piece of input text.
+     * @param sink      Receives the output.
+     *                  Each call with output calls sink.Flush().
+     * @param flush     TRUE if this is the end of the input:
+     *                  Writes all remaining text, and the next call starts a new stream.
+     * @param errorCode Reference to an in/out error code value
+     *                  which must not indicate a failure before the function call.
+     *                  Set to U_ILLEGAL_ARGUMENT_ERROR if the stream has
+     *                  UTF-16 text from normalize() that was not flushed yet.
+     * @draft ICU 63
+     */
+    void normalizeUTF8(StringPiece chunk, ByteSink &sink, UBool flush, UErrorCode &errorCode);
+
+    /**
+     * Normalizes the next chunk of UTF-16 text and appends the output,
+     * except for a tail of text which might still change with the next chunk.
+     *
+     * A chunk may end between the two surrogates of a supplementary code point.
+     * Unpaired surrogates are copied to the output.
+     *
+     * @param chunk     The next piece of input text.
+     *                  Use a read-only alias to avoid copying a large buffer.
+     * @param dest      Receives the output.
+     * @param flush     TRUE if this is the end of the input:
+     *                  Writes all remaining text, and the next call starts a new stream.
+     * @param errorCode Reference to an in/out error code value
+     *                  which must not indicate a failure before the function call.
+     *                  Set to U_ILLEGAL_ARGUMENT_ERROR if the stream has
+     *                  UTF-8 text from normalizeUTF8() that was not flushed yet.
+     * @draft ICU 63
+     */
+    void normalize(const UnicodeString &chunk, Appendable &dest, UBool flush,
+                   UErrorCode &errorCode);
+
+private:
+    NormalizerStream(const NormalizerStream &other) = delete;
+    NormalizerStream &operator=(const NormalizerStream &other) = delete;
+
+    const Normalizer2 &n2_;
+    // Text since the last boundary, in the form of the current stream.
+    CharString *pending8_;
+    UnicodeString pending16_;
+    // Reusable normalize() output.
+    UnicodeString normalized16_;
+};
+
+U_NAMESPACE_END
+
+#endif  // U_HIDE_DRAFT_API
+
+#endif  // !UCONFIG_NO_NORMALIZATION
+
+#endif  // __NORMSTREAM_H__
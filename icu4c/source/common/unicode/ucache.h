@@ -0,0 +1,139 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+#ifndef __UCACHE_H__
+#define __UCACHE_H__
+
+#include "unicode/utypes.h"
+
+/**
+ * \file
+ * \brief C API: Statistics and tuning of the ICU object cache.
+ *
+ * ICU keeps locale-dependent objects such as number formatting symbols,
+ * plural rules and date formatting symbols in a process-wide cache.
+ * The functions in this file report how well that cache performs for each
+ * kind of cached object, and set its eviction policy.
+ *
+ * The statistics are collected by the cache at all times; reading them
+ * does not slow down concurrent cache lookups noticeably.
+ */
+
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * Statistics for one kind of object in the ICU object cache.
+ *
+ * @see ucache_getStatistics
+ * @draft ICU 63
+ */
+typedef struct UCacheStatistics {
+    /**
+     * Implementation-specific name of the type of the cached objects.
+     * Points to static storage; valid as long as ICU is loaded.
+     * @draft ICU 63
+     */
+    const char *keyType;
+    /**
+     * Number of lookups that found an entry in the cache.
+     * @draft ICU 63
+     */
+    int64_t hitCount;
+    /**
+     * Number of lookups that did not find an entry, so that the
+     * object had to be created.
+     * @draft ICU 63
+     */
+    int64_t missCount;
+    /**
+     * Total time in milliseconds spent creating objects after misses.
+     * @draft ICU 63
+     */
+    double creationMillis;
+    /**
+     * Number of entries automatically evicted according to the eviction policy.
+     * Entries removed by flushing the cache are not counted.
+     * @draft ICU 63
+     */
+    int64_t evictionCount;
+    /**
+     * Number of entries currently in the cache.
+     * @draft ICU 63
+     */
+    int32_t entryCount;
+    /**
+     * Approximate number of bytes of heap memory currently retained by the
+     * cached objects. Objects that do not report their size count as 0.
+     * @draft ICU 63
+     */
+    int64_t bytesRetained;
+} UCacheStatistics;
+
+/**
+ * Reports statistics for each kind of object in the ICU object cache,
+ * sorted by UCacheStatistics.keyType.
+ *
+ * Standard ICU preflighting: If destCapacity is too small,
+ * then the first destCapacity items are written, the required capacity
+ * is returned, and *pErrorCode is set to U_BUFFER_OVERFLOW_ERROR.
+ *
+ * @param dest destination array; can be NULL if destCapacity==0
+ * @param destCapacity number of UCacheStatistics items that fit into dest
+ * @param pErrorCode ICU error code
+ * @return the number of kinds of objects for which statistics are available
+ * @draft ICU 63
+ */
+U_CAPI int32_t U_EXPORT2
+ucache_getStatistics(UCacheStatistics *dest, int32_t destCapacity, UErrorCode *pErrorCode);
+
+/**
+ * Resets the hit, miss, creation time and eviction counters
+ * of the ICU object cache to zero.
+ * The entry counts and retained bytes are not affected.
+ *
+ * @param pErrorCode ICU error code
+ * @draft ICU 63
+ */
+U_CAPI void U_EXPORT2
+ucache_resetStatistics(UErrorCode *pErrorCode);
+
+/**
+ * Configures at what point eviction of unused entries from the ICU object
+ * cache begins. Eviction is triggered whenever the number of evictable
+ * entries exceeds BOTH count AND
+ * (number of in-use entries) * (percentageOfInUseItems / 100).
+ *
+ * If this function is never called, the defaults are 1000 and 100%.
+ * Sets U_ILLEGAL_ARGUMENT_ERROR if either argument is negative.
+ *
+ * @param count the minimum number of unused entries that are retained
+ * @param percentageOfInUseItems the number of unused entries that are
+ *        retained relative to the number of in-use entries
+ * @param pErrorCode ICU error code
+ * @draft ICU 63
+ */
+U_CAPI void U_EXPORT2
+ucache_setEvictionPolicy(int32_t count, int32_t percentageOfInUseItems, UErrorCode *pErrorCode);
+
+/**
+ * Bounds the memory retained by the ICU object cache. While the estimated
+ * size of all cached objects exceeds maxBytes, unused objects are evicted
+ * even if the policy set with ucache_setEvictionPolicy() would keep them.
+ *
+ * With a budget in effect, the cache evicts objects that have not been
+ * fetched recently first (CLOCK algorithm), so that frequently used objects
+ * stay resident. Objects still referenced by clients are never evicted.
+ *
+ * maxBytes == 0, the default, disables the budget.
+ * Sets U_ILLEGAL_ARGUMENT_ERROR if maxBytes is negative.
+ *
+ * @param maxBytes the approximate maximum number of bytes of cached objects
+ * @param pErrorCode ICU error code
+ * @draft ICU 63
+ */
+U_CAPI void U_EXPORT2
+ucache_setMemoryBudget(int32_t maxBytes, UErrorCode *pErrorCode);
+
+#endif  // U_HIDE_DRAFT_API
+
+#endif  // __UCACHE_H__
@@ -52,6 +52,7 @@
 #include "unicode/ucnv_err.h"
 #include "unicode/uenum.h"
 #include "unicode/localpointer.h"
+#include "unicode/uexecutor.h"
 
 #ifndef __USET_H__
 
@@ -589,6 +590,118 @@ U_NAMESPACE_END
 
 #endif
 
+#ifndef U_HIDE_DRAFT_API
+
+struct UConverterPool;
+/**
+ * A pool of idle converters, for reuse instead of repeated
+ * ucnv_open() and ucnv_close() calls.
+ * @see ucnv_openPool
+ * @draft ICU 63
+ */
+typedef struct UConverterPool UConverterPool;
+
+/**
+ * Opens an empty converter pool.
+ *
+ * Code that opens a converter for each short conversion, for example for each
+ * request in a server, can instead get one with ucnv_acquireFromPool() and give it
+ * back with ucnv_releaseToPool(). Once the pool has warmed up, acquiring a
+ * converter for a name that was used before neither allocates memory nor
+ * looks up the shared converter data.
+ *
+ * A pool may be used from multiple threads; each call locks the pool briefly.
+ * For no contention at all, use one pool per thread.
+ *
+ * @param capacity the maximum number of idle converters that the pool keeps;
+ *                 further converters are closed when they are released
+ * @param pErrorCode ICU error code in/out parameter.
+ *                   Must fulfill U_SUCCESS before the function call.
+ * @return the new pool, or NULL if an error occurred;
+ *         must be closed with ucnv_closePool()
+ * @see ucnv_acquireFromPool
+ * @see ucnv_releaseToPool
+ * @draft ICU 63
+ */
+U_CAPI UConverterPool * U_EXPORT2
+ucnv_openPool(int32_t capacity, UErrorCode *pErrorCode);
+
+/**
+ * Closes a converter pool and all of the idle converters in it.
+ * Converters that are currently acquired from the pool are not affected;
+ * they must be closed with ucnv_close().
+ *
+ * @param pool the pool to be closed; can be NULL
+ * @draft ICU 63
+ */
+U_CAPI void U_EXPORT2
+ucnv_closePool(UConverterPool *pool);
+
+/**
+ * Returns a converter for the given name.
+ * If the pool holds an idle converter for the same canonical converter name,
+ * then that converter is removed from the pool and returned.
+ * Otherwise, a new converter is opened with ucnv_open().
+ * Either way, the converter is in its initial state.
+ *
+ * Converter names that contain options (like ",swaplfnl") are never
+ * matched with idle converters; they always open a new converter.
+ *
+ * @param pool the converter pool
+ * @param converterName name of the converter, as for ucnv_open();
+ *                      NULL or "" for the default converter
+ * @param pErrorCode ICU error code in/out parameter.
+ *                   Must fulfill U_SUCCESS before the function call.
+ * @return the converter, or NULL if an error occurred;
+ *         should be given back with ucnv_releaseToPool(), may instead be
+ *         closed with ucnv_close()
+ * @see ucnv_open
+ * @see ucnv_releaseToPool
+ * @draft ICU 63
+ */
+U_CAPI UConverter * U_EXPORT2
+ucnv_acquireFromPool(UConverterPool *pool, const char *converterName, UErrorCode *pErrorCode);
+
+/**
+ * Gives a converter back to the pool, ending its use by the caller.
+ * The converter is reset with ucnv_reset() and kept for later
+ * ucnv_acquireFromPool() calls.
+ *
+ * The converter is closed instead if the pool is full, or if the converter
+ * was changed in a way that ucnv_reset() does not undo: with different
+ * callbacks, substitution characters or fallback behavior.
+ *
+ * @param pool the converter pool; if NULL, then the converter is closed
+ * @param cnv the converter, normally from ucnv_acquireFromPool(),
+ *            or from ucnv_open() or ucnv_safeClone() with the default settings;
+ *            can be NULL
+ * @see ucnv_acquireFromPool
+ * @draft ICU 63
+ */
+U_CAPI void U_EXPORT2
+ucnv_releaseToPool(UConverterPool *pool, UConverter *cnv);
+
+#if U_SHOW_CPLUSPLUS_API
+
+U_NAMESPACE_BEGIN
+
+/**
+ * \class LocalUConverterPoolPointer
+ * "Smart pointer" class, closes a UConverterPool via ucnv_closePool().
+ * For most methods see the LocalPointerBase base class.
+ *
+ * @see LocalPointerBase
+ * @see LocalPointer
+ * @draft ICU 63
+ */
+U_DEFINE_LOCAL_OPEN_POINTER(LocalUConverterPoolPointer, UConverterPool, ucnv_closePool);
+
+U_NAMESPACE_END
+
+#endif
+
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Fills in the output parameter, subChars, with the substitution characters
  * as multiple bytes.
@@ -1571,6 +1684,80 @@ ucnv_convert(const char *toConverterName,
              int32_t sourceLength,
              UErrorCode *pErrorCode);
 
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * Convert a large buffer from one external charset to another,
+ * in chunks that are converted in parallel on the threads of an executor.
+ * The result is the same as from a single ucnv_convertEx() call
+ * with reset and flush set to TRUE.
+ *
+ * The source text is split only where the source converter has finished
+ * a character and is back in its initial state: after an ASCII byte in UTF-8,
+ * between code points in UTF-16BE/LE and UTF-32BE/LE, anywhere in ISO-8859-1
+ * and US-ASCII, and after a byte that always ends a character in
+ * SBCS, DBCS and MBCS tables without SI/SO shifting.
+ * The target converter must not carry state from one character to the next;
+ * this is true for the same charsets, except for table converters with
+ * mappings for sequences of several code points.
+ * The UTF-16BE/LE variants with a byte order mark (such as UnicodeBig and
+ * UnicodeLittle) are not split because they handle the BOM at the start of the text.
+ * For other combinations of converters, and if no executor is given,
+ * the whole buffer is converted as one chunk on the calling thread.
+ *
+ * The first chunk is converted with the two converters, after resetting them.
+ * The other chunks are converted with clones made via ucnv_safeClone(),
+ * so the callbacks set on the converters may be called on executor threads,
+ * concurrently and with the same context pointers.
+ * This function returns only after all chunks are converted.
+ *
+ * Like ucnv_convert(), this function allows NUL-terminated input,
+ * NUL-terminates the output if there is space, and supports preflighting.
+ *
+ * @param targetCnv     Output converter, used to convert from the UTF-16 pivot
+ *                      to the target.
+ * @param sourceCnv     Input converter, used to convert from the source to
+ *                      the UTF-16 pivot.
+ * @param target        Pointer to the output buffer.
+ * @param targetCapacity Capacity of the target, in bytes.
+ * @param source        Pointer to the input buffer.
+ * @param sourceLength  Length of the input text, in bytes, or -1 for NUL-terminated input.
+ * @param offsets       If not NULL, then for each output byte, the index of the
+ *                      source byte where the character that produced it starts,
+ *                      or -1 if there is no such source byte (for example for
+ *                      substitution output). Must have room for targetCapacity values.
+ *                      Computing offsets converts each chunk in two passes
+ *                      with ucnv_toUnicode() and ucnv_fromUnicode().
+ * @param chunkLength   The minimum number of source bytes per chunk;
+ *                      0 or negative for a default of 256kB.
+ * @param executor      The executor for all but the first chunk;
+ *                      if NULL, then the text is converted on the calling thread.
+ *                      See UExecutorFn for its requirements.
+ * @param executorContext The context pointer for the executor.
+ * @param pErrorCode    ICU error code in/out parameter.
+ *                      Must fulfill U_SUCCESS before the function call.
+ *                      If the conversion of a chunk fails, for example
+ *                      in a stop callback, then the failure of the earliest
+ *                      such chunk in the text is returned and the target
+ *                      contents are undefined.
+ * @return Length of the complete output text in bytes, even if it exceeds the targetCapacity
+ *         and a U_BUFFER_OVERFLOW_ERROR is set.
+ *
+ * @see ucnv_convertEx
+ * @see ucnv_convert
+ * @see UExecutorFn
+ * @draft ICU 63
+ */
+U_CAPI int32_t U_EXPORT2
+ucnv_convertBulk(UConverter *targetCnv, UConverter *sourceCnv,
+                 char *target, int32_t targetCapacity,
+                 const char *source, int32_t sourceLength,
+                 int32_t *offsets, int32_t chunkLength,
+                 UExecutorFn *executor, const void *executorContext,
+                 UErrorCode *pErrorCode);
+
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Convert from one external charset to another.
  * Internally, the text is converted to and from the 16-bit Unicode "pivot"
@@ -130,6 +130,65 @@ U_NAMESPACE_END
 U_STABLE UConverterSelector* U_EXPORT2
 ucnvsel_openFromSerialized(const void* buffer, int32_t length, UErrorCode* status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Open a selector from a cached serialized form if that was built
+ * with the same parameters from the same converter data;
+ * otherwise build a new selector like ucnvsel_open().
+ *
+ * This supports keeping a selector in a file across process runs.
+ * The cached data is used only if its converter names, excluded code points
+ * and whichSet match the arguments, and if it was built with the same
+ * ICU data version (see u_getDataVersion()).
+ * If the cached data is missing, stale or invalid, then a new selector is built,
+ * and *pIsFromCache is set to FALSE; the caller should then
+ * ucnvsel_serialize() it and replace the cached data.
+ *
+ * \code
+ * UBool isFromCache;
+ * UConverterSelector *sel = ucnvsel_openWithCache(names, count, NULL, UCNV_ROUNDTRIP_SET,
+ *                                                 cacheBytes, cacheLength,
+ *                                                 &isFromCache, &errorCode);
+ * if (U_SUCCESS(errorCode) && !isFromCache) {
+ *     // Serialize sel into a new buffer and write that to the cache file.
+ * }
+ * \endcode
+ *
+ * The cache key does not cover converter data files loaded from outside
+ * the ICU data, nor changes in the set of available converters
+ * that leave the converter names and the data version unchanged.
+ *
+ * @param converterList a pointer to encoding names needed to be involved.
+ *                      Can be NULL if converterListSize==0.
+ * @param converterListSize number of encodings in above list.
+ *                          If 0, uses all available converters.
+ * @param excludedCodePoints a set of code points to be excluded from consideration.
+ *                           Use NULL to exclude nothing.
+ * @param whichSet what converter set to use
+ * @param cache the serialized form of a converter selector, for example
+ *              read from a file; must be 32-bit-aligned.
+ *              Can be NULL if cacheLength==0.
+ *              If it is used, then it must remain valid and unchanged
+ *              for the lifetime of the selector, as with ucnvsel_openFromSerialized().
+ * @param cacheLength the length of the cached data, or 0 if there is none
+ * @param pIsFromCache if not NULL, receives TRUE if the selector was opened
+ *                     from the cached data, and FALSE if it was built
+ * @param status an in/out ICU UErrorCode
+ * @return the new selector
+ *
+ * @see ucnvsel_open
+ * @see ucnvsel_openFromSerialized
+ * @see ucnvsel_serialize
+ * @draft ICU 63
+ */
+U_CAPI UConverterSelector* U_EXPORT2
+ucnvsel_openWithCache(const char* const* converterList, int32_t converterListSize,
+                      const USet* excludedCodePoints,
+                      const UConverterUnicodeSet whichSet,
+                      const void* cache, int32_t cacheLength,
+                      UBool* pIsFromCache, UErrorCode* status);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Serialize a selector into a linear buffer.
  * The serialized form is portable to different machines.
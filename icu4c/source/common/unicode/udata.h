@@ -432,6 +432,69 @@ typedef enum UDataFileAccess {
 U_STABLE void U_EXPORT2
 udata_setFileAccess(UDataFileAccess access, UErrorCode *status);
 
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * Bit flags for udata_setMapPolicy().
+ * They control how ICU loads the data files that it memory-maps itself,
+ * that is, .dat packages and individual data files, but not data that is
+ * linked into a shared library.
+ * Flags that the platform does not support are ignored.
+ * @see udata_setMapPolicy
+ * @draft ICU 63
+ */
+typedef enum UDataMapPolicy {
+    /**
+     * Map files on demand; pages are read on first access. (default)
+     * @draft ICU 63
+     */
+    UDATA_MAP_DEFAULT = 0,
+    /**
+     * Read all pages of a file while mapping it (MAP_POPULATE, MADV_WILLNEED),
+     * so that later accesses do not cause page faults for disk reads.
+     * @draft ICU 63
+     */
+    UDATA_MAP_PREFAULT = 1,
+    /**
+     * Ask the operating system to back the data with huge pages
+     * (MADV_HUGEPAGE), which reduces TLB misses for large packages.
+     * Most effective together with UDATA_MAP_COPY.
+     * @draft ICU 63
+     */
+    UDATA_MAP_HUGE_PAGES = 2,
+    /**
+     * Lock the data into physical memory (mlock) so that it is not paged out.
+     * Silently has no effect if the process lacks the privileges or the
+     * locked-memory limit is exceeded.
+     * @draft ICU 63
+     */
+    UDATA_MAP_LOCK = 4,
+    /**
+     * Read each file into an anonymous, private memory buffer instead of
+     * mapping the file itself. The data is fully loaded while opening,
+     * and the buffer can use huge pages even where file mappings cannot.
+     * The data is not shared with other processes.
+     * @draft ICU 63
+     */
+    UDATA_MAP_COPY = 8
+} UDataMapPolicy;
+
+/**
+ * Sets how ICU maps the data files that it loads, as a bit set of
+ * UDataMapPolicy flags. Data files that are already loaded are not affected.
+ *
+ * Like udata_setFileAccess(), this function should be called before any ICU
+ * data is loaded. It is not multithread safe.
+ * @param policy bit set of UDataMapPolicy values
+ * @param status Error code. Set to U_ILLEGAL_ARGUMENT_ERROR for unknown flags.
+ * @see UDataMapPolicy
+ * @draft ICU 63
+ */
+U_CAPI void U_EXPORT2
+udata_setMapPolicy(uint32_t policy, UErrorCode *status);
+
+#endif  /* U_HIDE_DRAFT_API */
+
 U_CDECL_END
 
 #endif
@@ -0,0 +1,44 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+#ifndef __UEXECUTOR_H__
+#define __UEXECUTOR_H__
+
+#include "unicode/utypes.h"
+
+/**
+ * \file
+ * \brief C API: Caller-supplied executors for running ICU work on other threads.
+ *
+ * ICU does not create threads. Functions that can split their work into
+ * independent tasks take an optional UExecutorFn, through which the caller
+ * hands those tasks to a thread pool of its choice.
+ */
+
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * Function type for one task that ICU submits to an executor.
+ *
+ * @param task the task data that was passed to the UExecutorFn
+ * @see UExecutorFn
+ * @draft ICU 63
+ */
+typedef void U_CALLCONV UTaskFn(void *task);
+
+/**
+ * Function type for a caller-supplied executor.
+ * The executor must arrange for taskFn(task) to be called exactly once,
+ * on any thread, either before returning or later.
+ * It must not call taskFn concurrently with a call to ICU's u_cleanup().
+ *
+ * @param context the executor context pointer that the caller passed to ICU
+ * @param taskFn the function to be called
+ * @param task the argument for taskFn
+ * @draft ICU 63
+ */
+typedef void U_CALLCONV UExecutorFn(const void *context, UTaskFn *taskFn, void *task);
+
+#endif  // U_HIDE_DRAFT_API
+
+#endif  // __UEXECUTOR_H__
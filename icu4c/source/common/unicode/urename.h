@@ -198,6 +198,7 @@
 #define res_getTableItemByKey U_ICU_ENTRY_POINT_RENAME(res_getTableItemByKey)
 #define res_load U_ICU_ENTRY_POINT_RENAME(res_load)
 #define res_read U_ICU_ENTRY_POINT_RENAME(res_read)
+#define res_setUseTableKeyIndex U_ICU_ENTRY_POINT_RENAME(res_setUseTableKeyIndex)
 #define res_unload U_ICU_ENTRY_POINT_RENAME(res_unload)
 #define u_UCharsToChars U_ICU_ENTRY_POINT_RENAME(u_UCharsToChars)
 #define u_austrcpy U_ICU_ENTRY_POINT_RENAME(u_austrcpy)
@@ -399,6 +400,8 @@
 #define u_uastrncpy U_ICU_ENTRY_POINT_RENAME(u_uastrncpy)
 #define u_unescape U_ICU_ENTRY_POINT_RENAME(u_unescape)
 #define u_unescapeAt U_ICU_ENTRY_POINT_RENAME(u_unescapeAt)
+#define u_validateUTF16 U_ICU_ENTRY_POINT_RENAME(u_validateUTF16)
+#define u_validateUTF8 U_ICU_ENTRY_POINT_RENAME(u_validateUTF8)
 #define u_versionFromString U_ICU_ENTRY_POINT_RENAME(u_versionFromString)
 #define u_versionFromUString U_ICU_ENTRY_POINT_RENAME(u_versionFromUString)
 #define u_versionToString U_ICU_ENTRY_POINT_RENAME(u_versionToString)
@@ -501,7 +504,11 @@
 #define ubrk_swap U_ICU_ENTRY_POINT_RENAME(ubrk_swap)
 #define ucache_compareKeys U_ICU_ENTRY_POINT_RENAME(ucache_compareKeys)
 #define ucache_deleteKey U_ICU_ENTRY_POINT_RENAME(ucache_deleteKey)
+#define ucache_getStatistics U_ICU_ENTRY_POINT_RENAME(ucache_getStatistics)
 #define ucache_hashKeys U_ICU_ENTRY_POINT_RENAME(ucache_hashKeys)
+#define ucache_resetStatistics U_ICU_ENTRY_POINT_RENAME(ucache_resetStatistics)
+#define ucache_setEvictionPolicy U_ICU_ENTRY_POINT_RENAME(ucache_setEvictionPolicy)
+#define ucache_setMemoryBudget U_ICU_ENTRY_POINT_RENAME(ucache_setMemoryBudget)
 #define ucal_add U_ICU_ENTRY_POINT_RENAME(ucal_add)
 #define ucal_clear U_ICU_ENTRY_POINT_RENAME(ucal_clear)
 #define ucal_clearField U_ICU_ENTRY_POINT_RENAME(ucal_clearField)
@@ -596,6 +603,7 @@
 #define ucnv_MBCSIsLeadByte U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSIsLeadByte)
 #define ucnv_MBCSSimpleGetNextUChar U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSSimpleGetNextUChar)
 #define ucnv_MBCSToUnicodeWithOffsets U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSToUnicodeWithOffsets)
+#define ucnv_acquireFromPool U_ICU_ENTRY_POINT_RENAME(ucnv_acquireFromPool)
 #define ucnv_bld_countAvailableConverters U_ICU_ENTRY_POINT_RENAME(ucnv_bld_countAvailableConverters)
 #define ucnv_bld_getAvailableConverter U_ICU_ENTRY_POINT_RENAME(ucnv_bld_getAvailableConverter)
 #define ucnv_canCreateConverter U_ICU_ENTRY_POINT_RENAME(ucnv_canCreateConverter)
@@ -605,8 +613,10 @@
 #define ucnv_cbToUWriteSub U_ICU_ENTRY_POINT_RENAME(ucnv_cbToUWriteSub)
 #define ucnv_cbToUWriteUChars U_ICU_ENTRY_POINT_RENAME(ucnv_cbToUWriteUChars)
 #define ucnv_close U_ICU_ENTRY_POINT_RENAME(ucnv_close)
+#define ucnv_closePool U_ICU_ENTRY_POINT_RENAME(ucnv_closePool)
 #define ucnv_compareNames U_ICU_ENTRY_POINT_RENAME(ucnv_compareNames)
 #define ucnv_convert U_ICU_ENTRY_POINT_RENAME(ucnv_convert)
+#define ucnv_convertBulk U_ICU_ENTRY_POINT_RENAME(ucnv_convertBulk)
 #define ucnv_convertEx U_ICU_ENTRY_POINT_RENAME(ucnv_convertEx)
 #define ucnv_countAliases U_ICU_ENTRY_POINT_RENAME(ucnv_countAliases)
 #define ucnv_countAvailable U_ICU_ENTRY_POINT_RENAME(ucnv_countAvailable)
@@ -660,6 +670,7 @@
 #define ucnv_incrementRefCount U_ICU_ENTRY_POINT_RENAME(ucnv_incrementRefCount)
 #define ucnv_io_countKnownConverters U_ICU_ENTRY_POINT_RENAME(ucnv_io_countKnownConverters)
 #define ucnv_io_getConverterName U_ICU_ENTRY_POINT_RENAME(ucnv_io_getConverterName)
+#define ucnv_io_hashNormalizedName U_ICU_ENTRY_POINT_RENAME(ucnv_io_hashNormalizedName)
 #define ucnv_io_stripASCIIForCompare U_ICU_ENTRY_POINT_RENAME(ucnv_io_stripASCIIForCompare)
 #define ucnv_io_stripEBCDICForCompare U_ICU_ENTRY_POINT_RENAME(ucnv_io_stripEBCDICForCompare)
 #define ucnv_isAmbiguous U_ICU_ENTRY_POINT_RENAME(ucnv_isAmbiguous)
@@ -670,8 +681,10 @@
 #define ucnv_openAllNames U_ICU_ENTRY_POINT_RENAME(ucnv_openAllNames)
 #define ucnv_openCCSID U_ICU_ENTRY_POINT_RENAME(ucnv_openCCSID)
 #define ucnv_openPackage U_ICU_ENTRY_POINT_RENAME(ucnv_openPackage)
+#define ucnv_openPool U_ICU_ENTRY_POINT_RENAME(ucnv_openPool)
 #define ucnv_openStandardNames U_ICU_ENTRY_POINT_RENAME(ucnv_openStandardNames)
 #define ucnv_openU U_ICU_ENTRY_POINT_RENAME(ucnv_openU)
+#define ucnv_releaseToPool U_ICU_ENTRY_POINT_RENAME(ucnv_releaseToPool)
 #define ucnv_reset U_ICU_ENTRY_POINT_RENAME(ucnv_reset)
 #define ucnv_resetFromUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_resetFromUnicode)
 #define ucnv_resetToUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_resetToUnicode)
@@ -696,6 +709,7 @@
 #define ucnvsel_close U_ICU_ENTRY_POINT_RENAME(ucnvsel_close)
 #define ucnvsel_open U_ICU_ENTRY_POINT_RENAME(ucnvsel_open)
 #define ucnvsel_openFromSerialized U_ICU_ENTRY_POINT_RENAME(ucnvsel_openFromSerialized)
+#define ucnvsel_openWithCache U_ICU_ENTRY_POINT_RENAME(ucnvsel_openWithCache)
 #define ucnvsel_selectForString U_ICU_ENTRY_POINT_RENAME(ucnvsel_selectForString)
 #define ucnvsel_selectForUTF8 U_ICU_ENTRY_POINT_RENAME(ucnvsel_selectForUTF8)
 #define ucnvsel_serialize U_ICU_ENTRY_POINT_RENAME(ucnvsel_serialize)
@@ -835,6 +849,7 @@
 #define udat_toPatternRelativeTime U_ICU_ENTRY_POINT_RENAME(udat_toPatternRelativeTime)
 #define udat_unregisterOpener U_ICU_ENTRY_POINT_RENAME(udat_unregisterOpener)
 #define udata_checkCommonData U_ICU_ENTRY_POINT_RENAME(udata_checkCommonData)
+#define udata_checksumTOC U_ICU_ENTRY_POINT_RENAME(udata_checksumTOC)
 #define udata_close U_ICU_ENTRY_POINT_RENAME(udata_close)
 #define udata_closeSwapper U_ICU_ENTRY_POINT_RENAME(udata_closeSwapper)
 #define udata_getHeaderSize U_ICU_ENTRY_POINT_RENAME(udata_getHeaderSize)
@@ -843,6 +858,7 @@
 #define udata_getLength U_ICU_ENTRY_POINT_RENAME(udata_getLength)
 #define udata_getMemory U_ICU_ENTRY_POINT_RENAME(udata_getMemory)
 #define udata_getRawMemory U_ICU_ENTRY_POINT_RENAME(udata_getRawMemory)
+#define udata_hashTOCName U_ICU_ENTRY_POINT_RENAME(udata_hashTOCName)
 #define udata_open U_ICU_ENTRY_POINT_RENAME(udata_open)
 #define udata_openChoice U_ICU_ENTRY_POINT_RENAME(udata_openChoice)
 #define udata_openSwapper U_ICU_ENTRY_POINT_RENAME(udata_openSwapper)
@@ -853,6 +869,7 @@
 #define udata_setAppData U_ICU_ENTRY_POINT_RENAME(udata_setAppData)
 #define udata_setCommonData U_ICU_ENTRY_POINT_RENAME(udata_setCommonData)
 #define udata_setFileAccess U_ICU_ENTRY_POINT_RENAME(udata_setFileAccess)
+#define udata_setMapPolicy U_ICU_ENTRY_POINT_RENAME(udata_setMapPolicy)
 #define udata_swapDataHeader U_ICU_ENTRY_POINT_RENAME(udata_swapDataHeader)
 #define udata_swapInvStringBlock U_ICU_ENTRY_POINT_RENAME(udata_swapInvStringBlock)
 #define udatpg_addPattern U_ICU_ENTRY_POINT_RENAME(udatpg_addPattern)
@@ -1221,6 +1238,7 @@
 #define uplug_setPlugLevel U_ICU_ENTRY_POINT_RENAME(uplug_setPlugLevel)
 #define uplug_setPlugName U_ICU_ENTRY_POINT_RENAME(uplug_setPlugName)
 #define uplug_setPlugNoUnload U_ICU_ENTRY_POINT_RENAME(uplug_setPlugNoUnload)
+#define upreload_preloadLocales U_ICU_ENTRY_POINT_RENAME(upreload_preloadLocales)
 #define uprops_getSource U_ICU_ENTRY_POINT_RENAME(uprops_getSource)
 #define upropsvec_addPropertyStarts U_ICU_ENTRY_POINT_RENAME(upropsvec_addPropertyStarts)
 #define uprv_add32_overflow U_ICU_ENTRY_POINT_RENAME(uprv_add32_overflow)
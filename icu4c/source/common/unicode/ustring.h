@@ -1446,6 +1446,45 @@ u_strFromUTF8Lenient(UChar *dest,
                      int32_t srcLength,
                      UErrorCode *pErrorCode);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Checks whether a string is well-formed UTF-8, without converting it.
+ * Uses the same definition of well-formed UTF-8 as u_strFromUTF8():
+ * No surrogate code points, no non-shortest forms, nothing above U+10FFFF.
+ *
+ * @param s             The UTF-8 string
+ * @param length        The length of the string. If -1, then s must be zero-terminated.
+ * @param pErrorIndex   If not NULL, receives the index of the first byte
+ *                      of the first ill-formed sequence, or -1 if the string is well-formed.
+ * @param pErrorCode    Must be a valid pointer to an error code value,
+ *                      which must not indicate a failure before the function call.
+ *                      An ill-formed string is not a failure.
+ * @return TRUE if the string is well-formed UTF-8
+ * @see u_validateUTF16
+ * @draft ICU 63
+ */
+U_CAPI UBool U_EXPORT2
+u_validateUTF8(const char *s, int32_t length, int32_t *pErrorIndex, UErrorCode *pErrorCode);
+
+/**
+ * Checks whether a string is well-formed UTF-16, that is,
+ * whether every surrogate code unit is part of a surrogate pair.
+ *
+ * @param s             The UTF-16 string
+ * @param length        The length of the string. If -1, then s must be zero-terminated.
+ * @param pErrorIndex   If not NULL, receives the index of the first unpaired
+ *                      surrogate, or -1 if the string is well-formed.
+ * @param pErrorCode    Must be a valid pointer to an error code value,
+ *                      which must not indicate a failure before the function call.
+ *                      An ill-formed string is not a failure.
+ * @return TRUE if the string is well-formed UTF-16
+ * @see u_validateUTF8
+ * @draft ICU 63
+ */
+U_CAPI UBool U_EXPORT2
+u_validateUTF16(const UChar *s, int32_t length, int32_t *pErrorIndex, UErrorCode *pErrorCode);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Convert a UTF-16 string to UTF-32.
  * If the input string is not well-formed, then the U_INVALID_CHAR_FOUND error code is set.
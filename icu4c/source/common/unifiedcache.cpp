@@ -14,17 +14,33 @@
 
 #include <algorithm>      // For std::max()
 
+#include "cmemory.h"
 #include "mutex.h"
+#include "putilimp.h"
+#include "uarrsort.h"
 #include "uassert.h"
 #include "uhash.h"
 #include "ucln_cmn.h"
 #include "umutex.h"
 
 static icu::UnifiedCache *gCache = NULL;
-static UMutex gCacheMutex = U_MUTEX_INITIALIZER;
-static UConditionVar gInProgressValueAddedCond = U_CONDITION_INITIALIZER;
 static icu::UInitOnce gCacheInitOnce = U_INITONCE_INITIALIZER;
 
+// One mutex and one condition variable per shard. All UnifiedCache instances
+// share these, just as they used to share a single global cache mutex.
+static UMutex gCacheMutex[icu::UnifiedCache::SHARD_COUNT] = {
+        U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER,
+        U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER,
+        U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER,
+        U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER
+};
+static UConditionVar gInProgressValueAddedCond[icu::UnifiedCache::SHARD_COUNT] = {
+        U_CONDITION_INITIALIZER, U_CONDITION_INITIALIZER, U_CONDITION_INITIALIZER, U_CONDITION_INITIALIZER,
+        U_CONDITION_INITIALIZER, U_CONDITION_INITIALIZER, U_CONDITION_INITIALIZER, U_CONDITION_INITIALIZER,
+        U_CONDITION_INITIALIZER, U_CONDITION_INITIALIZER, U_CONDITION_INITIALIZER, U_CONDITION_INITIALIZER,
+        U_CONDITION_INITIALIZER, U_CONDITION_INITIALIZER, U_CONDITION_INITIALIZER, U_CONDITION_INITIALIZER
+};
+
 static const int32_t MAX_EVICT_ITERATIONS = 10;
 static const int32_t DEFAULT_MAX_UNUSED = 1000;
 static const int32_t DEFAULT_PERCENTAGE_OF_IN_USE = 100;
@@ -92,14 +108,23 @@ UnifiedCache *UnifiedCache::getInstance(UErrorCode &status) {
 }
 
 UnifiedCache::UnifiedCache(UErrorCode &status) :
-        fHashtable(NULL),
-        fEvictPos(UHASH_FIRST),
+        fEvictShard(0),
+        fNumKeys(0),
         fNumValuesTotal(0),
         fNumValuesInUse(0),
         fMaxUnused(DEFAULT_MAX_UNUSED),
         fMaxPercentageOfInUse(DEFAULT_PERCENTAGE_OF_IN_USE),
-        fAutoEvictedCount(0),
+        fBytesRetained(0),
+        fMaxBytes(0),
         fNoValue(nullptr) {
+    static_assert((SHARD_COUNT & (SHARD_COUNT - 1)) == 0,
+                  "SHARD_COUNT must be a power of 2");
+    for (int32_t shard = 0; shard < SHARD_COUNT; ++shard) {
+        fHashtables[shard] = nullptr;
+        fStatistics[shard] = nullptr;
+        fEvictPos[shard] = UHASH_FIRST;
+        fAutoEvictedCount[shard] = 0;
+    }
     if (U_FAILURE(status)) {
         return;
     }
@@ -108,19 +133,61 @@ UnifiedCache::UnifiedCache(UErrorCode &status) :
         status = U_MEMORY_ALLOCATION_ERROR;
         return;
     }
-    fNoValue->softRefCount = 1;  // Add fake references to prevent fNoValue from being deleted
-    fNoValue->hardRefCount = 1;  // when other references to it are removed.
+    umtx_storeRelease(fNoValue->softRefCount, 1);  // Add fake references to prevent fNoValue from being deleted
+    umtx_storeRelease(fNoValue->hardRefCount, 1);  // when other references to it are removed.
     fNoValue->cachePtr = this;
 
-    fHashtable = uhash_open(
-            &ucache_hashKeys,
-            &ucache_compareKeys,
-            NULL,
-            &status);
+    for (int32_t shard = 0; shard < SHARD_COUNT; ++shard) {
+        fHashtables[shard] = uhash_open(
+                &ucache_hashKeys,
+                &ucache_compareKeys,
+                NULL,
+                &status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        uhash_setKeyDeleter(fHashtables[shard], &ucache_deleteKey);
+        fStatistics[shard] = uhash_open(
+                uhash_hashChars,
+                uhash_compareChars,
+                NULL,
+                &status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        uhash_setValueDeleter(fStatistics[shard], uprv_free);
+    }
+}
+
+int32_t UnifiedCache::_shardOf(const CacheKeyBase &key) {
+    // Fold the high bits in so that keys differing only there still spread.
+    uint32_t hash = (uint32_t) key.hashCode();
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return (int32_t) (hash & (SHARD_COUNT - 1));
+}
+
+UCacheStatistics *
+UnifiedCache::_statisticsFor(int32_t shard, const CacheKeyBase &key) const {
+    const char *typeName = key.getTypeName();
+    UCacheStatistics *stats =
+            static_cast<UCacheStatistics *>(uhash_get(fStatistics[shard], typeName));
+    if (stats != nullptr) {
+        return stats;
+    }
+    stats = static_cast<UCacheStatistics *>(uprv_malloc(sizeof(UCacheStatistics)));
+    if (stats == nullptr) {
+        return nullptr;
+    }
+    uprv_memset(stats, 0, sizeof(UCacheStatistics));
+    stats->keyType = typeName;
+    UErrorCode status = U_ZERO_ERROR;
+    uhash_put(fStatistics[shard], const_cast<char *>(typeName), stats, &status);
     if (U_FAILURE(status)) {
-        return;
+        // uhash_put() deleted stats.
+        return nullptr;
     }
-    uhash_setKeyDeleter(fHashtable, &ucache_deleteKey);
+    return stats;
 }
 
 void UnifiedCache::setEvictionPolicy(
@@ -132,38 +199,152 @@ void UnifiedCache::setEvictionPolicy(
         status = U_ILLEGAL_ARGUMENT_ERROR;
         return;
     }
-    Mutex lock(&gCacheMutex);
-    fMaxUnused = count;
-    fMaxPercentageOfInUse = percentageOfInUseItems;
+    umtx_storeRelease(fMaxUnused, count);
+    umtx_storeRelease(fMaxPercentageOfInUse, percentageOfInUseItems);
+}
+
+void UnifiedCache::setMemoryBudget(int32_t maxBytes, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (maxBytes < 0) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    umtx_storeRelease(fMaxBytes, maxBytes);
+}
+
+int32_t UnifiedCache::bytesRetained() const {
+    return umtx_loadAcquire(fBytesRetained);
 }
 
 int32_t UnifiedCache::unusedCount() const {
-    Mutex lock(&gCacheMutex);
-    return uhash_count(fHashtable) - fNumValuesInUse;
+    return umtx_loadAcquire(fNumKeys) - umtx_loadAcquire(fNumValuesInUse);
 }
 
 int64_t UnifiedCache::autoEvictedCount() const {
-    Mutex lock(&gCacheMutex);
-    return fAutoEvictedCount;
+    int64_t result = 0;
+    for (int32_t shard = 0; shard < SHARD_COUNT; ++shard) {
+        Mutex lock(&gCacheMutex[shard]);
+        result += fAutoEvictedCount[shard];
+    }
+    return result;
 }
 
 int32_t UnifiedCache::keyCount() const {
-    Mutex lock(&gCacheMutex);
-    return uhash_count(fHashtable);
+    return umtx_loadAcquire(fNumKeys);
 }
 
-void UnifiedCache::flush() const {
-    Mutex lock(&gCacheMutex);
+U_CDECL_BEGIN
+static int32_t U_CALLCONV
+compareStatistics(const void * /*context*/, const void *left, const void *right) {
+    return uprv_strcmp(
+            static_cast<const UCacheStatistics *>(left)->keyType,
+            static_cast<const UCacheStatistics *>(right)->keyType);
+}
+U_CDECL_END
 
+int32_t UnifiedCache::getStatistics(
+        UCacheStatistics *dest, int32_t destCapacity, UErrorCode &status) const {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (destCapacity < 0 || (dest == NULL && destCapacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    // Merge the per-shard records. There are only a few dozen value types,
+    // so a linear search is fine.
+    MaybeStackArray<UCacheStatistics, 32> merged;
+    int32_t length = 0;
+    for (int32_t shard = 0; shard < SHARD_COUNT; ++shard) {
+        Mutex lock(&gCacheMutex[shard]);
+        int32_t pos = UHASH_FIRST;
+        const UHashElement *element;
+        // Make sure that every type with entries has a record.
+        while ((element = uhash_nextElement(fHashtables[shard], &pos)) != NULL) {
+            _statisticsFor(shard, *(const CacheKeyBase *) element->key.pointer);
+        }
+        pos = UHASH_FIRST;
+        while ((element = uhash_nextElement(fStatistics[shard], &pos)) != NULL) {
+            const UCacheStatistics *stats = (const UCacheStatistics *) element->value.pointer;
+            int32_t i = 0;
+            while (i < length && uprv_strcmp(merged[i].keyType, stats->keyType) != 0) {
+                ++i;
+            }
+            if (i == length) {
+                if (length == merged.getCapacity() &&
+                        merged.resize(2 * length, length) == NULL) {
+                    status = U_MEMORY_ALLOCATION_ERROR;
+                    return 0;
+                }
+                uprv_memset(&merged[i], 0, sizeof(UCacheStatistics));
+                merged[i].keyType = stats->keyType;
+                ++length;
+            }
+            merged[i].hitCount += stats->hitCount;
+            merged[i].missCount += stats->missCount;
+            merged[i].creationMillis += stats->creationMillis;
+            merged[i].evictionCount += stats->evictionCount;
+        }
+        pos = UHASH_FIRST;
+        while ((element = uhash_nextElement(fHashtables[shard], &pos)) != NULL) {
+            const CacheKeyBase *theKey = (const CacheKeyBase *) element->key.pointer;
+            int32_t i = 0;
+            while (i < length && uprv_strcmp(merged[i].keyType, theKey->getTypeName()) != 0) {
+                ++i;
+            }
+            if (i == length) {
+                continue;  // No statistics record; out of memory earlier.
+            }
+            ++merged[i].entryCount;
+            // Values shared by several keys are counted once, with their master key,
+            // with the footprint recorded for the cache's retained bytes.
+            if (theKey->fIsMaster) {
+                merged[i].bytesRetained += theKey->fFootprint;
+            }
+        }
+    }
+    uprv_sortArray(merged.getAlias(), length, sizeof(UCacheStatistics),
+                   compareStatistics, NULL, FALSE, &status);
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (length > destCapacity) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+    }
+    if (destCapacity > 0) {
+        uprv_memcpy(dest, merged.getAlias(),
+                    std::min(length, destCapacity) * sizeof(UCacheStatistics));
+    }
+    return length;
+}
+
+void UnifiedCache::resetStatistics() const {
+    for (int32_t shard = 0; shard < SHARD_COUNT; ++shard) {
+        Mutex lock(&gCacheMutex[shard]);
+        uhash_removeAll(fStatistics[shard]);
+    }
+}
+
+void UnifiedCache::flush() const {
     // Use a loop in case cache items that are flushed held hard references to
     // other cache items making those additional cache items eligible for
-    // flushing.
-    while (_flush(FALSE));
+    // flushing. Those items may live in any shard.
+    UBool flushed;
+    do {
+        flushed = FALSE;
+        for (int32_t shard = 0; shard < SHARD_COUNT; ++shard) {
+            Mutex lock(&gCacheMutex[shard]);
+            while (_flush(shard, FALSE)) {
+                flushed = TRUE;
+            }
+        }
+    } while (flushed);
 }
 
 void UnifiedCache::handleUnreferencedObject() const {
-    Mutex lock(&gCacheMutex);
-    --fNumValuesInUse;
+    umtx_atomic_dec(&fNumValuesInUse);
     _runEvictionSlice();
 }
 
@@ -181,19 +362,21 @@ void UnifiedCache::dump() {
 }
 
 void UnifiedCache::dumpContents() const {
-    Mutex lock(&gCacheMutex);
-    _dumpContents();
+    for (int32_t shard = 0; shard < SHARD_COUNT; ++shard) {
+        Mutex lock(&gCacheMutex[shard]);
+        _dumpContents(shard);
+    }
 }
 
-// Dumps content of cache.
-// On entry, gCacheMutex must be held.
-// On exit, cache contents dumped to stderr.
-void UnifiedCache::_dumpContents() const {
+// Dumps content of one shard of the cache.
+// On entry, the mutex of the shard must be held.
+// On exit, shard contents dumped to stderr.
+void UnifiedCache::_dumpContents(int32_t shard) const {
     int32_t pos = UHASH_FIRST;
-    const UHashElement *element = uhash_nextElement(fHashtable, &pos);
+    const UHashElement *element = uhash_nextElement(fHashtables[shard], &pos);
     char buffer[256];
     int32_t cnt = 0;
-    for (; element != NULL; element = uhash_nextElement(fHashtable, &pos)) {
+    for (; element != NULL; element = uhash_nextElement(fHashtables[shard], &pos)) {
         const SharedObject *sharedObject =
                 (const SharedObject *) element->value.pointer;
         const CacheKeyBase *key =
@@ -210,50 +393,56 @@ void UnifiedCache::_dumpContents() const {
                     sharedObject->getSoftRefCount());
         }
     }
-    fprintf(stderr, "Unified Cache: %d out of a total of %d still have hard references\n", cnt, uhash_count(fHashtable));
+    fprintf(stderr, "Unified Cache: shard %d: %d out of a total of %d still have hard references\n",
+            shard, cnt, uhash_count(fHashtables[shard]));
 }
 #endif
 
 UnifiedCache::~UnifiedCache() {
     // Try our best to clean up first.
     flush();
-    {
-        // Now all that should be left in the cache are entries that refer to
-        // each other and entries with hard references from outside the cache.
-        // Nothing we can do about these so proceed to wipe out the cache.
-        Mutex lock(&gCacheMutex);
-        _flush(TRUE);
-    }
-    uhash_close(fHashtable);
-    fHashtable = nullptr;
+    for (int32_t shard = 0; shard < SHARD_COUNT; ++shard) {
+        {
+            // Now all that should be left in the cache are entries that refer to
+            // each other and entries with hard references from outside the cache.
+            // Nothing we can do about these so proceed to wipe out the cache.
+            Mutex lock(&gCacheMutex[shard]);
+            _flush(shard, TRUE);
+        }
+        uhash_close(fHashtables[shard]);
+        fHashtables[shard] = nullptr;
+        uhash_close(fStatistics[shard]);
+        fStatistics[shard] = nullptr;
+    }
     delete fNoValue;
     fNoValue = nullptr;
 }
 
 const UHashElement *
-UnifiedCache::_nextElement() const {
-    const UHashElement *element = uhash_nextElement(fHashtable, &fEvictPos);
+UnifiedCache::_nextElement(int32_t shard) const {
+    UHashtable *hashtable = fHashtables[shard];
+    const UHashElement *element = uhash_nextElement(hashtable, &fEvictPos[shard]);
     if (element == NULL) {
-        fEvictPos = UHASH_FIRST;
-        return uhash_nextElement(fHashtable, &fEvictPos);
+        fEvictPos[shard] = UHASH_FIRST;
+        return uhash_nextElement(hashtable, &fEvictPos[shard]);
     }
     return element;
 }
 
-UBool UnifiedCache::_flush(UBool all) const {
+UBool UnifiedCache::_flush(int32_t shard, UBool all) const {
     UBool result = FALSE;
-    int32_t origSize = uhash_count(fHashtable);
+    if (fHashtables[shard] == nullptr) {
+        return result;
+    }
+    int32_t origSize = uhash_count(fHashtables[shard]);
     for (int32_t i = 0; i < origSize; ++i) {
-        const UHashElement *element = _nextElement();
+        const UHashElement *element = _nextElement(shard);
         if (element == nullptr) {
             break;
         }
         if (all || _isEvictable(element)) {
-            const SharedObject *sharedObject =
-                    (const SharedObject *) element->value.pointer;
-            U_ASSERT(sharedObject->cachePtr == this);
-            uhash_removeElement(fHashtable, element);
-            removeSoftRef(sharedObject);    // Deletes the sharedObject when softRefCount goes to zero.
+            U_ASSERT(((const SharedObject *) element->value.pointer)->cachePtr == this);
+            _removeElement(shard, element);
             result = TRUE;
         }
     }
@@ -261,39 +450,79 @@ UBool UnifiedCache::_flush(UBool all) const {
 }
 
 int32_t UnifiedCache::_computeCountOfItemsToEvict() const {
-    int32_t totalItems = uhash_count(fHashtable);
-    int32_t evictableItems = totalItems - fNumValuesInUse;
+    int32_t totalItems = umtx_loadAcquire(fNumKeys);
+    int32_t numValuesInUse = umtx_loadAcquire(fNumValuesInUse);
+    int32_t evictableItems = totalItems - numValuesInUse;
 
-    int32_t unusedLimitByPercentage = fNumValuesInUse * fMaxPercentageOfInUse / 100;
-    int32_t unusedLimit = std::max(unusedLimitByPercentage, fMaxUnused);
+    int32_t unusedLimitByPercentage =
+            numValuesInUse * umtx_loadAcquire(fMaxPercentageOfInUse) / 100;
+    int32_t unusedLimit = std::max(unusedLimitByPercentage, umtx_loadAcquire(fMaxUnused));
     int32_t countOfItemsToEvict = std::max(0, evictableItems - unusedLimit);
     return countOfItemsToEvict;
 }
 
+UBool UnifiedCache::_isOverBudget() const {
+    int32_t maxBytes = umtx_loadAcquire(fMaxBytes);
+    return maxBytes > 0 && umtx_loadAcquire(fBytesRetained) > maxBytes;
+}
+
+void UnifiedCache::_removeElement(int32_t shard, const UHashElement *element) const {
+    const CacheKeyBase *theKey = (const CacheKeyBase *) element->key.pointer;
+    const SharedObject *sharedObject = (const SharedObject *) element->value.pointer;
+    if (theKey->fIsMaster) {
+        umtx_atomic_add(&fBytesRetained, -theKey->fFootprint);
+    }
+    uhash_removeElement(fHashtables[shard], element);  // Deletes theKey.
+    umtx_atomic_dec(&fNumKeys);
+    removeSoftRef(sharedObject);    // Deletes the sharedObject when softRefCount goes to zero.
+}
+
 void UnifiedCache::_runEvictionSlice() const {
     int32_t maxItemsToEvict = _computeCountOfItemsToEvict();
-    if (maxItemsToEvict <= 0) {
+    UBool useClock = umtx_loadAcquire(fMaxBytes) > 0;
+    if (maxItemsToEvict <= 0 && !_isOverBudget()) {
         return;
     }
-    for (int32_t i = 0; i < MAX_EVICT_ITERATIONS; ++i) {
-        const UHashElement *element = _nextElement();
-        if (element == nullptr) {
-            break;
-        }
-        if (_isEvictable(element)) {
-            const SharedObject *sharedObject =
-                    (const SharedObject *) element->value.pointer;
-            uhash_removeElement(fHashtable, element);
-            removeSoftRef(sharedObject);   // Deletes sharedObject when SoftRefCount goes to zero.
-            ++fAutoEvictedCount;
-            if (--maxItemsToEvict == 0) {
+    int32_t iterationsLeft = MAX_EVICT_ITERATIONS;
+    for (int32_t visited = 0; visited < SHARD_COUNT; ++visited) {
+        // Races on fEvictShard only affect which shard is swept next.
+        int32_t shard = umtx_loadAcquire(fEvictShard) & (SHARD_COUNT - 1);
+        Mutex lock(&gCacheMutex[shard]);
+        int32_t count = std::min(iterationsLeft, uhash_count(fHashtables[shard]));
+        for (int32_t i = 0; i < count; ++i) {
+            const UHashElement *element = _nextElement(shard);
+            if (element == nullptr) {
                 break;
             }
+            --iterationsLeft;
+            if (_isEvictable(element)) {
+                const CacheKeyBase *theKey = (const CacheKeyBase *) element->key.pointer;
+                if (useClock && theKey->fRecentlyUsed) {
+                    // Second chance.
+                    theKey->fRecentlyUsed = FALSE;
+                    continue;
+                }
+                UCacheStatistics *stats = _statisticsFor(shard, *theKey);
+                if (stats != nullptr) {
+                    ++stats->evictionCount;
+                }
+                _removeElement(shard, element);
+                ++fAutoEvictedCount[shard];
+                if (--maxItemsToEvict <= 0 && !_isOverBudget()) {
+                    return;
+                }
+            }
+        }
+        if (iterationsLeft == 0) {
+            // Resume with this shard in the next slice.
+            return;
         }
+        umtx_storeRelease(fEvictShard, (shard + 1) & (SHARD_COUNT - 1));
     }
 }
 
 void UnifiedCache::_putNew(
+        int32_t shard,
         const CacheKeyBase &key,
         const SharedObject *value,
         const UErrorCode creationStatus,
@@ -307,68 +536,89 @@ void UnifiedCache::_putNew(
         return;
     }
     keyToAdopt->fCreationStatus = creationStatus;
-    if (value->softRefCount == 0) {
+    if (umtx_loadAcquire(value->softRefCount) == 0) {
         _registerMaster(keyToAdopt, value);
     }
-    void *oldValue = uhash_put(fHashtable, keyToAdopt, (void *) value, &status);
+    void *oldValue = uhash_put(fHashtables[shard], keyToAdopt, (void *) value, &status);
     U_ASSERT(oldValue == nullptr);
     (void)oldValue;
     if (U_SUCCESS(status)) {
-        value->softRefCount++;
+        umtx_atomic_inc(&fNumKeys);
+        umtx_atomic_inc(&value->softRefCount);
     }
 }
 
 void UnifiedCache::_putIfAbsentAndGet(
+        int32_t shard,
         const CacheKeyBase &key,
         const SharedObject *&value,
+        double creationMillis,
         UErrorCode &status) const {
-    Mutex lock(&gCacheMutex);
-    const UHashElement *element = uhash_find(fHashtable, &key);
-    if (element != NULL && !_inProgress(element)) {
-        _fetch(element, value, status);
-        return;
-    }
-    if (element == NULL) {
-        UErrorCode putError = U_ZERO_ERROR;
-        // best-effort basis only.
-        _putNew(key, value, status, putError);
-    } else {
-        _put(element, value, status);
+    {
+        Mutex lock(&gCacheMutex[shard]);
+        UCacheStatistics *stats = _statisticsFor(shard, key);
+        if (stats != nullptr) {
+            stats->creationMillis += creationMillis;
+        }
+        const UHashElement *element = uhash_find(fHashtables[shard], &key);
+        if (element != NULL && !_inProgress(element)) {
+            _fetch(element, value, status);
+            return;
+        }
+        if (element == NULL) {
+            UErrorCode putError = U_ZERO_ERROR;
+            // best-effort basis only.
+            _putNew(shard, key, value, status, putError);
+        } else {
+            _put(shard, element, value, status);
+        }
     }
     // Run an eviction slice. This will run even if we added a master entry
     // which doesn't increase the unused count, but that is still o.k
+    // The slice locks shards one at a time, so our shard lock must be released.
     _runEvictionSlice();
 }
 
 
 UBool UnifiedCache::_poll(
+        int32_t shard,
         const CacheKeyBase &key,
         const SharedObject *&value,
         UErrorCode &status) const {
     U_ASSERT(value == NULL);
     U_ASSERT(status == U_ZERO_ERROR);
-    Mutex lock(&gCacheMutex);
-    const UHashElement *element = uhash_find(fHashtable, &key);
+    Mutex lock(&gCacheMutex[shard]);
+    const UHashElement *element = uhash_find(fHashtables[shard], &key);
 
     // If the hash table contains an inProgress placeholder entry for this key,
     // this means that another thread is currently constructing the value object.
     // Loop, waiting for that construction to complete.
      while (element != NULL && _inProgress(element)) {
-        umtx_condWait(&gInProgressValueAddedCond, &gCacheMutex);
-        element = uhash_find(fHashtable, &key);
+        umtx_condWait(&gInProgressValueAddedCond[shard], &gCacheMutex[shard]);
+        element = uhash_find(fHashtables[shard], &key);
     }
 
+    UCacheStatistics *stats = _statisticsFor(shard, key);
+
     // If the hash table contains an entry for the key,
     // fetch out the contents and return them.
     if (element != NULL) {
+        if (stats != nullptr) {
+            ++stats->hitCount;
+        }
+        ((const CacheKeyBase *) element->key.pointer)->fRecentlyUsed = TRUE;
          _fetch(element, value, status);
         return TRUE;
     }
 
+    if (stats != nullptr) {
+        ++stats->missCount;
+    }
+
     // The hash table contained nothing for this key.
     // Insert an inProgress place holder value.
     // Our caller will create the final value and update the hash table.
-    _putNew(key, fNoValue, U_ZERO_ERROR, status);
+    _putNew(shard, key, fNoValue, U_ZERO_ERROR, status);
     return FALSE;
 }
 
@@ -379,7 +629,8 @@ void UnifiedCache::_get(
         UErrorCode &status) const {
     U_ASSERT(value == NULL);
     U_ASSERT(status == U_ZERO_ERROR);
-    if (_poll(key, value, status)) {
+    int32_t shard = _shardOf(key);
+    if (_poll(shard, key, value, status)) {
         if (value == fNoValue) {
             SharedObject::clearPtr(value);
         }
@@ -388,13 +639,15 @@ void UnifiedCache::_get(
     if (U_FAILURE(status)) {
         return;
     }
+    UDate start = uprv_getUTCtime();
     value = key.createObject(creationContext, status);
+    double creationMillis = uprv_getUTCtime() - start;
     U_ASSERT(value == NULL || value->hasHardReferences());
     U_ASSERT(value != NULL || status != U_ZERO_ERROR);
     if (value == NULL) {
         SharedObject::copyPtr(fNoValue, value);
     }
-    _putIfAbsentAndGet(key, value, status);
+    _putIfAbsentAndGet(shard, key, value, creationMillis, status);
     if (value == fNoValue) {
         SharedObject::clearPtr(value);
     }
@@ -403,12 +656,15 @@ void UnifiedCache::_get(
 void UnifiedCache::_registerMaster(
             const CacheKeyBase *theKey, const SharedObject *value) const {
     theKey->fIsMaster = true;
+    theKey->fFootprint = value->getMemoryFootprint();
+    umtx_atomic_add(&fBytesRetained, theKey->fFootprint);
     value->cachePtr = this;
-    ++fNumValuesTotal;
-    ++fNumValuesInUse;
+    umtx_atomic_inc(&fNumValuesTotal);
+    umtx_atomic_inc(&fNumValuesInUse);
 }
 
 void UnifiedCache::_put(
+        int32_t shard,
         const UHashElement *element,
         const SharedObject *value,
         const UErrorCode status) const {
@@ -416,10 +672,10 @@ void UnifiedCache::_put(
     const CacheKeyBase *theKey = (const CacheKeyBase *) element->key.pointer;
     const SharedObject *oldValue = (const SharedObject *) element->value.pointer;
     theKey->fCreationStatus = status;
-    if (value->softRefCount == 0) {
+    if (umtx_loadAcquire(value->softRefCount) == 0) {
         _registerMaster(theKey, value);
     }
-    value->softRefCount++;
+    umtx_atomic_inc(&value->softRefCount);
     UHashElement *ptr = const_cast<UHashElement *>(element);
     ptr->value.pointer = (void *) value;
     U_ASSERT(oldValue == fNoValue);
@@ -427,7 +683,7 @@ void UnifiedCache::_put(
 
     // Tell waiting threads that we replace in-progress status with
     // an error.
-    umtx_condBroadcast(&gInProgressValueAddedCond);
+    umtx_condBroadcast(&gInProgressValueAddedCond[shard]);
 }
 
 void UnifiedCache::_fetch(
@@ -473,14 +729,15 @@ UBool UnifiedCache::_isEvictable(const UHashElement *element) const
 
     // We can evict entries that are either not a master or have just
     // one reference (The one reference being from the cache itself).
-    return (!theKey->fIsMaster || (theValue->softRefCount == 1 && theValue->noHardReferences()));
+    return (!theKey->fIsMaster ||
+            (umtx_loadAcquire(theValue->softRefCount) == 1 && theValue->noHardReferences()));
 }
 
 void UnifiedCache::removeSoftRef(const SharedObject *value) const {
     U_ASSERT(value->cachePtr == this);
-    U_ASSERT(value->softRefCount > 0);
-    if (--value->softRefCount == 0) {
-        --fNumValuesTotal;
+    U_ASSERT(umtx_loadAcquire(value->softRefCount) > 0);
+    if (umtx_atomic_dec(&value->softRefCount) == 0) {
+        umtx_atomic_dec(&fNumValuesTotal);
         if (value->noHardReferences()) {
             delete value;
         } else {
@@ -498,7 +755,7 @@ int32_t UnifiedCache::removeHardRef(const SharedObject *value) const {
         refCount = umtx_atomic_dec(&value->hardRefCount);
         U_ASSERT(refCount >= 0);
         if (refCount == 0) {
-            --fNumValuesInUse;
+            umtx_atomic_dec(&fNumValuesInUse);
         }
     }
     return refCount;
@@ -510,10 +767,48 @@ int32_t UnifiedCache::addHardRef(const SharedObject *value) const {
         refCount = umtx_atomic_inc(&value->hardRefCount);
         U_ASSERT(refCount >= 1);
         if (refCount == 1) {
-            fNumValuesInUse++;
+            umtx_atomic_inc(&fNumValuesInUse);
         }
     }
     return refCount;
 }
 
 U_NAMESPACE_END
+
+U_NAMESPACE_USE
+
+U_CAPI int32_t U_EXPORT2
+ucache_getStatistics(UCacheStatistics *dest, int32_t destCapacity, UErrorCode *pErrorCode) {
+    const UnifiedCache *cache = UnifiedCache::getInstance(*pErrorCode);
+    if (U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    return cache->getStatistics(dest, destCapacity, *pErrorCode);
+}
+
+U_CAPI void U_EXPORT2
+ucache_resetStatistics(UErrorCode *pErrorCode) {
+    const UnifiedCache *cache = UnifiedCache::getInstance(*pErrorCode);
+    if (U_FAILURE(*pErrorCode)) {
+        return;
+    }
+    cache->resetStatistics();
+}
+
+U_CAPI void U_EXPORT2
+ucache_setEvictionPolicy(int32_t count, int32_t percentageOfInUseItems, UErrorCode *pErrorCode) {
+    UnifiedCache *cache = UnifiedCache::getInstance(*pErrorCode);
+    if (U_FAILURE(*pErrorCode)) {
+        return;
+    }
+    cache->setEvictionPolicy(count, percentageOfInUseItems, *pErrorCode);
+}
+
+U_CAPI void U_EXPORT2
+ucache_setMemoryBudget(int32_t maxBytes, UErrorCode *pErrorCode) {
+    UnifiedCache *cache = UnifiedCache::getInstance(*pErrorCode);
+    if (U_FAILURE(*pErrorCode)) {
+        return;
+    }
+    cache->setMemoryBudget(maxBytes, *pErrorCode);
+}
@@ -17,6 +17,7 @@
 
 #include "unicode/uobject.h"
 #include "unicode/locid.h"
+#include "unicode/ucache.h"
 #include "sharedobject.h"
 #include "unicode/unistr.h"
 #include "cstring.h"
@@ -34,13 +35,16 @@ class UnifiedCache;
  */
 class U_COMMON_API CacheKeyBase : public UObject {
  public:
-   CacheKeyBase() : fCreationStatus(U_ZERO_ERROR), fIsMaster(FALSE) {}
+   CacheKeyBase()
+           : fCreationStatus(U_ZERO_ERROR), fIsMaster(FALSE),
+             fRecentlyUsed(FALSE), fFootprint(0) {}
 
    /**
     * Copy constructor. Needed to support cloning.
     */
    CacheKeyBase(const CacheKeyBase &other) 
-           : UObject(other), fCreationStatus(other.fCreationStatus), fIsMaster(FALSE) { }
+           : UObject(other), fCreationStatus(other.fCreationStatus), fIsMaster(FALSE),
+             fRecentlyUsed(FALSE), fFootprint(0) { }
    virtual ~CacheKeyBase();
 
    /**
@@ -80,6 +84,12 @@ class U_COMMON_API CacheKeyBase : public UObject {
     */
    virtual char *writeDescription(char *buffer, int32_t bufSize) const = 0;
 
+   /**
+    * Returns the name of the type of value this key maps to. Used to
+    * group cache statistics. The returned string is in static storage.
+    */
+   virtual const char *getTypeName() const = 0;
+
    /**
     * Inequality operator.
     */
@@ -89,6 +99,10 @@ class U_COMMON_API CacheKeyBase : public UObject {
  private:
    mutable UErrorCode fCreationStatus;
    mutable UBool fIsMaster;
+   // CLOCK reference bit: set on each cache hit, cleared by the eviction sweep.
+   mutable UBool fRecentlyUsed;
+   // For master keys, the footprint of the value counted in the cache's retained bytes.
+   mutable int32_t fFootprint;
    friend class UnifiedCache;
 };
 
@@ -120,6 +134,13 @@ class CacheKey : public CacheKeyBase {
        return buffer;
    }
 
+   /**
+    * The template parameter, T, determines the type name.
+    */
+   virtual const char *getTypeName() const {
+       return typeid(T).name();
+   }
+
    /**
     * Two objects are equal if they are of the same type.
     */
@@ -327,6 +348,31 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
    void setEvictionPolicy(
            int32_t count, int32_t percentageOfInUseItems, UErrorCode &status);
 
+   /**
+    * Bounds the memory retained by this cache. While the sum of
+    * SharedObject::getMemoryFootprint() over all cached values exceeds
+    * maxBytes, eviction slices evict unused entries even if the count based
+    * policy set with setEvictionPolicy() would keep them.
+    *
+    * With a budget in effect, eviction follows the CLOCK algorithm:
+    * every cache hit marks its entry as recently used, and the eviction
+    * sweep clears that mark instead of evicting a marked entry, giving it a
+    * second chance. Frequently fetched objects thus stay resident even while
+    * nobody holds a reference to them. Values with references from outside
+    * the cache are never evicted, so the budget can be exceeded while
+    * clients hold on to many distinct values.
+    *
+    * maxBytes == 0, the default, disables the budget and recency tracking.
+    * If maxBytes is negative, sets status to U_ILLEGAL_ARGUMENT_ERROR.
+    */
+   void setMemoryBudget(int32_t maxBytes, UErrorCode &status);
+
+   /**
+    * Returns the sum of SharedObject::getMemoryFootprint() over all values
+    * in this cache, as counted against the memory budget.
+    */
+   int32_t bytesRetained() const;
+
 
    /**
     * Returns how many entries have been auto evicted during the lifetime
@@ -341,42 +387,91 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
     */
    int32_t unusedCount() const;
 
+   /**
+    * Reports hit, miss, creation time and eviction counters, entry counts
+    * and retained bytes for each type of value in this cache, sorted by
+    * type name. Implements ucache_getStatistics().
+    *
+    * @param dest         destination array; can be NULL if destCapacity==0
+    * @param destCapacity number of items that fit into dest
+    * @param status       Set to U_BUFFER_OVERFLOW_ERROR if dest is too small.
+    * @return the number of value types in the cache.
+    */
+   int32_t getStatistics(
+           UCacheStatistics *dest, int32_t destCapacity, UErrorCode &status) const;
+
+   /**
+    * Resets the hit, miss, creation time and eviction counters to zero.
+    */
+   void resetStatistics() const;
+
    virtual void handleUnreferencedObject() const;
    virtual ~UnifiedCache();
-   
+
+   /**
+    * The number of independently locked partitions of the cache.
+    * Keys are distributed among the shards by hash code, so that lookups
+    * of different keys from different threads rarely contend for the same
+    * mutex. Must be a power of 2.
+    * @internal
+    */
+   static constexpr int32_t SHARD_COUNT = 16;
+
  private:
-   UHashtable *fHashtable;
-   mutable int32_t fEvictPos;
-   mutable int32_t fNumValuesTotal;
-   mutable int32_t fNumValuesInUse;
-   int32_t fMaxUnused;
-   int32_t fMaxPercentageOfInUse;
-   mutable int64_t fAutoEvictedCount;
+   UHashtable *fHashtables[SHARD_COUNT];
+   // Per-shard UCacheStatistics keyed by CacheKeyBase::getTypeName(), so that
+   // counting a hit needs no lock other than that of the shard.
+   UHashtable *fStatistics[SHARD_COUNT];
+   mutable int32_t fEvictPos[SHARD_COUNT];
+   mutable int64_t fAutoEvictedCount[SHARD_COUNT];
+   mutable u_atomic_int32_t fEvictShard;
+   mutable u_atomic_int32_t fNumKeys;
+   mutable u_atomic_int32_t fNumValuesTotal;
+   mutable u_atomic_int32_t fNumValuesInUse;
+   mutable u_atomic_int32_t fMaxUnused;
+   mutable u_atomic_int32_t fMaxPercentageOfInUse;
+   mutable u_atomic_int32_t fBytesRetained;
+   mutable u_atomic_int32_t fMaxBytes;
    SharedObject *fNoValue;
    
    UnifiedCache(const UnifiedCache &other);
    UnifiedCache &operator=(const UnifiedCache &other);
+
+   /**
+    * Returns the shard that holds the given key.
+    */
+   static int32_t _shardOf(const CacheKeyBase &key);
+
+   /**
+    * Returns the statistics record for the type of the given key in the given
+    * shard, creating it if necessary. Returns NULL if out of memory; counting
+    * is best-effort only.
+    * On entry, the mutex of the shard must be held.
+    */
+   UCacheStatistics *_statisticsFor(int32_t shard, const CacheKeyBase &key) const;
    
    /**
-    * Flushes the contents of the cache. If cache values hold references to other
-    * cache values then _flush should be called in a loop until it returns FALSE.
+    * Flushes the contents of one shard of the cache. If cache values hold
+    * references to other cache values then _flush should be called in a loop
+    * until it returns FALSE.
     * 
-    * On entry, gCacheMutex must be held.
+    * On entry, the mutex of the shard must be held.
     * On exit, those values with are evictable are flushed.
     * 
+    *  @param shard the shard to flush.
     *  @param all if false flush evictable items only, which are those with no external
     *                    references, plus those that can be safely recreated.<br>
     *            if true, flush all elements. Any values (sharedObjects) with remaining
     *                     hard (external) references are not deleted, but are detached from
     *                     the cache, so that a subsequent removeRefs can delete them.
     *                     _flush is not thread safe when all is true.
-    *   @return TRUE if any value in cache was flushed or FALSE otherwise.
+    *   @return TRUE if any value in the shard was flushed or FALSE otherwise.
     */
-   UBool _flush(UBool all) const;
+   UBool _flush(int32_t shard, UBool all) const;
    
    /**
     * Gets value out of cache.
-    * On entry. gCacheMutex must not be held. value must be NULL. status
+    * On entry. No shard mutex may be held. value must be NULL. status
     * must be U_ZERO_ERROR.
     * On exit. value and status set to what is in cache at key or on cache
     * miss the key's createObject() is called and value and status are set to
@@ -393,7 +488,7 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
 
     /**
      * Attempts to fetch value and status for key from cache.
-     * On entry, gCacheMutex must not be held value must be NULL and status must
+     * On entry, no shard mutex may be held value must be NULL and status must
      * be U_ZERO_ERROR.
      * On exit, either returns FALSE (In this
      * case caller should try to create the object) or returns TRUE with value
@@ -403,17 +498,20 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
      * returned, caller must call removeRef() on value.
      */
     UBool _poll(
+            int32_t shard,
             const CacheKeyBase &key,
             const SharedObject *&value,
             UErrorCode &status) const;
     
     /**
      * Places a new value and creationStatus in the cache for the given key.
-     * On entry, gCacheMutex must be held. key must not exist in the cache. 
+     * On entry, the mutex of the shard must be held. key must not exist in
+     * the cache. 
      * On exit, value and creation status placed under key. Soft reference added
      * to value on successful add. On error sets status.
      */
     void _putNew(
+        int32_t shard,
         const CacheKeyBase &key,
         const SharedObject *value,
         const UErrorCode creationStatus,
@@ -424,25 +522,29 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
      * entry for key is in progress. Otherwise, it leaves the current value and
      * status there.
      * 
-     * On entry. gCacheMutex must not be held. Value must be
+     * On entry. No shard mutex may be held. Value must be
      * included in the reference count of the object to which it points.
      * 
      * On exit, value and status are changed to what was already in the cache if
      * something was there and not in progress. Otherwise, value and status are left
      * unchanged in which case they are placed in the cache on a best-effort basis.
+     * creationMillis, the time it took to create value, is added to the
+     * statistics for the type of key.
      * Caller must call removeRef() on value.
      */
    void _putIfAbsentAndGet(
+           int32_t shard,
            const CacheKeyBase &key,
            const SharedObject *&value,
+           double creationMillis,
            UErrorCode &status) const;
 
     /**
-     * Returns the next element in the cache round robin style.
-     * Returns nullptr if the cache is empty.
-     * On entry, gCacheMutex must be held.
+     * Returns the next element in the given shard round robin style.
+     * Returns nullptr if the shard is empty.
+     * On entry, the mutex of the shard must be held.
      */
-    const UHashElement *_nextElement() const;
+    const UHashElement *_nextElement(int32_t shard) const;
    
    /**
     * Return the number of cache items that would need to be evicted
@@ -450,15 +552,30 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
     * 
     * An item corresponds to an entry in the hash table, a hash table element.
     * 
-    * On entry, gCacheMutex must be held.
+    * Reads only atomic counters; no shard mutex needs to be held.
     */
    int32_t _computeCountOfItemsToEvict() const;
    
+   /**
+    * Returns TRUE if a memory budget is set and the retained bytes exceed it.
+    * Reads only atomic counters; no shard mutex needs to be held.
+    */
+   UBool _isOverBudget() const;
+
+   /**
+    * Removes element from the given shard, updating the key and byte counts,
+    * and removes the soft reference to its value.
+    * On entry, the mutex of the shard must be held.
+    */
+   void _removeElement(int32_t shard, const UHashElement *element) const;
+
    /**
     * Run an eviction slice.
-    * On entry, gCacheMutex must be held.
+    * On entry, no shard mutex may be held.
     * _runEvictionSlice runs a slice of the evict pipeline by examining the next
     * 10 entries in the cache round robin style evicting them if they are eligible.
+    * The shards are visited in turn, and only one shard mutex is held at a time.
+    * If a memory budget is set, recently used entries get a second chance.
     */
    void _runEvictionSlice() const;
  
@@ -468,36 +585,38 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
     * produce referneces to an already existing SharedObject are not masters -
     * they can be evicted and subsequently recreated.
     * 
-    * On entry, gCacheMutex must be held.
+    * On entry, the mutex of the shard holding theKey must be held.
     * On exit, items in use count incremented, entry is marked as a master
-    * entry, and value registered with cache so that subsequent calls to
+    * entry, the footprint of value is added to the retained bytes, and value
+    * registered with cache so that subsequent calls to
     * addRef() and removeRef() on it correctly interact with the cache.
     */
    void _registerMaster(const CacheKeyBase *theKey, const SharedObject *value) const;
         
    /**
     * Store a value and creation error status in given hash entry.
-    * On entry, gCacheMutex must be held. Hash entry element must be in progress.
-    * value must be non NULL.
+    * On entry, the mutex of the shard must be held. Hash entry element must
+    * be in progress. value must be non NULL.
     * On Exit, soft reference added to value. value and status stored in hash
-    * entry. Soft reference removed from previous stored value. Waiting
-    * threads notified.
+    * entry. Soft reference removed from previous stored value. Threads
+    * waiting on the shard notified.
     */
    void _put(
+           int32_t shard,
            const UHashElement *element,
            const SharedObject *value,
            const UErrorCode status) const;
     /**
      * Remove a soft reference, and delete the SharedObject if no references remain.
      * To be used from within the UnifiedCache implementation only.
-     * gCacheMutex must be held by caller.
+     * The mutex of the shard holding the reference must be held by caller.
      * @param value the SharedObject to be acted on.
      */
    void removeSoftRef(const SharedObject *value) const;
    
    /**
     * Increment the hard reference count of the given SharedObject.
-    * gCacheMutex must be held by the caller.
+    * The mutex of the shard the value was fetched from must be held by the caller.
     * Update numValuesEvictable on transitions between zero and one reference.
     * 
     * @param value The SharedObject to be referenced.
@@ -507,7 +626,7 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
    
   /**
     * Decrement the hard reference count of the given SharedObject.
-    * gCacheMutex must be held by the caller.
+    * The mutex of the shard the value was fetched from must be held by the caller.
     * Update numValuesEvictable on transitions between one and zero reference.
     * 
     * @param value The SharedObject to be referenced.
@@ -517,12 +636,12 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
 
    
 #ifdef UNIFIED_CACHE_DEBUG
-   void _dumpContents() const;
+   void _dumpContents(int32_t shard) const;
 #endif
    
    /**
     *  Fetch value and error code from a particular hash entry.
-    *  On entry, gCacheMutex must be held. value must be either NULL or must be
+    *  On entry, the mutex of the shard holding element must be held. value must be either NULL or must be
     *  included in the ref count of the object to which it points.
     *  On exit, value and status set to what is in the hash entry. Caller must
     *  eventually call removeRef on value.
@@ -534,19 +653,19 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
                        
     /**
      * Determine if given hash entry is in progress.
-     * On entry, gCacheMutex must be held.
+     * On entry, the mutex of the shard holding element must be held.
      */
    UBool _inProgress(const UHashElement *element) const;
    
    /**
     * Determine if given hash entry is in progress.
-    * On entry, gCacheMutex must be held.
+    * On entry, the mutex of the shard holding the entry must be held.
     */
    UBool _inProgress(const SharedObject *theValue, UErrorCode creationStatus) const;
    
    /**
     * Determine if given hash entry is eligible for eviction.
-    * On entry, gCacheMutex must be held.
+    * On entry, the mutex of the shard holding element must be held.
     */
    UBool _isEvictable(const UHashElement *element) const;
 };
@@ -44,11 +44,38 @@ using namespace icu;
 Static cache for already opened resource bundles - mostly for keeping fallback info
 TODO: This cache should probably be removed when the deprecated code is
       completely removed.
+
+The cache is split into shards, each with its own hash table and mutex,
+so that opening bundles which are already loaded does not contend on one lock.
+resbMutex serializes loading new bundles and linking their fallback chains.
+Entries stay in the cache until ures_flushCache(), and fParent links are only
+ever set once, so a completed fallback chain can be walked without locking.
+Such chains are marked with fChainFinal; other chains are walked with resbMutex locked.
+A "nofallback" bundle never gets a parent.
+
+Each shard also remembers, per requested locale ID, which entry ures_open()
+resolved it to (see FallbackMemo), guarded by the same shard mutex.
 */
-static UHashtable *cache = NULL;
+static const int32_t RESB_CACHE_SHARD_COUNT = 16;
+
+/*
+ * Limits the number of remembered fallback resolutions per shard,
+ * because the requested locale IDs may come from untrusted input.
+ * A full shard is cleared before a new ID is added.
+ */
+static const int32_t MAX_FALLBACK_MEMOS_PER_SHARD = 256;
+
+static UHashtable *cache[RESB_CACHE_SHARD_COUNT] = {};
+static UHashtable *gFallbackMemos[RESB_CACHE_SHARD_COUNT] = {};
 static icu::UInitOnce gCacheInitOnce;
 
 static UMutex resbMutex = U_MUTEX_INITIALIZER;
+static UMutex cacheMutex[RESB_CACHE_SHARD_COUNT] = {
+    U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER,
+    U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER,
+    U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER,
+    U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER, U_MUTEX_INITIALIZER
+};
 
 /* INTERNAL: hashes an entry  */
 static int32_t U_CALLCONV hashEntry(const UHashTok parm) {
@@ -73,6 +100,67 @@ static UBool U_CALLCONV compareEntries(const UHashTok p1, const UHashTok p2) {
 }
 
 
+/**
+ * The result of opening a bundle for a requested locale ID, before canonicalization.
+ * It is both the key and the value in its hash table.
+ * Allocated in one block together with its strings.
+ */
+struct FallbackMemo {
+    int32_t openType;
+    const char *path;  // NULL for ICU data
+    const char *localeID;
+    // The default locale ID when the resolution depended on it, otherwise NULL.
+    const char *defaultLocaleID;
+    UResourceDataEntry *entry;
+    UErrorCode status;
+};
+
+/* INTERNAL: hashes a fallback memo */
+static int32_t U_CALLCONV hashFallbackMemo(const UHashTok parm) {
+    const FallbackMemo *m = (const FallbackMemo *)parm.pointer;
+    UHashTok idkey, pathkey;
+    idkey.pointer = (void *)m->localeID;
+    pathkey.pointer = (void *)m->path;
+    return uhash_hashChars(idkey)+37u*uhash_hashChars(pathkey)+m->openType;
+}
+
+/* INTERNAL: compares two fallback memos */
+static UBool U_CALLCONV compareFallbackMemos(const UHashTok p1, const UHashTok p2) {
+    const FallbackMemo *m1 = (const FallbackMemo *)p1.pointer;
+    const FallbackMemo *m2 = (const FallbackMemo *)p2.pointer;
+    UHashTok id1, id2, path1, path2;
+    id1.pointer = (void *)m1->localeID;
+    id2.pointer = (void *)m2->localeID;
+    path1.pointer = (void *)m1->path;
+    path2.pointer = (void *)m2->path;
+    return (UBool)(m1->openType == m2->openType &&
+        uhash_compareChars(id1, id2) &&
+        uhash_compareChars(path1, path2));
+}
+
+/* INTERNAL: returns the cache shard for a fallback memo */
+static int32_t memoShardOf(const FallbackMemo *m) {
+    UHashTok key;
+    key.pointer = (void *)m;
+    return (int32_t)((uint32_t)hashFallbackMemo(key) >> 4) & (RESB_CACHE_SHARD_COUNT - 1);
+}
+
+/* INTERNAL: returns the cache shard for an entry with the entry's name and path */
+static int32_t shardOf(const UResourceDataEntry *entry) {
+    UHashTok key;
+    key.pointer = (void *)entry;
+    return (int32_t)((uint32_t)hashEntry(key) >> 4) & (RESB_CACHE_SHARD_COUNT - 1);
+}
+
+/* INTERNAL: looks up an entry with the same name and path in the cache */
+static UResourceDataEntry *getCachedEntry(const UResourceDataEntry *find) {
+    int32_t shard = shardOf(find);
+    umtx_lock(&cacheMutex[shard]);
+    UResourceDataEntry *r = (UResourceDataEntry *)uhash_get(cache[shard], find);
+    umtx_unlock(&cacheMutex[shard]);
+    return r;
+}
+
 /**
  *  Internal function, gets parts of locale name according 
  *  to the position of '_' character
@@ -90,15 +178,21 @@ static UBool chopLocale(char *name) {
 
 /**
  *  Internal function
+ *  Locks resbMutex unless the fallback chain of the entry is final (see markChainFinal()).
  */
 static void entryIncrease(UResourceDataEntry *entry) {
-    umtx_lock(&resbMutex);
-    entry->fCountExisting++;
+    UBool isFinal = umtx_loadAcquire(entry->fChainFinal) != 0;
+    if(!isFinal) {
+        umtx_lock(&resbMutex);
+    }
+    umtx_atomic_inc(&entry->fCountExisting);
     while(entry->fParent != NULL) {
       entry = entry->fParent;
-      entry->fCountExisting++;
+      umtx_atomic_inc(&entry->fCountExisting);
+    }
+    if(!isFinal) {
+        umtx_unlock(&resbMutex);
     }
-    umtx_unlock(&resbMutex);
 }
 
 /**
@@ -156,14 +250,14 @@ free_entry(UResourceDataEntry *entry) {
         uprv_free(entry->fPath);
     }
     if(entry->fPool != NULL) {
-        --entry->fPool->fCountExisting;
+        umtx_atomic_dec(&entry->fPool->fCountExisting);
     }
     alias = entry->fAlias;
     if(alias != NULL) {
         while(alias->fAlias != NULL) {
             alias = alias->fAlias;
         }
-        --alias->fCountExisting;
+        umtx_atomic_dec(&alias->fCountExisting);
     }
     uprv_free(entry);
 }
@@ -181,33 +275,44 @@ static int32_t ures_flushCache()
     * return 0
     */
     umtx_lock(&resbMutex);
-    if (cache == NULL) {
+    if (cache[0] == NULL) {
         umtx_unlock(&resbMutex);
         return 0;
     }
 
+    /* The memos point to entries without holding references. */
+    for (int32_t shard = 0; shard < RESB_CACHE_SHARD_COUNT; ++shard) {
+        umtx_lock(&cacheMutex[shard]);
+        uhash_removeAll(gFallbackMemos[shard]);
+        umtx_unlock(&cacheMutex[shard]);
+    }
+
     do {
         deletedMore = FALSE;
-        /*creates an enumeration to iterate through every element in the table */
-        pos = UHASH_FIRST;
-        while ((e = uhash_nextElement(cache, &pos)) != NULL)
-        {
-            resB = (UResourceDataEntry *) e->value.pointer;
-            /* Deletes only if reference counter == 0
-             * Don't worry about the children of this node.
-             * Those will eventually get deleted too, if not already.
-             * Don't worry about the parents of this node.
-             * Those will eventually get deleted too, if not already.
-             */
-            /* 04/05/2002 [weiv] fCountExisting should now be accurate. If it's not zero, that means that    */
-            /* some resource bundles are still open somewhere. */
-
-            if (resB->fCountExisting == 0) {
-                rbDeletedNum++;
-                deletedMore = TRUE;
-                uhash_removeElement(cache, e);
-                free_entry(resB);
+        for (int32_t shard = 0; shard < RESB_CACHE_SHARD_COUNT; ++shard) {
+            umtx_lock(&cacheMutex[shard]);
+            /*creates an enumeration to iterate through every element in the table */
+            pos = UHASH_FIRST;
+            while ((e = uhash_nextElement(cache[shard], &pos)) != NULL)
+            {
+                resB = (UResourceDataEntry *) e->value.pointer;
+                /* Deletes only if reference counter == 0
+                 * Don't worry about the children of this node.
+                 * Those will eventually get deleted too, if not already.
+                 * Don't worry about the parents of this node.
+                 * Those will eventually get deleted too, if not already.
+                 */
+                /* 04/05/2002 [weiv] fCountExisting should now be accurate. If it's not zero, that means that    */
+                /* some resource bundles are still open somewhere. */
+
+                if (umtx_loadAcquire(resB->fCountExisting) == 0) {
+                    rbDeletedNum++;
+                    deletedMore = TRUE;
+                    uhash_removeElement(cache[shard], e);
+                    free_entry(resB);
+                }
             }
+            umtx_unlock(&cacheMutex[shard]);
         }
         /*
          * Do it again to catch bundles (aliases, pool bundle) whose fCountExisting
@@ -224,31 +329,36 @@ static int32_t ures_flushCache()
 
 U_CAPI UBool U_EXPORT2 ures_dumpCacheContents(void) {
   UBool cacheNotEmpty = FALSE;
-  int32_t pos = UHASH_FIRST;
+  int32_t pos;
   const UHashElement *e;
   UResourceDataEntry *resB;
   
     umtx_lock(&resbMutex);
-    if (cache == NULL) {
+    if (cache[0] == NULL) {
       umtx_unlock(&resbMutex);
       fprintf(stderr,"%s:%d: RB Cache is NULL.\n", __FILE__, __LINE__);
       return FALSE;
     }
 
-    while ((e = uhash_nextElement(cache, &pos)) != NULL) {
-      cacheNotEmpty=TRUE;
-      resB = (UResourceDataEntry *) e->value.pointer;
-      fprintf(stderr,"%s:%d: RB Cache: Entry @0x%p, refcount %d, name %s:%s.  Pool 0x%p, alias 0x%p, parent 0x%p\n",
-              __FILE__, __LINE__,
-              (void*)resB, resB->fCountExisting,
-              resB->fName?resB->fName:"NULL",
-              resB->fPath?resB->fPath:"NULL",
-              (void*)resB->fPool,
-              (void*)resB->fAlias,
-              (void*)resB->fParent);       
+    int32_t count = 0;
+    for (int32_t shard = 0; shard < RESB_CACHE_SHARD_COUNT; ++shard) {
+      pos = UHASH_FIRST;
+      count += uhash_count(cache[shard]);
+      while ((e = uhash_nextElement(cache[shard], &pos)) != NULL) {
+        cacheNotEmpty=TRUE;
+        resB = (UResourceDataEntry *) e->value.pointer;
+        fprintf(stderr,"%s:%d: RB Cache: Entry @0x%p, refcount %d, name %s:%s.  Pool 0x%p, alias 0x%p, parent 0x%p\n",
+                __FILE__, __LINE__,
+                (void*)resB, (int)umtx_loadAcquire(resB->fCountExisting),
+                resB->fName?resB->fName:"NULL",
+                resB->fPath?resB->fPath:"NULL",
+                (void*)resB->fPool,
+                (void*)resB->fAlias,
+                (void*)resB->fParent);       
+      }
     }
     
-    fprintf(stderr,"%s:%d: RB Cache still contains %d items.\n", __FILE__, __LINE__, uhash_count(cache));
+    fprintf(stderr,"%s:%d: RB Cache still contains %d items.\n", __FILE__, __LINE__, count);
 
     umtx_unlock(&resbMutex);
     
@@ -259,10 +369,14 @@ U_CAPI UBool U_EXPORT2 ures_dumpCacheContents(void) {
 
 static UBool U_CALLCONV ures_cleanup(void)
 {
-    if (cache != NULL) {
+    if (cache[0] != NULL) {
         ures_flushCache();
-        uhash_close(cache);
-        cache = NULL;
+        for (int32_t shard = 0; shard < RESB_CACHE_SHARD_COUNT; ++shard) {
+            uhash_close(cache[shard]);
+            cache[shard] = NULL;
+            uhash_close(gFallbackMemos[shard]);
+            gFallbackMemos[shard] = NULL;
+        }
     }
     gCacheInitOnce.reset();
     return TRUE;
@@ -270,8 +384,14 @@ static UBool U_CALLCONV ures_cleanup(void)
 
 /** INTERNAL: Initializes the cache for resources */
 static void U_CALLCONV createCache(UErrorCode &status) {
-    U_ASSERT(cache == NULL);
-    cache = uhash_open(hashEntry, compareEntries, NULL, &status);
+    U_ASSERT(cache[0] == NULL);
+    for (int32_t shard = 0; shard < RESB_CACHE_SHARD_COUNT && U_SUCCESS(status); ++shard) {
+        cache[shard] = uhash_open(hashEntry, compareEntries, NULL, &status);
+        gFallbackMemos[shard] = uhash_open(hashFallbackMemo, compareFallbackMemos, NULL, &status);
+        if (U_SUCCESS(status)) {
+            uhash_setKeyDeleter(gFallbackMemos[shard], uprv_free);
+        }
+    }
     ucln_common_registerCleanup(UCLN_COMMON_URES, ures_cleanup);
 }
      
@@ -337,7 +457,7 @@ static UResourceDataEntry *init_entry(const char *localeID, const char *path, UE
     /*hashValue = hashEntry(hashkey);*/
 
     /* check to see if we already have this entry */
-    r = (UResourceDataEntry *)uhash_get(cache, &find);
+    r = getCachedEntry(&find);
     if(r == NULL) {
         /* if the entry is not yet in the hash table, we'll try to construct a new one */
         r = (UResourceDataEntry *) uprv_malloc(sizeof(UResourceDataEntry));
@@ -346,7 +466,7 @@ static UResourceDataEntry *init_entry(const char *localeID, const char *path, UE
             return NULL;
         }
 
-        uprv_memset(r, 0, sizeof(UResourceDataEntry));
+        uprv_memset((void *)r, 0, sizeof(UResourceDataEntry));
         /*r->fHashKey = hashValue;*/
 
         setEntryName(r, name, status);
@@ -403,10 +523,12 @@ static UResourceDataEntry *init_entry(const char *localeID, const char *path, UE
 
         {
             UResourceDataEntry *oldR = NULL;
-            if((oldR = (UResourceDataEntry *)uhash_get(cache, r)) == NULL) { /* if the data is not cached */
+            int32_t shard = shardOf(r);
+            umtx_lock(&cacheMutex[shard]);
+            if((oldR = (UResourceDataEntry *)uhash_get(cache[shard], r)) == NULL) { /* if the data is not cached */
                 /* just insert it in the cache */
                 UErrorCode cacheStatus = U_ZERO_ERROR;
-                uhash_put(cache, (void *)r, r, &cacheStatus);
+                uhash_put(cache[shard], (void *)r, r, &cacheStatus);
                 if (U_FAILURE(cacheStatus)) {
                     *status = cacheStatus;
                     free_entry(r);
@@ -418,6 +540,7 @@ static UResourceDataEntry *init_entry(const char *localeID, const char *path, UE
                 free_entry(r);
                 r = oldR;
             }
+            umtx_unlock(&cacheMutex[shard]);
         }
 
     }
@@ -426,7 +549,7 @@ static UResourceDataEntry *init_entry(const char *localeID, const char *path, UE
         while(r->fAlias != NULL) {
             r = r->fAlias;
         }
-        r->fCountExisting++; /* we increase its reference count */
+        umtx_atomic_inc(&r->fCountExisting); /* we increase its reference count */
         /* if the resource has a warning */
         /* we don't want to overwrite a status with no error */
         if(r->fBogus != U_ZERO_ERROR && U_SUCCESS(*status)) {
@@ -471,7 +594,7 @@ findFirstExisting(const char* path, char* name,
             /* not to be used - as there might be parent   */
             /* lines in cache from previous openings that  */
             /* are not updated yet. */
-            r->fCountExisting--;
+            umtx_atomic_dec(&r->fCountExisting);
             /*entryCloseInt(r);*/
             r = NULL;
             *status = U_USING_FALLBACK_WARNING;
@@ -546,7 +669,7 @@ loadParentsExceptRoot(UResourceDataEntry *&t1,
             t1->fParent = t2;
             if (usingUSRData) {
                 // The USR override data wasn't found, set it to be deleted.
-                u2->fCountExisting = 0;
+                umtx_storeRelease(u2->fCountExisting, 0);
             }
         }
         t1 = t2;
@@ -601,8 +724,87 @@ enum UResOpenType {
 };
 typedef enum UResOpenType UResOpenType;
 
+/**
+ * INTERNAL: Marks each entry in the fallback chain of r with fChainFinal
+ * if the chain will not change any more: It ends with the root bundle or with
+ * a "nofallback" bundle, which never gets a parent.
+ * Returns TRUE if the chain is final.
+ *   CAUTION:  resbMutex must be locked when calling this function.
+ */
+static UBool markChainFinal(UResourceDataEntry *r) {
+    UResourceDataEntry *t1 = r;
+    while(t1->fParent != NULL) {
+        t1 = t1->fParent;
+    }
+    if(!t1->fData.noFallback && uprv_strcmp(t1->fName, kRootLocaleName) != 0) {
+        return FALSE;
+    }
+    for(t1 = r; t1 != NULL; t1 = t1->fParent) {
+        umtx_storeRelease(t1->fChainFinal, 1);
+    }
+    return TRUE;
+}
+
+/**
+ * INTERNAL: Records that the fallback chain of r, which was opened for the
+ * bundle name, is final, so that later opens can use entryOpenCompleted().
+ *   CAUTION:  resbMutex must be locked when calling this function,
+ *   and markChainFinal(r) must have returned TRUE.
+ */
+static void markChainComplete(const char *path, const char *name, const UResourceDataEntry *r) {
+    UResourceDataEntry find;
+    find.fName = (char *)name;
+    find.fPath = (char *)path;
+    int32_t shard = shardOf(&find);
+    umtx_lock(&cacheMutex[shard]);
+    UResourceDataEntry *e = (UResourceDataEntry *)uhash_get(cache[shard], &find);
+    if(e != NULL) {
+        const UResourceDataEntry *t1 = e;
+        while(t1->fAlias != NULL) {
+            t1 = t1->fAlias;
+        }
+        if(t1 == r) {
+            e->fChainComplete = TRUE;
+        }
+    }
+    umtx_unlock(&cacheMutex[shard]);
+}
+
+/**
+ * INTERNAL: Fast path for opening a bundle that was opened before.
+ * If the bundle name has a complete fallback chain (see markChainComplete()),
+ * then this increments the reference counts along the chain without locking
+ * resbMutex and returns the real bundle's entry. Otherwise it returns NULL.
+ * The result is the same as that of the first open of the bundle name.
+ */
+static UResourceDataEntry *entryOpenCompleted(const char *path, const char *name) {
+    UResourceDataEntry find;
+    find.fName = (char *)name;
+    find.fPath = (char *)path;
+    int32_t shard = shardOf(&find);
+    umtx_lock(&cacheMutex[shard]);
+    UResourceDataEntry *r = (UResourceDataEntry *)uhash_get(cache[shard], &find);
+    if(r != NULL && !r->fChainComplete) {
+        r = NULL;
+    }
+    umtx_unlock(&cacheMutex[shard]);
+    if(r == NULL) {
+        return NULL;
+    }
+    while(r->fAlias != NULL) {
+        r = r->fAlias;
+    }
+    entryIncrease(r);
+    return r;
+}
+
+/**
+ * INTERNAL: Opens the bundle chain for the canonical localeID.
+ * Sets *dependsOnDefault if the result would be different for another default locale.
+ */
 static UResourceDataEntry *entryOpen(const char* path, const char* localeID,
-                                     UResOpenType openType, UErrorCode* status) {
+                                     UResOpenType openType, UBool *dependsOnDefault,
+                                     UErrorCode* status) {
     U_ASSERT(openType != URES_OPEN_DIRECT);
     UErrorCode intStatus = U_ZERO_ERROR;
     UResourceDataEntry *r = NULL;
@@ -635,12 +837,18 @@ static UResourceDataEntry *entryOpen(const char* path, const char* localeID,
             usrDataPath[2] = 'r';
             usrDataPath[sizeof(usrDataPath) - 1] = 0;
         }
+    } else if(uprv_strlen(localeID) < sizeof(name)) {
+        r = entryOpenCompleted(path, localeID);
+        if(r != NULL) {
+            return r;
+        }
     }
  
     umtx_lock(&resbMutex);
     { /* umtx_lock */
         /* We're going to skip all the locales that do not have any data */
         r = findFirstExisting(path, name, &isRoot, &hasChopped, &isDefault, &intStatus);
+        *dependsOnDefault = (UBool)(r == NULL && openType == URES_OPEN_LOCALE_DEFAULT_ROOT);
 
         if(r != NULL) { /* if there is one real locale, we can look for parents. */
             t1 = r;
@@ -654,7 +862,7 @@ static UResourceDataEntry *entryOpen(const char* path, const char* localeID,
                    r = u1;
                  } else {
                    /* the USR override data wasn't found, set it to be deleted */
-                   u1->fCountExisting = 0;
+                   umtx_storeRelease(u1->fCountExisting, 0);
                  }
                }
             }
@@ -699,7 +907,7 @@ static UResourceDataEntry *entryOpen(const char* path, const char* localeID,
                 goto finishUnlock;
             }
         } else if(!isRoot && uprv_strcmp(t1->fName, kRootLocaleName) != 0 &&
-                t1->fParent == NULL && !r->fData.noFallback) {
+                t1->fParent == NULL && !r->fData.noFallback && !t1->fData.noFallback) {
             if (!insertRootBundle(t1, status)) {
                 goto finishUnlock;
             }
@@ -710,9 +918,16 @@ static UResourceDataEntry *entryOpen(const char* path, const char* localeID,
 
         // TODO: Does this ever loop?
         while(r != NULL && !isRoot && t1->fParent != NULL) {
-            t1->fParent->fCountExisting++;
+            umtx_atomic_inc(&t1->fParent->fCountExisting);
             t1 = t1->fParent;
         }
+
+        // User override data entries are relinked by each open.
+        // If the requested bundle has data, then later opens of it will yield the same chain.
+        if(!usingUSRData && markChainFinal(r) &&
+                intStatus == U_ZERO_ERROR && uprv_strlen(localeID) < sizeof(name)) {
+            markChainComplete(path, localeID, r);
+        }
     } /* umtx_lock */
 finishUnlock:
     umtx_unlock(&resbMutex);
@@ -740,12 +955,17 @@ entryOpenDirect(const char* path, const char* localeID, UErrorCode* status) {
         return NULL;
     }
 
+    UResourceDataEntry *r = entryOpenCompleted(path, localeID);
+    if(r != NULL) {
+        return r;
+    }
+
     umtx_lock(&resbMutex);
     // findFirstExisting() without fallbacks.
-    UResourceDataEntry *r = init_entry(localeID, path, status);
+    r = init_entry(localeID, path, status);
     if(U_SUCCESS(*status)) {
         if(r->fBogus != U_ZERO_ERROR) {
-            r->fCountExisting--;
+            umtx_atomic_dec(&r->fCountExisting);
             r = NULL;
         }
     } else {
@@ -762,7 +982,8 @@ entryOpenDirect(const char* path, const char* localeID, UErrorCode* status) {
         uprv_strcpy(name, localeID);
         if(!chopLocale(name) || uprv_strcmp(name, kRootLocaleName) == 0 ||
                 loadParentsExceptRoot(t1, name, UPRV_LENGTHOF(name), FALSE, NULL, status)) {
-            if(uprv_strcmp(t1->fName, kRootLocaleName) != 0 && t1->fParent == NULL) {
+            if(uprv_strcmp(t1->fName, kRootLocaleName) != 0 && t1->fParent == NULL &&
+                    !t1->fData.noFallback) {
                 insertRootBundle(t1, status);
             }
         }
@@ -774,9 +995,12 @@ entryOpenDirect(const char* path, const char* localeID, UErrorCode* status) {
     if(r != NULL) {
         // TODO: Does this ever loop?
         while(t1->fParent != NULL) {
-            t1->fParent->fCountExisting++;
+            umtx_atomic_inc(&t1->fParent->fCountExisting);
             t1 = t1->fParent;
         }
+        if(markChainFinal(r)) {
+            markChainComplete(path, localeID, r);
+        }
     }
     umtx_unlock(&resbMutex);
     return r;
@@ -784,7 +1008,8 @@ entryOpenDirect(const char* path, const char* localeID, UErrorCode* status) {
 
 /**
  * Functions to create and destroy resource bundles.
- *     CAUTION:  resbMutex must be locked when calling this function.
+ *     CAUTION:  resbMutex must be locked when calling entryCloseInt(),
+ *     unless the fallback chain of resB is final (see markChainFinal()).
  */
 /* INTERNAL: */
 static void entryCloseInt(UResourceDataEntry *resB) {
@@ -792,7 +1017,7 @@ static void entryCloseInt(UResourceDataEntry *resB) {
 
     while(resB != NULL) {
         p = resB->fParent;
-        resB->fCountExisting--;
+        umtx_atomic_dec(&resB->fCountExisting);
 
         /* Entries are left in the cache. TODO: add ures_flushCache() to force a flush
          of the cache. */
@@ -821,9 +1046,13 @@ static void entryCloseInt(UResourceDataEntry *resB) {
  */
 
 static void entryClose(UResourceDataEntry *resB) {
-  umtx_lock(&resbMutex);
-  entryCloseInt(resB);
-  umtx_unlock(&resbMutex);
+  if(umtx_loadAcquire(resB->fChainFinal) != 0) {
+    entryCloseInt(resB);
+  } else {
+    umtx_lock(&resbMutex);
+    entryCloseInt(resB);
+    umtx_unlock(&resbMutex);
+  }
 }
 
 /*
@@ -2194,6 +2423,131 @@ U_CFUNC const char* ures_getPath(const UResourceBundle* resB) {
 }
 #endif
 
+/**
+ * INTERNAL: Returns the entry remembered for opening localeID,
+ * with incremented reference counts, or NULL if there is none.
+ */
+static UResourceDataEntry *
+getFallbackMemo(const char *path, const char *localeID, UResOpenType openType,
+                UErrorCode *status) {
+    FallbackMemo find;
+    find.openType = openType;
+    find.path = path;
+    find.localeID = localeID;
+    int32_t shard = memoShardOf(&find);
+    UResourceDataEntry *r = NULL;
+    UErrorCode memoStatus = U_ZERO_ERROR;
+    umtx_lock(&cacheMutex[shard]);
+    const FallbackMemo *m = (const FallbackMemo *)uhash_get(gFallbackMemos[shard], &find);
+    if(m != NULL &&
+            (m->defaultLocaleID == NULL || uprv_strcmp(m->defaultLocaleID, uloc_getDefault()) == 0)) {
+        r = m->entry;
+        memoStatus = m->status;
+    }
+    umtx_unlock(&cacheMutex[shard]);
+    if(r != NULL) {
+        entryIncrease(r);
+        if(memoStatus != U_ZERO_ERROR) {
+            *status = memoStatus;
+        }
+    }
+    return r;
+}
+
+/**
+ * INTERNAL: Remembers that opening localeID yielded r and status,
+ * if r has a final fallback chain.
+ * Failures are ignored: The memo is only an optimization.
+ */
+static void
+putFallbackMemo(const char *path, const char *localeID, UResOpenType openType,
+                UResourceDataEntry *r, UBool dependsOnDefault, UErrorCode status) {
+    if(umtx_loadAcquire(r->fChainFinal) == 0) {
+        return;
+    }
+    const char *defaultLocaleID = dependsOnDefault ? uloc_getDefault() : NULL;
+    int32_t pathLength = path != NULL ? (int32_t)uprv_strlen(path) + 1 : 0;
+    int32_t idLength = (int32_t)uprv_strlen(localeID) + 1;
+    int32_t defaultLength = defaultLocaleID != NULL ? (int32_t)uprv_strlen(defaultLocaleID) + 1 : 0;
+    FallbackMemo *m = (FallbackMemo *)uprv_malloc(
+        sizeof(FallbackMemo) + pathLength + idLength + defaultLength);
+    if(m == NULL) {
+        return;
+    }
+    char *p = (char *)(m + 1);
+    m->openType = openType;
+    m->path = NULL;
+    if(path != NULL) {
+        m->path = uprv_strcpy(p, path);
+        p += pathLength;
+    }
+    m->localeID = uprv_strcpy(p, localeID);
+    p += idLength;
+    m->defaultLocaleID = NULL;
+    if(defaultLocaleID != NULL) {
+        m->defaultLocaleID = uprv_strcpy(p, defaultLocaleID);
+    }
+    m->entry = r;
+    m->status = status;
+
+    int32_t shard = memoShardOf(m);
+    UErrorCode errorCode = U_ZERO_ERROR;
+    umtx_lock(&cacheMutex[shard]);
+    if(uhash_count(gFallbackMemos[shard]) >= MAX_FALLBACK_MEMOS_PER_SHARD &&
+            uhash_get(gFallbackMemos[shard], m) == NULL) {
+        // Full: Start over rather than keeping only the first IDs forever.
+        uhash_removeAll(gFallbackMemos[shard]);
+    }
+    // Replaces and deletes an outdated memo, for example for another default locale.
+    // Deletes m if it cannot be added.
+    uhash_put(gFallbackMemos[shard], m, m, &errorCode);
+    umtx_unlock(&cacheMutex[shard]);
+}
+
+/**
+ * INTERNAL: Opens the bundle chain for the locale ID as requested,
+ * using the remembered result of an earlier open of the same ID if possible.
+ * Repeated opens with uncanonical or unsupported locale IDs thus skip
+ * canonicalization and the fallback search.
+ */
+static UResourceDataEntry *
+entryOpenWithMemo(const char *path, const char *localeID, UResOpenType openType,
+                  UErrorCode *status) {
+    UResourceDataEntry *r;
+    if(localeID != NULL) {
+        initCache(status);
+        if(U_FAILURE(*status)) {
+            return NULL;
+        }
+        r = getFallbackMemo(path, localeID, openType, status);
+        if(r != NULL) {
+            return r;
+        }
+    }
+
+    /* first "canonicalize" the locale ID */
+    char canonLocaleID[ULOC_FULLNAME_CAPACITY];
+    uloc_getBaseName(localeID, canonLocaleID, UPRV_LENGTHOF(canonLocaleID), status);
+    if(U_FAILURE(*status) || *status == U_STRING_NOT_TERMINATED_WARNING) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    UErrorCode openStatus = U_ZERO_ERROR;
+    UBool dependsOnDefault = FALSE;
+    r = entryOpen(path, canonLocaleID, openType, &dependsOnDefault, &openStatus);
+    if(U_FAILURE(openStatus)) {
+        *status = openStatus;
+        return NULL;
+    }
+    if(r != NULL && localeID != NULL) {
+        putFallbackMemo(path, localeID, openType, r, dependsOnDefault, openStatus);
+    }
+    if(openStatus != U_ZERO_ERROR) {
+        *status = openStatus;
+    }
+    return r;
+}
+
 static UResourceBundle*
 ures_openWithType(UResourceBundle *r, const char* path, const char* localeID,
                   UResOpenType openType, UErrorCode* status) {
@@ -2203,14 +2557,7 @@ ures_openWithType(UResourceBundle *r, const char* path, const char* localeID,
 
     UResourceDataEntry *entry;
     if(openType != URES_OPEN_DIRECT) {
-        /* first "canonicalize" the locale ID */
-        char canonLocaleID[ULOC_FULLNAME_CAPACITY];
-        uloc_getBaseName(localeID, canonLocaleID, UPRV_LENGTHOF(canonLocaleID), status);
-        if(U_FAILURE(*status) || *status == U_STRING_NOT_TERMINATED_WARNING) {
-            *status = U_ILLEGAL_ARGUMENT_ERROR;
-            return NULL;
-        }
-        entry = entryOpen(path, canonLocaleID, openType, status);
+        entry = entryOpenWithMemo(path, localeID, openType, status);
     } else {
         entry = entryOpenDirect(path, localeID, status);
     }
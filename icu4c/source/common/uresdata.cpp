@@ -31,6 +31,7 @@
 #include "ucol_swp.h"
 #include "udataswp.h"
 #include "uinvchar.h"
+#include "umutex.h"
 #include "uresdata.h"
 #include "uresimp.h"
 
@@ -66,54 +67,183 @@ static const struct {
 } gEmptyString={ 0, 0, 0 };
 
 /*
- * All the type-access functions assume that
- * the resource is of the expected type.
+ * Hash index for key lookups in large tables.
+ *
+ * Binary search in a table with n items takes about log2(n) key comparisons.
+ * For large tables (zoneStrings, Currencies, units, ...) we instead look up
+ * (table, key) pairs in one open-addressing hash table per bundle.
+ * The index is built on the first lookup in any large table of the bundle,
+ * by walking the whole resource tree once.
  */
 
-static int32_t
-_res_findTableItem(const ResourceData *pResData, const uint16_t *keyOffsets, int32_t length,
-                   const char *key, const char **realKey) {
-    const char *tableKey;
-    int32_t mid, start, limit;
-    int result;
+/* Smaller tables are binary-searched. */
+#define URESDATA_MIN_INDEXED_TABLE_LENGTH 32
 
-    /* do a binary search for the key */
-    start=0;
-    limit=length;
-    while(start<limit) {
-        mid = (start + limit) / 2;
-        tableKey = RES_GET_KEY16(pResData, keyOffsets[mid]);
-        if (pResData->useNativeStrcmp) {
-            result = uprv_strcmp(key, tableKey);
-        } else {
-            result = uprv_compareInvCharsAsAscii(key, tableKey);
+/* Give up on the index for pathologically large or deep bundles. */
+#define URESDATA_MAX_INDEXED_ITEMS 0x100000
+#define URESDATA_MAX_INDEX_DEPTH 64
+
+static UBool gUseTableKeyIndex=TRUE;
+
+struct ResourceTableKeySlot {
+    Resource table;  /* 0 if the slot is empty (0 is never a table resource) */
+    int32_t item;
+};
+
+struct ResourceTableKeyIndex : public icu::UMemory {
+    icu::UInitOnce initOnce = U_INITONCE_INITIALIZER;
+    ResourceTableKeySlot *slots = NULL;  /* NULL if the index could not be built */
+    uint32_t mask = 0;
+};
+
+static inline const char *
+getTableKey(const ResourceData *pResData, uint16_t keyOffset) {
+    return RES_GET_KEY16(pResData, keyOffset);
+}
+
+static inline const char *
+getTableKey(const ResourceData *pResData, int32_t keyOffset) {
+    return RES_GET_KEY32(pResData, keyOffset);
+}
+
+static inline uint32_t
+hashTableKey(Resource table, const char *key) {
+    uint32_t hash=table*0x9e3779b1;
+    uint8_t c;
+    while((c=(uint8_t)*key++)!=0) {
+        hash=hash*37+c;
+    }
+    return hash^(hash>>15);
+}
+
+static UBool
+insertTableKeys(const ResourceData *pResData, ResourceTableKeyIndex *index,
+                Resource table, int32_t length) {
+    for(int32_t i=0; i<length; ++i) {
+        const char *key;
+        res_getTableItemByIndex(pResData, table, i, &key);
+        uint32_t j=hashTableKey(table, key)&index->mask;
+        while(index->slots[j].table!=0) {
+            if(i==0 && index->slots[j].table==table && index->slots[j].item==0) {
+                /* This table is shared by multiple parents and already indexed. */
+                return FALSE;
+            }
+            j=(j+1)&index->mask;
         }
-        if (result < 0) {
-            limit = mid;
-        } else if (result > 0) {
-            start = mid + 1;
-        } else {
-            /* We found it! */
-            *realKey=tableKey;
-            return mid;
+        index->slots[j].table=table;
+        index->slots[j].item=i;
+    }
+    return TRUE;
+}
+
+/*
+ * Without index->slots, returns an upper bound for the number of items in large tables.
+ * With index->slots, also inserts the keys of those tables.
+ */
+static int32_t
+addTableKeys(const ResourceData *pResData, ResourceTableKeyIndex *index,
+             Resource res, int32_t depth) {
+    UResType type=(UResType)RES_GET_TYPE(res);
+    if(!URES_IS_CONTAINER(type)) {
+        return 0;
+    }
+    if(depth>URESDATA_MAX_INDEX_DEPTH) {
+        /* Every large table must be indexed, or none. */
+        return URESDATA_MAX_INDEXED_ITEMS+1;
+    }
+    int32_t length=res_countArrayItems(pResData, res);
+    int32_t count=0;
+    if(URES_IS_TABLE(type) && length>=URESDATA_MIN_INDEXED_TABLE_LENGTH) {
+        if(index->slots!=NULL && !insertTableKeys(pResData, index, res, length)) {
+            return 0;
         }
+        count=length;
     }
-    return URESDATA_ITEM_NOT_FOUND;  /* not found or table is empty. */
+    for(int32_t i=0; i<length && count<=URESDATA_MAX_INDEXED_ITEMS; ++i) {
+        Resource item=URES_IS_TABLE(type) ?
+            res_getTableItemByIndex(pResData, res, i, NULL) :
+            res_getArrayItem(pResData, res, i);
+        count+=addTableKeys(pResData, index, item, depth+1);
+    }
+    return count;
+}
+
+static void U_CALLCONV
+buildTableKeyIndex(const ResourceData *pResData) {
+    ResourceTableKeyIndex *index=pResData->keyIndex;
+    int32_t count=addTableKeys(pResData, index, pResData->rootRes, 0);
+    if(count==0 || count>URESDATA_MAX_INDEXED_ITEMS) {
+        return;
+    }
+    /* At most half full. */
+    uint32_t capacity=URESDATA_MIN_INDEXED_TABLE_LENGTH*2;
+    while(capacity<(uint32_t)count*2) {
+        capacity*=2;
+    }
+    ResourceTableKeySlot *slots=
+        (ResourceTableKeySlot *)uprv_malloc(capacity*sizeof(ResourceTableKeySlot));
+    if(slots==NULL) {
+        return;  /* Lookups fall back to binary search. */
+    }
+    uprv_memset(slots, 0, capacity*sizeof(ResourceTableKeySlot));
+    index->slots=slots;
+    index->mask=capacity-1;
+    addTableKeys(pResData, index, pResData->rootRes, 0);
+}
+
+static inline const ResourceTableKeyIndex *
+getTableKeyIndex(const ResourceData *pResData) {
+    ResourceTableKeyIndex *index=pResData->keyIndex;
+    if(index==NULL || !gUseTableKeyIndex) {
+        return NULL;
+    }
+    umtx_initOnce(index->initOnce, &buildTableKeyIndex, pResData);
+    return index->slots!=NULL ? index : NULL;
+}
+
+U_CAPI void U_EXPORT2
+res_setUseTableKeyIndex(UBool use) {
+    gUseTableKeyIndex=use;
 }
 
+/*
+ * All the type-access functions assume that
+ * the resource is of the expected type.
+ */
+
+template<typename KeyOffset>
 static int32_t
-_res_findTable32Item(const ResourceData *pResData, const int32_t *keyOffsets, int32_t length,
-                     const char *key, const char **realKey) {
+_res_findTableItem(const ResourceData *pResData, Resource table,
+                   const KeyOffset *keyOffsets, int32_t length,
+                   const char *key, const char **realKey) {
     const char *tableKey;
     int32_t mid, start, limit;
     int result;
 
+    const ResourceTableKeyIndex *index;
+    if(length>=URESDATA_MIN_INDEXED_TABLE_LENGTH &&
+            (index=getTableKeyIndex(pResData))!=NULL) {
+        uint32_t j=hashTableKey(table, key)&index->mask;
+        const ResourceTableKeySlot *slot;
+        while((slot=index->slots+j)->table!=0) {
+            if(slot->table==table) {
+                tableKey=getTableKey(pResData, keyOffsets[slot->item]);
+                if(uprv_strcmp(key, tableKey)==0) {
+                    *realKey=tableKey;
+                    return slot->item;
+                }
+            }
+            j=(j+1)&index->mask;
+        }
+        return URESDATA_ITEM_NOT_FOUND;
+    }
+
     /* do a binary search for the key */
     start=0;
     limit=length;
     while(start<limit) {
         mid = (start + limit) / 2;
-        tableKey = RES_GET_KEY32(pResData, keyOffsets[mid]);
+        tableKey = getTableKey(pResData, keyOffsets[mid]);
         if (pResData->useNativeStrcmp) {
             result = uprv_strcmp(key, tableKey);
         } else {
@@ -269,6 +399,10 @@ res_load(ResourceData *pResData,
 
     /* get its memory and initialize *pResData */
     res_init(pResData, formatVersion, udata_getMemory(pResData->data), -1, errorCode);
+    if(U_SUCCESS(*errorCode)) {
+        /* Without the index, lookups just use binary search. */
+        pResData->keyIndex=new ResourceTableKeyIndex();
+    }
 }
 
 U_CFUNC void
@@ -277,6 +411,11 @@ res_unload(ResourceData *pResData) {
         udata_close(pResData->data);
         pResData->data=NULL;
     }
+    if(pResData->keyIndex!=NULL) {
+        uprv_free(pResData->keyIndex->slots);
+        delete pResData->keyIndex;
+        pResData->keyIndex=NULL;
+    }
 }
 
 static const int8_t gPublicTypes[URES_LIMIT] = {
@@ -719,7 +858,7 @@ res_getTableItemByKey(const ResourceData *pResData, Resource table,
         if (offset!=0) { /* empty if offset==0 */
             const uint16_t *p= (const uint16_t *)(pResData->pRoot+offset);
             length=*p++;
-            *indexR=idx=_res_findTableItem(pResData, p, length, *key, key);
+            *indexR=idx=_res_findTableItem(pResData, table, p, length, *key, key);
             if(idx>=0) {
                 const Resource *p32=(const Resource *)(p+length+(~length&1));
                 return p32[idx];
@@ -730,7 +869,7 @@ res_getTableItemByKey(const ResourceData *pResData, Resource table,
     case URES_TABLE16: {
         const uint16_t *p=pResData->p16BitUnits+offset;
         length=*p++;
-        *indexR=idx=_res_findTableItem(pResData, p, length, *key, key);
+        *indexR=idx=_res_findTableItem(pResData, table, p, length, *key, key);
         if(idx>=0) {
             return makeResourceFrom16(pResData, p[length+idx]);
         }
@@ -740,7 +879,7 @@ res_getTableItemByKey(const ResourceData *pResData, Resource table,
         if (offset!=0) { /* empty if offset==0 */
             const int32_t *p= pResData->pRoot+offset;
             length=*p++;
-            *indexR=idx=_res_findTable32Item(pResData, p, length, *key, key);
+            *indexR=idx=_res_findTableItem(pResData, table, p, length, *key, key);
             if(idx>=0) {
                 return (Resource)p[length+idx];
             }
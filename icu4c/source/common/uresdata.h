@@ -378,6 +378,8 @@ enum {
  * - Vectors of 32-bit words stored as type Integer Vector.
  */
 
+struct ResourceTableKeyIndex;
+
 /*
  * Structure for a single, memory-mapped ResourceBundle.
  */
@@ -395,6 +397,12 @@ typedef struct ResourceData {
     UBool isPoolBundle;
     UBool usesPoolBundle;
     UBool useNativeStrcmp;
+    /*
+     * Hash index for key lookups in large tables, built on first use.
+     * Owned by the ResourceData that res_load() initialized;
+     * shared by copies of that struct. NULL for res_read().
+     */
+    struct ResourceTableKeyIndex *keyIndex;
 } ResourceData;
 
 /*
@@ -420,6 +428,14 @@ res_load(ResourceData *pResData,
 U_CFUNC void
 res_unload(ResourceData *pResData);
 
+/*
+ * Turns the use of the hash index for key lookups in large tables on or off.
+ * It is on by default. Only for performance comparisons;
+ * call only while no other thread uses resource bundles.
+ */
+U_INTERNAL void U_EXPORT2
+res_setUseTableKeyIndex(UBool use);
+
 U_INTERNAL UResType U_EXPORT2
 res_getPublicType(Resource res);
 
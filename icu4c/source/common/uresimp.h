@@ -14,6 +14,10 @@
 
 #include "uresdata.h"
 
+#ifdef __cplusplus
+#include "umutex.h"
+#endif
+
 #define kRootLocaleName         "root"
 #define kPoolBundleName         "pool"
 
@@ -51,8 +55,27 @@ struct UResourceDataEntry {
     UResourceDataEntry *fPool;
     ResourceData fData; /* data for low level access */
     char fNameBuffer[3]; /* A small buffer of free space for fName. The free space is due to struct padding. */
-    uint32_t fCountExisting; /* how much is this resource used */
+#ifdef __cplusplus
+    icu::u_atomic_int32_t fCountExisting; /* how much is this resource used; modified atomically */
+#else
+    int32_t fCountExisting;
+#endif
     UErrorCode fBogus;
+    /*
+     * TRUE when the fallback chain of the bundle with this name (following fAlias)
+     * has been built and will not change. Guarded by the cache shard mutex.
+     */
+    UBool fChainComplete;
+    /*
+     * Nonzero once the fallback chain starting at this entry is linked up to its end,
+     * so that its fParent links will not change any more.
+     * Set with release semantics while resbMutex is locked; read with acquire semantics.
+     */
+#ifdef __cplusplus
+    icu::u_atomic_int32_t fChainFinal;
+#else
+    int32_t fChainFinal;
+#endif
     /* int32_t fHashKey;*/ /* for faster access in the hashtable */
 };
 
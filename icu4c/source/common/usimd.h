@@ -0,0 +1,261 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// usimd.h
+// Vectorized helpers for runs of ASCII characters, shared by
+// the string transformation, conversion and normalization code.
+//
+// The vector instruction sets used here are part of the baseline of their
+// platforms (SSE2 on x86-64, NEON on AArch64), so there is no runtime dispatch.
+// Other platforms get the portable scalar versions.
+// Each helper processes only whole 16-byte vectors within its length limit
+// and returns how many units it handled; the caller continues with its
+// regular code for the rest, including all error handling.
+
+#ifndef __USIMD_H__
+#define __USIMD_H__
+
+#include "unicode/utypes.h"
+
+#if defined(UPRV_NO_SIMD)
+    // Vector code explicitly disabled.
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define UPRV_HAVE_SSE2 1
+#   include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#   define UPRV_HAVE_NEON 1
+#   include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#   define UPRV_CTZ16(mask) __builtin_ctz(mask)
+#else
+static inline int32_t uprv_ctz16(uint32_t mask) {
+    int32_t n = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        ++n;
+    }
+    return n;
+}
+#   define UPRV_CTZ16(mask) uprv_ctz16(mask)
+#endif
+
+/**
+ * Copies the leading ASCII bytes of s[0..length[ to dest as UChars.
+ * May stop before the end of the ASCII run.
+ * @return the number of bytes copied
+ */
+static inline int32_t
+uprv_copyASCIIToUTF16(const uint8_t *s, UChar *dest, int32_t length) {
+    int32_t i = 0;
+#if UPRV_HAVE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    while (i + 16 <= length) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+        int32_t mask = _mm_movemask_epi8(v);
+        if (mask != 0) {
+            // Copy the ASCII prefix of this block.
+            int32_t limit = i + UPRV_CTZ16((uint32_t)mask);
+            while (i < limit) {
+                dest[i] = s[i];
+                ++i;
+            }
+            return i;
+        }
+        _mm_storeu_si128((__m128i *)(dest + i), _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128((__m128i *)(dest + i + 8), _mm_unpackhi_epi8(v, zero));
+        i += 16;
+    }
+#elif UPRV_HAVE_NEON
+    while (i + 16 <= length) {
+        uint8x16_t v = vld1q_u8(s + i);
+        if (vmaxvq_u8(v) >= 0x80) {
+            break;
+        }
+        vst1q_u16((uint16_t *)(dest + i), vmovl_u8(vget_low_u8(v)));
+        vst1q_u16((uint16_t *)(dest + i + 8), vmovl_u8(vget_high_u8(v)));
+        i += 16;
+    }
+#else
+    (void)s;
+    (void)dest;
+    (void)length;
+#endif
+    return i;
+}
+
+/**
+ * Copies the leading ASCII UChars of s[0..length[ to dest as bytes.
+ * May stop before the end of the ASCII run.
+ * @return the number of UChars copied
+ */
+static inline int32_t
+uprv_copyASCIIToUTF8(const UChar *s, uint8_t *dest, int32_t length) {
+    int32_t i = 0;
+#if UPRV_HAVE_SSE2
+    const __m128i nonASCII = _mm_set1_epi16((short)0xff80);
+    const __m128i zero = _mm_setzero_si128();
+    while (i + 16 <= length) {
+        __m128i v0 = _mm_loadu_si128((const __m128i *)(s + i));
+        __m128i v1 = _mm_loadu_si128((const __m128i *)(s + i + 8));
+        __m128i high = _mm_and_si128(_mm_or_si128(v0, v1), nonASCII);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xffff) {
+            break;
+        }
+        _mm_storeu_si128((__m128i *)(dest + i), _mm_packus_epi16(v0, v1));
+        i += 16;
+    }
+#elif UPRV_HAVE_NEON
+    while (i + 16 <= length) {
+        uint16x8_t v0 = vld1q_u16((const uint16_t *)(s + i));
+        uint16x8_t v1 = vld1q_u16((const uint16_t *)(s + i + 8));
+        if (vmaxvq_u16(vorrq_u16(v0, v1)) >= 0x80) {
+            break;
+        }
+        vst1q_u8(dest + i, vcombine_u8(vmovn_u16(v0), vmovn_u16(v1)));
+        i += 16;
+    }
+#else
+    (void)s;
+    (void)dest;
+    (void)length;
+#endif
+    return i;
+}
+
+/**
+ * Counts the leading ASCII bytes of s[0..length[.
+ * May stop before the end of the ASCII run.
+ * @return the number of ASCII bytes skipped
+ */
+static inline int32_t
+uprv_skipASCII(const uint8_t *s, int32_t length) {
+    int32_t i = 0;
+#if UPRV_HAVE_SSE2
+    while (i + 16 <= length) {
+        int32_t mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(s + i)));
+        if (mask != 0) {
+            return i + UPRV_CTZ16((uint32_t)mask);
+        }
+        i += 16;
+    }
+#elif UPRV_HAVE_NEON
+    while (i + 16 <= length && vmaxvq_u8(vld1q_u8(s + i)) < 0x80) {
+        i += 16;
+    }
+#else
+    (void)s;
+    (void)length;
+#endif
+    return i;
+}
+
+/**
+ * Counts the leading UChars of s[0..length[ that are not surrogates.
+ * May stop before the first surrogate.
+ * @return the number of UChars skipped
+ */
+static inline int32_t
+uprv_skipNonSurrogates(const UChar *s, int32_t length) {
+    int32_t i = 0;
+#if UPRV_HAVE_SSE2
+    const __m128i surrogateMask = _mm_set1_epi16((short)0xf800);
+    const __m128i surrogateBits = _mm_set1_epi16((short)0xd800);
+    while (i + 8 <= length) {
+        __m128i v = _mm_and_si128(_mm_loadu_si128((const __m128i *)(s + i)), surrogateMask);
+        int32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi16(v, surrogateBits));
+        if (mask != 0) {
+            return i + UPRV_CTZ16((uint32_t)mask) / 2;
+        }
+        i += 8;
+    }
+#elif UPRV_HAVE_NEON
+    const uint16x8_t surrogateMask = vdupq_n_u16(0xf800);
+    const uint16x8_t surrogateBits = vdupq_n_u16(0xd800);
+    while (i + 8 <= length) {
+        uint16x8_t v = vandq_u16(vld1q_u16((const uint16_t *)(s + i)), surrogateMask);
+        if (vmaxvq_u16(vceqq_u16(v, surrogateBits)) != 0) {
+            break;
+        }
+        i += 8;
+    }
+#else
+    (void)s;
+    (void)length;
+#endif
+    return i;
+}
+
+/**
+ * Counts the leading bytes of s[0..length[ that are less than limit.
+ * May stop before the end of the run.
+ * @return the number of bytes skipped
+ */
+static inline int32_t
+uprv_skipBytesBelow(const uint8_t *s, int32_t length, uint8_t limit) {
+    int32_t i = 0;
+    if (limit == 0) {
+        return 0;
+    }
+#if UPRV_HAVE_SSE2
+    // b < limit exactly when the saturating b - (limit - 1) is 0.
+    const __m128i max = _mm_set1_epi8((char)(limit - 1));
+    const __m128i zero = _mm_setzero_si128();
+    while (i + 16 <= length) {
+        __m128i v = _mm_subs_epu8(_mm_loadu_si128((const __m128i *)(s + i)), max);
+        int32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)) ^ 0xffff;
+        if (mask != 0) {
+            return i + UPRV_CTZ16((uint32_t)mask);
+        }
+        i += 16;
+    }
+#elif UPRV_HAVE_NEON
+    const uint8x16_t lim = vdupq_n_u8(limit);
+    while (i + 16 <= length && vminvq_u8(vcltq_u8(vld1q_u8(s + i), lim)) != 0) {
+        i += 16;
+    }
+#else
+    (void)s;
+    (void)length;
+#endif
+    return i;
+}
+
+/**
+ * Counts the leading UChars of s[0..length[ that are less than limit.
+ * May stop before the end of the run.
+ * @return the number of UChars skipped
+ */
+static inline int32_t
+uprv_skipUCharsBelow(const UChar *s, int32_t length, UChar limit) {
+    int32_t i = 0;
+    if (limit == 0) {
+        return 0;
+    }
+#if UPRV_HAVE_SSE2
+    // SSE2 has only signed 16-bit comparisons; use unsigned saturation instead.
+    const __m128i max = _mm_set1_epi16((short)(limit - 1));
+    const __m128i zero = _mm_setzero_si128();
+    while (i + 8 <= length) {
+        __m128i v = _mm_subs_epu16(_mm_loadu_si128((const __m128i *)(s + i)), max);
+        int32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi16(v, zero)) ^ 0xffff;
+        if (mask != 0) {
+            return i + UPRV_CTZ16((uint32_t)mask) / 2;
+        }
+        i += 8;
+    }
+#elif UPRV_HAVE_NEON
+    const uint16x8_t lim = vdupq_n_u16(limit);
+    while (i + 8 <= length &&
+            vminvq_u16(vcltq_u16(vld1q_u16((const uint16_t *)(s + i)), lim)) != 0) {
+        i += 8;
+    }
+#else
+    (void)s;
+    (void)length;
+#endif
+    return i;
+}
+
+#endif  // __USIMD_H__
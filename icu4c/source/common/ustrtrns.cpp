@@ -34,6 +34,7 @@
 #include "cstring.h"
 #include "cmemory.h"
 #include "ustr_imp.h"
+#include "usimd.h"
 #include "uassert.h"
 
 U_CAPI UChar* U_EXPORT2 
@@ -403,6 +404,13 @@ u_strFromUTF8WithSub(UChar *dest,
                 c = (uint8_t)src[i++];
                 if(U8_IS_SINGLE(c)) {
                     *pDest++=(UChar)c;
+                    if(count > 16) {
+                        /* copy a following run of ASCII characters in vector-sized blocks */
+                        int32_t n = uprv_copyASCIIToUTF16((const uint8_t *)src + i, pDest, count - 1);
+                        i += n;
+                        pDest += n;
+                        count -= n;
+                    }
                 } else {
                     uint8_t __t1, __t2;
                     if( /* handle U+0800..U+FFFF inline */
@@ -491,7 +499,9 @@ u_strFromUTF8WithSub(UChar *dest,
             // modified copy of U8_NEXT()
             c = (uint8_t)src[i++];
             if(U8_IS_SINGLE(c)) {
-                ++reqLength;
+                int32_t n = uprv_skipASCII((const uint8_t *)src + i, srcLength - i);
+                i += n;
+                reqLength += 1 + n;
             } else {
                 uint8_t __t1, __t2;
                 if( /* handle U+0800..U+FFFF inline */
@@ -767,6 +777,77 @@ u_strFromUTF8Lenient(UChar *dest,
     return dest;
 }
 
+U_CAPI UBool U_EXPORT2
+u_validateUTF8(const char *s, int32_t length, int32_t *pErrorIndex, UErrorCode *pErrorCode) {
+    if(U_FAILURE(*pErrorCode)) {
+        return FALSE;
+    }
+    if((s==NULL && length!=0) || length<-1) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return FALSE;
+    }
+    if(length<0) {
+        length=(int32_t)uprv_strlen(s);
+    }
+    const uint8_t *p=(const uint8_t *)s;
+    int32_t i=0;
+    while(i<length) {
+        if(U8_IS_SINGLE(p[i])) {
+            /* skip a run of ASCII in vector-sized blocks */
+            ++i;
+            i+=uprv_skipASCII(p+i, length-i);
+            continue;
+        }
+        int32_t start=i;
+        UChar32 c;
+        U8_NEXT(p, i, length, c);
+        if(c<0) {
+            if(pErrorIndex!=NULL) {
+                *pErrorIndex=start;
+            }
+            return FALSE;
+        }
+    }
+    if(pErrorIndex!=NULL) {
+        *pErrorIndex=-1;
+    }
+    return TRUE;
+}
+
+U_CAPI UBool U_EXPORT2
+u_validateUTF16(const UChar *s, int32_t length, int32_t *pErrorIndex, UErrorCode *pErrorCode) {
+    if(U_FAILURE(*pErrorCode)) {
+        return FALSE;
+    }
+    if((s==NULL && length!=0) || length<-1) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return FALSE;
+    }
+    if(length<0) {
+        length=u_strlen(s);
+    }
+    int32_t i=0;
+    while(i<length) {
+        UChar c=s[i];
+        if(!U16_IS_SURROGATE(c)) {
+            /* skip a run of non-surrogates in vector-sized blocks */
+            ++i;
+            i+=uprv_skipNonSurrogates(s+i, length-i);
+        } else if(U16_IS_SURROGATE_LEAD(c) && (i+1)<length && U16_IS_TRAIL(s[i+1])) {
+            i+=2;
+        } else {
+            if(pErrorIndex!=NULL) {
+                *pErrorIndex=i;
+            }
+            return FALSE;
+        }
+    }
+    if(pErrorIndex!=NULL) {
+        *pErrorIndex=-1;
+    }
+    return TRUE;
+}
+
 static inline uint8_t *
 _appendUTF8(uint8_t *pDest, UChar32 c) {
     /* it is 0<=c<=0x10ffff and not a surrogate if called by a validating function */
@@ -921,6 +1002,13 @@ u_strToUTF8WithSub(char *dest,
                 ch=*pSrc++;
                 if(ch <= 0x7f) {
                     *pDest++ = (uint8_t)ch;
+                    if(count > 16) {
+                        /* copy a following run of ASCII characters in vector-sized blocks */
+                        int32_t n = uprv_copyASCIIToUTF8(pSrc, pDest, count - 1);
+                        pSrc += n;
+                        pDest += n;
+                        count -= n;
+                    }
                 } else if(ch <= 0x7ff) {
                     *pDest++=(uint8_t)((ch>>6)|0xc0);
                     *pDest++=(uint8_t)((ch&0x3f)|0x80);
@@ -207,6 +207,11 @@ SharedCalendar::~SharedCalendar() {
     delete ptr;
 }
 
+int32_t SharedCalendar::getMemoryFootprint() const {
+    // Rough estimate: Calendar subclasses add little to a GregorianCalendar.
+    return (int32_t) (sizeof(SharedCalendar) + sizeof(GregorianCalendar));
+}
+
 template<> U_I18N_API
 const SharedCalendar *LocaleCacheKey<SharedCalendar>::createObject(
         const void * /*unusedCreationContext*/, UErrorCode &status) const {
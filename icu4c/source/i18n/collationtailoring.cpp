@@ -104,10 +104,37 @@ CollationTailoring::getUCAVersion() const {
     return ((int32_t)version[1] << 4) | (version[2] >> 6);
 }
 
+int32_t
+CollationTailoring::getMemoryFootprint() const {
+    int32_t size = (int32_t)sizeof(CollationTailoring) + rules.length() * U_SIZEOF_UCHAR;
+    if(ownedData != NULL) {
+        size += (int32_t)sizeof(CollationData);
+        if(builder != NULL) {
+            // Built from rules: The data arrays and the trie are on the heap.
+            // Otherwise they point into loaded binary data.
+            size += ownedData->ce32sLength * 4 + ownedData->cesLength * 8 +
+                    ownedData->contextsLength * U_SIZEOF_UCHAR +
+                    ownedData->fastLatinTableLength * 2;
+            if(trie != NULL) {
+                UErrorCode errorCode = U_ZERO_ERROR;
+                size += utrie2_serialize(trie, NULL, 0, &errorCode);
+            }
+        }
+    }
+    return size;
+}
+
 CollationCacheEntry::~CollationCacheEntry() {
     SharedObject::clearPtr(tailoring);
 }
 
+int32_t
+CollationCacheEntry::getMemoryFootprint() const {
+    // A tailoring shared by several entries is counted for each of them.
+    return (int32_t)sizeof(CollationCacheEntry) +
+            (tailoring != NULL ? tailoring->getMemoryFootprint() : 0);
+}
+
 U_NAMESPACE_END
 
 #endif  // !UCONFIG_NO_COLLATION
@@ -60,6 +60,8 @@ struct U_I18N_API CollationTailoring : public SharedObject {
     void setVersion(const UVersionInfo baseVersion, const UVersionInfo rulesVersion);
     int32_t getUCAVersion() const;
 
+    virtual int32_t getMemoryFootprint() const;
+
     // data for sorting etc.
     const CollationData *data;  // == base data or ownedData
     const CollationSettings *settings;  // reference-counted
@@ -100,6 +102,7 @@ struct CollationCacheEntry : public SharedObject {
         }
     }
     ~CollationCacheEntry();
+    virtual int32_t getMemoryFootprint() const;
 
     Locale validLocale;
     const CollationTailoring *tailoring;
@@ -53,11 +53,16 @@ class U_I18N_API DateFmtBestPattern : public SharedObject {
     DateFmtBestPattern(const UnicodeString &pattern)
             : fPattern(pattern) { }
     ~DateFmtBestPattern();
+    virtual int32_t getMemoryFootprint() const;
 };
 
 DateFmtBestPattern::~DateFmtBestPattern() {
 }
 
+int32_t DateFmtBestPattern::getMemoryFootprint() const {
+    return (int32_t) sizeof(DateFmtBestPattern) + fPattern.length() * U_SIZEOF_UCHAR;
+}
+
 template<> U_I18N_API
 const DateFmtBestPattern *LocaleCacheKey<DateFmtBestPattern>::createObject(
         const void * /*creationContext*/, UErrorCode &status) const {
@@ -169,6 +169,52 @@ U_NAMESPACE_BEGIN
 SharedDateFormatSymbols::~SharedDateFormatSymbols() {
 }
 
+static int32_t stringArrayFootprint(const UnicodeString *array, int32_t count) {
+    int32_t size = count * (int32_t) sizeof(UnicodeString);
+    for (int32_t i = 0; i < count; ++i) {
+        size += array[i].length() * U_SIZEOF_UCHAR;
+    }
+    return size;
+}
+
+int32_t SharedDateFormatSymbols::getMemoryFootprint() const {
+    // Estimate from the string arrays; the lazily loaded zone strings
+    // are not included.
+    int32_t size = (int32_t) sizeof(SharedDateFormatSymbols);
+    int32_t count;
+    const UnicodeString *array = dfs.getEras(count);
+    size += stringArrayFootprint(array, count);
+    array = dfs.getEraNames(count);
+    size += stringArrayFootprint(array, count);
+    array = dfs.getNarrowEras(count);
+    size += stringArrayFootprint(array, count);
+    array = dfs.getAmPmStrings(count);
+    size += stringArrayFootprint(array, count);
+    static const DateFormatSymbols::DtContextType contexts[] = {
+        DateFormatSymbols::FORMAT, DateFormatSymbols::STANDALONE
+    };
+    static const DateFormatSymbols::DtWidthType widths[] = {
+        DateFormatSymbols::ABBREVIATED, DateFormatSymbols::WIDE,
+        DateFormatSymbols::NARROW, DateFormatSymbols::SHORT
+    };
+    for (int32_t c = 0; c < UPRV_LENGTHOF(contexts); ++c) {
+        for (int32_t w = 0; w < UPRV_LENGTHOF(widths); ++w) {
+            array = dfs.getWeekdays(count, contexts[c], widths[w]);
+            size += stringArrayFootprint(array, count);
+            if (widths[w] == DateFormatSymbols::SHORT) {
+                continue;  // Only weekdays have a SHORT width.
+            }
+            array = dfs.getMonths(count, contexts[c], widths[w]);
+            size += stringArrayFootprint(array, count);
+            if (widths[w] != DateFormatSymbols::NARROW) {
+                array = dfs.getQuarters(count, contexts[c], widths[w]);
+                size += stringArrayFootprint(array, count);
+            }
+        }
+    }
+    return size;
+}
+
 template<> U_I18N_API
 const SharedDateFormatSymbols *
         LocaleCacheKey<SharedDateFormatSymbols>::createObject(
@@ -117,6 +117,7 @@ class MeasureFormatCacheData : public SharedObject {
 
     MeasureFormatCacheData();
     virtual ~MeasureFormatCacheData();
+    virtual int32_t getMemoryFootprint() const;
 
     UBool hasPerFormatter(int32_t width) const {
         // TODO: Create a more obvious way to test if the per-formatter has been set?
@@ -168,6 +169,21 @@ MeasureFormatCacheData::MeasureFormatCacheData()
     memset(currencyFormats, 0, sizeof(currencyFormats));
 }
 
+int32_t MeasureFormatCacheData::getMemoryFootprint() const {
+    // Rough estimate: the pattern formatters, not their strings nor the number formats.
+    int32_t size = (int32_t) sizeof(MeasureFormatCacheData);
+    for (int32_t i = 0; i < MEAS_UNIT_COUNT; ++i) {
+        for (int32_t j = 0; j < WIDTH_INDEX_COUNT; ++j) {
+            for (int32_t k = 0; k < PATTERN_COUNT; ++k) {
+                if (patterns[i][j][k] != nullptr) {
+                    size += (int32_t) sizeof(SimpleFormatter);
+                }
+            }
+        }
+    }
+    return size;
+}
+
 MeasureFormatCacheData::~MeasureFormatCacheData() {
     for (int32_t i = 0; i < UPRV_LENGTHOF(currencyFormats); ++i) {
         delete currencyFormats[i];
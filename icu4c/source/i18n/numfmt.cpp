@@ -252,6 +252,13 @@ SharedNumberFormat::~SharedNumberFormat() {
     delete ptr;
 }
 
+int32_t SharedNumberFormat::getMemoryFootprint() const {
+    // Rough estimate: Nearly all cached formats are DecimalFormats,
+    // dominated by the symbols they own.
+    return (int32_t) (sizeof(SharedNumberFormat) +
+                      sizeof(DecimalFormat) + sizeof(DecimalFormatSymbols));
+}
+
 // -------------------------------------
 // copy constructor
 
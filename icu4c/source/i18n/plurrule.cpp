@@ -86,6 +86,12 @@ SharedPluralRules::~SharedPluralRules() {
     delete ptr;
 }
 
+int32_t SharedPluralRules::getMemoryFootprint() const {
+    // Rough estimate: A typical rule set has a handful of short rules.
+    return (int32_t) (sizeof(SharedPluralRules) + sizeof(PluralRules) +
+                      4 * sizeof(RuleChain));
+}
+
 PluralRules*
 PluralRules::clone() const {
     PluralRules* newObj = new PluralRules(*this);
@@ -66,6 +66,7 @@ class RelativeDateTimeCacheData: public SharedObject {
         }
     }
     virtual ~RelativeDateTimeCacheData();
+    virtual int32_t getMemoryFootprint() const;
 
     // no numbers: e.g Next Tuesday; Yesterday; etc.
     UnicodeString absoluteUnits[UDAT_STYLE_COUNT][UDAT_ABSOLUTE_UNIT_COUNT][UDAT_DIRECTION_COUNT];
@@ -104,6 +105,28 @@ class RelativeDateTimeCacheData: public SharedObject {
             const RelativeDateTimeCacheData &other);
 };
 
+int32_t RelativeDateTimeCacheData::getMemoryFootprint() const {
+    int32_t size = (int32_t) sizeof(RelativeDateTimeCacheData);
+    for (int32_t style = 0; style < UDAT_STYLE_COUNT; ++style) {
+        for (int32_t absUnit = 0; absUnit < UDAT_ABSOLUTE_UNIT_COUNT; ++absUnit) {
+            for (int32_t dir = 0; dir < UDAT_DIRECTION_COUNT; ++dir) {
+                size += absoluteUnits[style][absUnit][dir].length() * U_SIZEOF_UCHAR;
+            }
+        }
+        for (int32_t relUnit = 0; relUnit < UDAT_RELATIVE_UNIT_COUNT; ++relUnit) {
+            for (int32_t pl = 0; pl < StandardPlural::COUNT; ++pl) {
+                if (relativeUnitsFormatters[style][relUnit][0][pl] != NULL) {
+                    size += (int32_t) sizeof(SimpleFormatter);
+                }
+                if (relativeUnitsFormatters[style][relUnit][1][pl] != NULL) {
+                    size += (int32_t) sizeof(SimpleFormatter);
+                }
+            }
+        }
+    }
+    return size;
+}
+
 RelativeDateTimeCacheData::~RelativeDateTimeCacheData() {
     // clear out the cache arrays
     for (int32_t style = 0; style < UDAT_STYLE_COUNT; ++style) {
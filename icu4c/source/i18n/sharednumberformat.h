@@ -22,6 +22,7 @@ class U_I18N_API SharedNumberFormat : public SharedObject {
 public:
     SharedNumberFormat(NumberFormat *nfToAdopt) : ptr(nfToAdopt) { }
     virtual ~SharedNumberFormat();
+    virtual int32_t getMemoryFootprint() const;
     const NumberFormat *get() const { return ptr; }
     const NumberFormat *operator->() const { return ptr; }
     const NumberFormat &operator*() const { return *ptr; }
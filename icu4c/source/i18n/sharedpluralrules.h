@@ -22,6 +22,7 @@ class U_I18N_API SharedPluralRules : public SharedObject {
 public:
     SharedPluralRules(PluralRules *prToAdopt) : ptr(prToAdopt) { }
     virtual ~SharedPluralRules();
+    virtual int32_t getMemoryFootprint() const;
     const PluralRules *operator->() const { return ptr; }
     const PluralRules &operator*() const { return *ptr; }
 private:
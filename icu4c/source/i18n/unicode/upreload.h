@@ -0,0 +1,107 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+#ifndef __UPRELOAD_H__
+#define __UPRELOAD_H__
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_FORMATTING
+
+#include "unicode/uexecutor.h"
+
+/**
+ * \file
+ * \brief C API: Preloading locale data into ICU's caches.
+ *
+ * The first use of a locale makes ICU load resource bundles and build
+ * objects such as number formatting symbols, plural rules and collation
+ * tailorings, which are then cached for later uses.
+ * A server can call upreload_preloadLocales() at startup so that this cost
+ * is not paid while handling its first requests for each locale.
+ *
+ * Preloading only fills caches; it does not change any results.
+ * Cached objects may later be evicted according to the cache policy,
+ * see unicode/ucache.h.
+ */
+
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * Bit flags for the kinds of data that upreload_preloadLocales() loads.
+ * @draft ICU 63
+ */
+typedef enum UPreloadService {
+    /**
+     * The locale's main, language, region, currency, time zone and unit
+     * resource bundles, including their parent bundles.
+     * @draft ICU 63
+     */
+    UPRELOAD_RESOURCE_BUNDLES = 1,
+    /**
+     * The decimal number format and its symbols.
+     * @draft ICU 63
+     */
+    UPRELOAD_NUMBER_FORMAT = 2,
+    /**
+     * The cardinal plural rules.
+     * @draft ICU 63
+     */
+    UPRELOAD_PLURAL_RULES = 4,
+    /**
+     * The default calendar and the date format symbols.
+     * @draft ICU 63
+     */
+    UPRELOAD_DATE_FORMAT = 8,
+    /**
+     * The resource data used by the date-time pattern generator.
+     * @draft ICU 63
+     */
+    UPRELOAD_DATE_TIME_PATTERN_GENERATOR = 0x10,
+    /**
+     * The default collation tailoring.
+     * @draft ICU 63
+     */
+    UPRELOAD_COLLATOR = 0x20,
+    /**
+     * All of the above.
+     * @draft ICU 63
+     */
+    UPRELOAD_ALL = 0x3f
+} UPreloadService;
+
+/**
+ * Loads the data for the given locales into ICU's caches.
+ *
+ * Without an executor, the data is loaded before this function returns,
+ * and all locales are attempted even if some of them fail.
+ * *pErrorCode is then set to the first failure, if any.
+ *
+ * With an executor, one task per locale is submitted to it and
+ * this function returns without waiting for the tasks.
+ * Failures while loading are then ignored; only failures to submit the
+ * tasks are reported. The locale IDs are copied; the caller need not keep
+ * them alive.
+ *
+ * A NULL locale ID stands for the default locale at the time of the call,
+ * with or without an executor.
+ *
+ * @param locales array of locale IDs
+ * @param count number of locale IDs
+ * @param services bit set of UPreloadService values
+ * @param executor the executor for the loading tasks, or NULL to load
+ *        on the calling thread
+ * @param executorContext context pointer passed to the executor
+ * @param pErrorCode ICU error code
+ * @draft ICU 63
+ */
+U_CAPI void U_EXPORT2
+upreload_preloadLocales(const char * const *locales, int32_t count, uint32_t services,
+                        UExecutorFn *executor, const void *executorContext,
+                        UErrorCode *pErrorCode);
+
+#endif  // U_HIDE_DRAFT_API
+
+#endif  // !UCONFIG_NO_FORMATTING
+
+#endif  // __UPRELOAD_H__
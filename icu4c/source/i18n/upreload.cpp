@@ -0,0 +1,142 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// upreload.cpp
+// Loads locale data into ICU's caches ahead of first use.
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_FORMATTING
+
+#include "unicode/upreload.h"
+#include "unicode/calendar.h"
+#include "unicode/dtfmtsym.h"
+#include "unicode/dtptngen.h"
+#include "unicode/locid.h"
+#include "unicode/numfmt.h"
+#include "unicode/plurrule.h"
+#include "unicode/uloc.h"
+#include "unicode/ures.h"
+#include "charstr.h"
+#include "collationtailoring.h"
+#include "sharedpluralrules.h"
+#include "sharednumberformat.h"
+#include "ucol_imp.h"
+#include "ureslocs.h"
+
+U_NAMESPACE_USE
+
+namespace {
+
+const char *const gResourceTrees[] = {
+    NULL, U_ICUDATA_LANG, U_ICUDATA_REGION, U_ICUDATA_CURR, U_ICUDATA_ZONE, U_ICUDATA_UNIT
+};
+
+// Keeps the first failure.
+void updateError(UErrorCode localErrorCode, UErrorCode &errorCode) {
+    if (U_FAILURE(localErrorCode) && U_SUCCESS(errorCode)) {
+        errorCode = localErrorCode;
+    }
+}
+
+void preloadLocale(const char *localeID, uint32_t services, UErrorCode &errorCode) {
+    Locale locale(localeID);
+    if (locale.isBogus()) {
+        updateError(U_ILLEGAL_ARGUMENT_ERROR, errorCode);
+        return;
+    }
+    if (services & UPRELOAD_RESOURCE_BUNDLES) {
+        // Closed bundles stay in the resource bundle cache.
+        for (int32_t i = 0; i < UPRV_LENGTHOF(gResourceTrees); ++i) {
+            UErrorCode localErrorCode = U_ZERO_ERROR;
+            ures_close(ures_open(gResourceTrees[i], localeID, &localErrorCode));
+            updateError(localErrorCode, errorCode);
+        }
+    }
+    if (services & UPRELOAD_NUMBER_FORMAT) {
+        UErrorCode localErrorCode = U_ZERO_ERROR;
+        const SharedNumberFormat *shared =
+            NumberFormat::createSharedInstance(locale, UNUM_DECIMAL, localErrorCode);
+        SharedObject::clearPtr(shared);
+        updateError(localErrorCode, errorCode);
+    }
+    if (services & UPRELOAD_PLURAL_RULES) {
+        UErrorCode localErrorCode = U_ZERO_ERROR;
+        const SharedPluralRules *shared =
+            PluralRules::createSharedInstance(locale, UPLURAL_TYPE_CARDINAL, localErrorCode);
+        SharedObject::clearPtr(shared);
+        updateError(localErrorCode, errorCode);
+    }
+    if (services & UPRELOAD_DATE_FORMAT) {
+        // Creating the calendar loads its type and week data into the bundle cache.
+        UErrorCode localErrorCode = U_ZERO_ERROR;
+        delete Calendar::createInstance(locale, localErrorCode);
+        delete DateFormatSymbols::createForLocale(locale, localErrorCode);
+        updateError(localErrorCode, errorCode);
+    }
+    if (services & UPRELOAD_DATE_TIME_PATTERN_GENERATOR) {
+        // The generator itself is not cached, but the bundles it reads are.
+        UErrorCode localErrorCode = U_ZERO_ERROR;
+        delete DateTimePatternGenerator::createInstance(locale, localErrorCode);
+        updateError(localErrorCode, errorCode);
+    }
+#if !UCONFIG_NO_COLLATION
+    if (services & UPRELOAD_COLLATOR) {
+        UErrorCode localErrorCode = U_ZERO_ERROR;
+        const CollationCacheEntry *entry = CollationLoader::loadTailoring(locale, localErrorCode);
+        SharedObject::clearPtr(entry);
+        updateError(localErrorCode, errorCode);
+    }
+#endif
+}
+
+class PreloadTask : public UMemory {
+public:
+    PreloadTask(const char *localeID, uint32_t svcs, UErrorCode &errorCode)
+            : services(svcs) {
+        // Like Locale(NULL) on the calling thread: the default locale at the time of the call.
+        id.append(localeID != NULL ? localeID : uloc_getDefault(), errorCode);
+    }
+
+    CharString id;
+    uint32_t services;
+};
+
+void U_CALLCONV runPreloadTask(void *task) {
+    PreloadTask *preloadTask = static_cast<PreloadTask *>(task);
+    UErrorCode errorCode = U_ZERO_ERROR;
+    preloadLocale(preloadTask->id.data(), preloadTask->services, errorCode);
+    delete preloadTask;
+}
+
+}  // namespace
+
+U_CAPI void U_EXPORT2
+upreload_preloadLocales(const char * const *locales, int32_t count, uint32_t services,
+                        UExecutorFn *executor, const void *executorContext,
+                        UErrorCode *pErrorCode) {
+    if (U_FAILURE(*pErrorCode)) {
+        return;
+    }
+    if (count < 0 || (locales == NULL && count > 0) || (services & ~UPRELOAD_ALL) != 0) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    for (int32_t i = 0; i < count; ++i) {
+        if (executor == NULL) {
+            preloadLocale(locales[i], services, *pErrorCode);
+            continue;
+        }
+        PreloadTask *task = new PreloadTask(locales[i], services, *pErrorCode);
+        if (task == NULL) {
+            *pErrorCode = U_MEMORY_ALLOCATION_ERROR;
+        }
+        if (U_FAILURE(*pErrorCode)) {
+            delete task;
+            return;
+        }
+        executor(executorContext, runPreloadTask, task);
+    }
+}
+
+#endif  // !UCONFIG_NO_FORMATTING
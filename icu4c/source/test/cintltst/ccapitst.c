@@ -54,6 +54,7 @@ cnv_open(const char *name, UErrorCode *pErrorCode) {
 static void ListNames(void);
 static void TestFlushCache(void);
 static void TestDuplicateAlias(void);
+static void TestAliasSpellings(void);
 static void TestCCSID(void);
 static void TestJ932(void);
 static void TestJ1968(void);
@@ -65,11 +66,15 @@ static void TestLMBCSMaxChar(void);
 static void TestConvertSafeCloneCallback(void);
 #endif
 
+static void TestConverterPool(void);
+
 static void TestEBCDICSwapLFNL(void);
 static void TestConvertEx(void);
 static void TestConvertExFromUTF8(void);
 static void TestConvertExFromUTF8_C5F0(void);
+static void TestConvertExToUTF8(void);
 static void TestConvertAlgorithmic(void);
+static void TestConvertBulk(void);
        void TestDefaultConverterError(void);    /* defined in cctest.c */
        void TestDefaultConverterSet(void);    /* defined in cctest.c */
 static void TestToUCountPending(void);
@@ -90,10 +95,12 @@ void addTestConvert(TestNode** root)
     addTest(root, &TestFlushCache,              "tsconv/ccapitst/TestFlushCache"); 
     addTest(root, &TestAlias,                   "tsconv/ccapitst/TestAlias"); 
     addTest(root, &TestDuplicateAlias,          "tsconv/ccapitst/TestDuplicateAlias"); 
+    addTest(root, &TestAliasSpellings,          "tsconv/ccapitst/TestAliasSpellings");
     addTest(root, &TestConvertSafeClone,        "tsconv/ccapitst/TestConvertSafeClone");
 #if !UCONFIG_NO_LEGACY_CONVERSION
     addTest(root, &TestConvertSafeCloneCallback,"tsconv/ccapitst/TestConvertSafeCloneCallback");
 #endif
+    addTest(root, &TestConverterPool,           "tsconv/ccapitst/TestConverterPool");
     addTest(root, &TestCCSID,                   "tsconv/ccapitst/TestCCSID"); 
     addTest(root, &TestJ932,                    "tsconv/ccapitst/TestJ932");
     addTest(root, &TestJ1968,                   "tsconv/ccapitst/TestJ1968");
@@ -104,7 +111,9 @@ void addTestConvert(TestNode** root)
     addTest(root, &TestConvertEx,               "tsconv/ccapitst/TestConvertEx");
     addTest(root, &TestConvertExFromUTF8,       "tsconv/ccapitst/TestConvertExFromUTF8");
     addTest(root, &TestConvertExFromUTF8_C5F0,  "tsconv/ccapitst/TestConvertExFromUTF8_C5F0");
+    addTest(root, &TestConvertExToUTF8,         "tsconv/ccapitst/TestConvertExToUTF8");
     addTest(root, &TestConvertAlgorithmic,      "tsconv/ccapitst/TestConvertAlgorithmic");
+    addTest(root, &TestConvertBulk,             "tsconv/ccapitst/TestConvertBulk");
     addTest(root, &TestDefaultConverterError,   "tsconv/ccapitst/TestDefaultConverterError");
     addTest(root, &TestDefaultConverterSet,     "tsconv/ccapitst/TestDefaultConverterSet");
 #if !UCONFIG_NO_FILE_IO
@@ -1307,6 +1316,93 @@ static void TestAlias() {
 
 }
 
+/*
+ * Look up every alias in several spellings, each one twice,
+ * so that both the full lookup and the cache of recent names are used.
+ */
+static void TestAliasSpellings(void) {
+    static const char *const badNames[] = {
+        "", "-", "utf-8x", "xutf-8", "utf-9", "no-such-charset", "UTF-8-8"
+    };
+    UErrorCode status = U_ZERO_ERROR;
+    int32_t i, ncnv = ucnv_countAvailable();
+
+    for (i = 0; i < ncnv; ++i) {
+        const char *name = ucnv_getAvailableName(i);
+        uint16_t j, na = ucnv_countAliases(name, &status);
+        for (j = 0; j < na; ++j) {
+            const char *alias = ucnv_getAlias(name, j, &status);
+            const char *expected;
+            char spellings[4][UCNV_MAX_CONVERTER_NAME_LENGTH + 2];
+            int32_t k, length;
+
+            if (U_FAILURE(status) || alias == NULL) {
+                log_err("ucnv_getAlias(%s, %d) failed - %s\n", name, j, u_errorName(status));
+                status = U_ZERO_ERROR;
+                continue;
+            }
+            length = (int32_t)strlen(alias);
+            if (length >= UCNV_MAX_CONVERTER_NAME_LENGTH) {
+                continue;
+            }
+            status = U_ZERO_ERROR;
+            expected = ucnv_getAlias(alias, 0, &status);
+
+            /* upper case, lower case, and with a separator that ucnv_compareNames() ignores */
+            strcpy(spellings[0], alias);
+            for (k = 0; k <= length; ++k) {
+                spellings[1][k] = (char)toupper((unsigned char)alias[k]);
+                spellings[2][k] = (char)tolower((unsigned char)alias[k]);
+            }
+            spellings[3][0] = '_';
+            strcpy(spellings[3] + 1, alias);
+
+            for (k = 0; k < 2 * UPRV_LENGTHOF(spellings); ++k) {
+                const char *spelling = spellings[k / 2];
+                const char *actual;
+                uint16_t m, count;
+                status = U_ZERO_ERROR;
+                actual = ucnv_getAlias(spelling, 0, &status);
+                if (actual == NULL || expected == NULL || strcmp(actual, expected) != 0) {
+                    log_err("ucnv_getAlias(%s, 0) = %s instead of %s (like for %s) - %s\n",
+                            spelling, actual, expected, alias, u_errorName(status));
+                }
+                /* The converter that was found must have this alias. */
+                count = ucnv_countAliases(spelling, &status);
+                for (m = 0; m < count; ++m) {
+                    if (ucnv_compareNames(ucnv_getAlias(spelling, m, &status), alias) == 0) {
+                        break;
+                    }
+                }
+                if (m == count) {
+                    log_err("%s resolves to %s which does not have the alias %s\n", spelling, actual, alias);
+                }
+            }
+        }
+    }
+
+    for (i = 0; i < UPRV_LENGTHOF(badNames); ++i) {
+        const char *actual;
+        int32_t k;
+        for (k = 0; k < 2; ++k) {
+            status = U_ZERO_ERROR;
+            actual = ucnv_getAlias(badNames[i], 0, &status);
+            if (actual != NULL) {
+                log_err("ucnv_getAlias(%s, 0) = %s instead of NULL\n", badNames[i], actual);
+            }
+        }
+    }
+
+    /* An ambiguous alias must be reported as such every time. */
+    for (i = 0; i < 2; ++i) {
+        status = U_ZERO_ERROR;
+        if (ucnv_getStandardName("Shift_JIS", "IBM", &status) == NULL || status != U_AMBIGUOUS_ALIAS_WARNING) {
+            log_data_err("ucnv_getStandardName(Shift_JIS, IBM) did not set U_AMBIGUOUS_ALIAS_WARNING - %s\n",
+                         u_errorName(status));
+        }
+    }
+}
+
 static void TestDuplicateAlias(void) {
     const char *alias;
     UErrorCode status = U_ZERO_ERROR;
@@ -1889,6 +1985,119 @@ static void TestConvertSafeClone()
     }
 }
 
+static void TestConverterPool() {
+    UErrorCode errorCode = U_ZERO_ERROR;
+    UConverterPool *pool;
+    UConverter *cnv, *cnv2;
+
+    /* argument checking */
+    pool = ucnv_openPool(-1, &errorCode);
+    if(pool != NULL || errorCode != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("ucnv_openPool(-1) did not fail with U_ILLEGAL_ARGUMENT_ERROR - %s\n", u_errorName(errorCode));
+    }
+    errorCode = U_ZERO_ERROR;
+    cnv = ucnv_acquireFromPool(NULL, "UTF-8", &errorCode);
+    if(cnv != NULL || errorCode != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("ucnv_acquireFromPool(NULL pool) did not fail with U_ILLEGAL_ARGUMENT_ERROR - %s\n", u_errorName(errorCode));
+    }
+    ucnv_closePool(NULL);
+    ucnv_releaseToPool(NULL, NULL);
+
+    errorCode = U_ZERO_ERROR;
+    pool = ucnv_openPool(2, &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_data_err("ucnv_openPool(2) failed - %s\n", u_errorName(errorCode));
+        return;
+    }
+    cnv = ucnv_acquireFromPool(pool, "no-such-converter", &errorCode);
+    if(cnv != NULL || errorCode != U_FILE_ACCESS_ERROR) {
+        log_err("ucnv_acquireFromPool(no-such-converter) did not fail with U_FILE_ACCESS_ERROR - %s\n", u_errorName(errorCode));
+    }
+
+    /* Different aliases of the same converter get the same idle converter. */
+    errorCode = U_ZERO_ERROR;
+    cnv = ucnv_acquireFromPool(pool, "UTF-8", &errorCode);
+    ucnv_releaseToPool(pool, cnv);
+    cnv2 = ucnv_acquireFromPool(pool, "utf8", &errorCode);
+    if(U_FAILURE(errorCode) || cnv2 != cnv) {
+        log_err("ucnv_acquireFromPool(utf8) did not reuse the UTF-8 converter - %s\n", u_errorName(errorCode));
+    }
+    ucnv_close(cnv2);
+
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    {
+        static const char bytes[] = { 0x41, (char)0x82 };
+        UChar uchars[8];
+        UChar *target;
+        const char *source;
+        UConverterToUCallback toUAction;
+        const void *toUContext;
+        UConverter *cnv3;
+
+        /* Partial characters are dropped when a converter goes back into the pool. */
+        cnv = ucnv_acquireFromPool(pool, "Shift_JIS", &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_data_err("ucnv_acquireFromPool(Shift_JIS) failed - %s\n", u_errorName(errorCode));
+            ucnv_closePool(pool);
+            return;
+        }
+        target = uchars;
+        source = bytes;
+        ucnv_toUnicode(cnv, &target, uchars + UPRV_LENGTHOF(uchars), &source, bytes + 2, NULL, FALSE, &errorCode);
+        if(U_FAILURE(errorCode) || ucnv_toUCountPending(cnv, &errorCode) != 1) {
+            log_err("Shift_JIS converter did not keep a partial character - %s\n", u_errorName(errorCode));
+        }
+        ucnv_releaseToPool(pool, cnv);
+        cnv2 = ucnv_acquireFromPool(pool, "shift-jis", &errorCode);
+        if(U_FAILURE(errorCode) || cnv2 != cnv) {
+            log_err("ucnv_acquireFromPool(shift-jis) did not reuse the Shift_JIS converter - %s\n", u_errorName(errorCode));
+        } else if(ucnv_toUCountPending(cnv2, &errorCode) != 0) {
+            log_err("ucnv_releaseToPool() did not reset the converter\n");
+        }
+
+        /* Canonical names with options match too. */
+        cnv3 = ucnv_acquireFromPool(pool, "ISO-2022-JP", &errorCode);
+        ucnv_releaseToPool(pool, cnv3);
+        cnv = ucnv_acquireFromPool(pool, "csISO2022JP", &errorCode);
+        if(U_FAILURE(errorCode) || cnv != cnv3) {
+            log_err("ucnv_acquireFromPool(csISO2022JP) did not reuse the ISO-2022-JP converter - %s\n", u_errorName(errorCode));
+        }
+        ucnv_close(cnv);
+
+        /* A converter with a changed callback is not kept. */
+        ucnv_setToUCallBack(cnv2, UCNV_TO_U_CALLBACK_STOP, NULL, NULL, NULL, &errorCode);
+        ucnv_releaseToPool(pool, cnv2);
+        cnv2 = ucnv_acquireFromPool(pool, "Shift_JIS", &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_err("ucnv_acquireFromPool(Shift_JIS) failed - %s\n", u_errorName(errorCode));
+        } else {
+            ucnv_getToUCallBack(cnv2, &toUAction, &toUContext);
+            if(toUAction != UCNV_TO_U_CALLBACK_SUBSTITUTE || toUContext != NULL) {
+                log_err("ucnv_acquireFromPool() returned a converter with a non-default callback\n");
+            }
+        }
+
+        /* The pool keeps at most 2 idle converters; the third one is closed. */
+        cnv = ucnv_acquireFromPool(pool, "windows-1252", &errorCode);
+        cnv3 = ucnv_acquireFromPool(pool, "ibm-1047,swaplfnl", &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_data_err("ucnv_acquireFromPool() failed - %s\n", u_errorName(errorCode));
+        }
+        ucnv_releaseToPool(pool, cnv);
+        ucnv_releaseToPool(pool, cnv2);
+        ucnv_releaseToPool(pool, cnv3);
+        if(ucnv_acquireFromPool(pool, "windows-1252", &errorCode) != cnv ||
+                ucnv_acquireFromPool(pool, "Shift_JIS", &errorCode) != cnv2) {
+            log_err("ucnv_acquireFromPool() did not return the first two released converters\n");
+        }
+        ucnv_close(cnv);
+        ucnv_releaseToPool(NULL, cnv2);
+    }
+#endif
+
+    ucnv_closePool(pool);
+}
+
 static void TestCCSID() {
 #if !UCONFIG_NO_LEGACY_CONVERSION
     UConverter *cnv;
@@ -2674,6 +2883,89 @@ static void TestConvertExFromUTF8() {
     ucnv_close(utf8Cnv);
 }
 
+/*
+ * Test direct conversion from codepages to UTF-8.
+ * The result must be the same as when pivoting through UTF-16,
+ * including for unassigned and illegal input and for stateful codepages.
+ */
+static void TestConvertExToUTF8() {
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    static const char *const converterNames[]={
+        "windows-1252",
+        "windows-1251",
+        "shift-jis",
+        "EUC-JP",
+        "GBK",
+        "gb18030",
+        "ibm-930",      /* EBCDIC stateful (SI/SO) */
+        "ibm-37"
+    };
+    static const UChar text[]={
+        0x61, 0x62, 0x63, 0xe9, 0x20, 0x410, 0x44f, 0x20, 0x3042, 0x30a2, 0x4e2d, 0x6587, 0x20,
+        0x452, 0x1e3f, 0x20ac, 0xd840, 0xdc00, 0xd83d, 0xde00, 0x48, 0x65, 0x6c, 0x6c, 0x6f,
+        0xff21, 0xff61, 0x5c, 0x7e, 0xa5, 0x203e, 0xa, 0xd, 0x31, 0x32, 0x33
+    };
+    /* appended to the codepage text to exercise unassigned and illegal sequences */
+    static const char badBytes[]={ (char)0x80, 0x41, (char)0xff, (char)0xfe, 0x42, (char)0xa0, (char)0x81 };
+
+    char bytes[2000], utf8[4000];
+    UChar utf16[2000];
+    int32_t bytesLength, utf16Length, utf8Length;
+    UConverter *utf8Cnv, *cnv;
+    UErrorCode errorCode;
+    int32_t i, j;
+
+    errorCode=U_ZERO_ERROR;
+    utf8Cnv=ucnv_open("UTF-8", &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_data_err("unable to open UTF-8 converter - %s\n", u_errorName(errorCode));
+        return;
+    }
+
+    for(i=0; i<UPRV_LENGTHOF(converterNames); ++i) {
+        errorCode=U_ZERO_ERROR;
+        cnv=ucnv_open(converterNames[i], &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_data_err("unable to open %s converter - %s\n", converterNames[i], u_errorName(errorCode));
+            continue;
+        }
+
+        /* the codepage text: several copies of the text with long ASCII runs, then bad bytes */
+        bytesLength=0;
+        for(j=0; j<8; ++j) {
+            bytesLength+=ucnv_fromUChars(cnv, bytes+bytesLength, (int32_t)sizeof(bytes)-bytesLength,
+                                         text, UPRV_LENGTHOF(text), &errorCode);
+            bytesLength+=ucnv_fromUChars(cnv, bytes+bytesLength, (int32_t)sizeof(bytes)-bytesLength,
+                                         text, 5+j*3, &errorCode);
+        }
+        memcpy(bytes+bytesLength, badBytes, sizeof(badBytes));
+        bytesLength+=(int32_t)sizeof(badBytes);
+
+        /* expected UTF-8: pivot through UTF-16 explicitly */
+        utf16Length=ucnv_toUChars(cnv, utf16, UPRV_LENGTHOF(utf16), bytes, bytesLength, &errorCode);
+        u_strToUTF8(utf8, (int32_t)sizeof(utf8), &utf8Length, utf16, utf16Length, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_err("%s: unable to prepare the test data - %s\n", converterNames[i], u_errorName(errorCode));
+            ucnv_close(cnv);
+            continue;
+        }
+
+        convertExMultiStreaming(cnv, utf8Cnv,
+                                bytes, bytesLength,
+                                utf8, utf8Length,
+                                converterNames[i],
+                                U_ZERO_ERROR);
+        convertExStreaming(cnv, utf8Cnv,
+                           bytes, bytesLength,
+                           utf8, utf8Length,
+                           CHUNK_SIZE, converterNames[i],
+                           U_ZERO_ERROR);
+        ucnv_close(cnv);
+    }
+    ucnv_close(utf8Cnv);
+#endif
+}
+
 static void TestConvertExFromUTF8_C5F0() {
     static const char *const converterNames[]={
 #if !UCONFIG_NO_LEGACY_CONVERSION
@@ -2889,6 +3181,313 @@ ucnv_close(cnv);
 #endif
 }
 
+typedef struct BulkExecutorCounter {
+    int32_t count;
+} BulkExecutorCounter;
+
+static void U_CALLCONV bulkExecutor(const void *context, UTaskFn *taskFn, void *task) {
+    ++((BulkExecutorCounter *)context)->count;
+    taskFn(task);
+}
+
+/* Converts in one ucnv_convertEx() call, for the expected ucnv_convertBulk() results. */
+static int32_t
+convertExAll(UConverter *targetCnv, UConverter *sourceCnv,
+             char *target, int32_t targetCapacity,
+             const char *source, int32_t sourceLength) {
+    UChar pivot[256];
+    UChar *pivotSource=pivot, *pivotTarget=pivot;
+    char *t=target;
+    UErrorCode errorCode=U_ZERO_ERROR;
+    ucnv_convertEx(targetCnv, sourceCnv, &t, target+targetCapacity,
+                   &source, source+sourceLength,
+                   pivot, &pivotSource, &pivotTarget, pivot+UPRV_LENGTHOF(pivot),
+                   TRUE, TRUE, &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_err("ucnv_convertEx(%s -> %s) failed - %s\n",
+                ucnv_getName(sourceCnv, &errorCode), ucnv_getName(targetCnv, &errorCode),
+                u_errorName(errorCode));
+        return -1;
+    }
+    return (int32_t)(t-target);
+}
+
+static void
+TestConvertBulk() {
+    static const struct {
+        const char *sourceName, *targetName;
+        const char *illegal;  /* appended to each copy of the text */
+        int32_t illegalLength;
+        UBool isSplittable;
+    } pairs[]={
+        { "UTF-8", "UTF-16LE", "\xe0\x41\xff\xf0\x9f\x98", 6, TRUE },
+        { "UTF-16BE", "UTF-8", "\xd8\x00\x00\x41\xdc", 5, TRUE },
+        { "UTF-32LE", "UTF-16BE", "\x00\x00\x11\x00", 4, TRUE },
+        { "ISO-8859-1", "UTF-32LE", "", 0, TRUE },
+        /* the UTF-16 variants with a BOM are not split */
+        { "UTF-8", "UnicodeBig", "", 0, FALSE },
+        { "UnicodeLittle", "UTF-8", "\xdc\x00", 2, FALSE },
+#if !UCONFIG_NO_LEGACY_CONVERSION
+        { "UTF-8", "windows-1252", "\xc0\xaf", 2, TRUE },
+        { "windows-1252", "UTF-8", "\x81\x8d", 2, TRUE },
+        { "Shift_JIS", "UTF-8", "\x81\x20\x82\xff\x83", 5, TRUE },
+        { "EUC-JP", "UTF-16LE", "\x8f\xa1\x41\xa4", 4, TRUE },
+        { "GB18030", "UTF-16BE", "\x81\x30\x81\x41\x81\x30", 6, TRUE },
+        { "UTF-16LE", "GB18030", "\x00\xdc", 2, TRUE },
+        { "ISO-2022-JP", "UTF-8", "\x1b\x24\x42\x30\x21", 5, FALSE },
+        { "UTF-8", "ISO-2022-JP", "", 0, FALSE },
+#endif
+    };
+    static const int32_t chunkLengths[]={ 1, 7, 100, 0 };
+    static const UChar textChars[]={
+        0x61, 0x62, 0x20, 0x0a, 0x31, 0xe9, 0x3b1, 0x4e00, 0x4e8c, 0x3042, 0x30a2,
+        0xff71, 0x20ac, 0xd83d  /* followed by 0xde00 */
+    };
+    UChar text[3000];
+    char *source, *expected, *target;
+    int32_t *offsets, *offsets2;
+    int32_t capacity=40000;
+    int32_t textLength, sourceLength, expectedLength, length, i, j, k;
+    uint32_t random=1;
+    UConverter *sourceCnv, *targetCnv;
+    BulkExecutorCounter counter;
+    UErrorCode errorCode;
+
+    /* text with a lone surrogate, which becomes a substitution or an illegal sequence */
+    for(textLength=0; textLength<UPRV_LENGTHOF(text)-1;) {
+        random=random*1103515245+12345;
+        i=(int32_t)((random>>16)%UPRV_LENGTHOF(textChars));
+        text[textLength++]=textChars[i];
+        if(textChars[i]==0xd83d) {
+            text[textLength++]=0xde00;
+        }
+    }
+    text[1000]=0xdc00;
+
+    source=(char *)malloc(capacity);
+    expected=(char *)malloc(capacity);
+    target=(char *)malloc(capacity);
+    offsets=(int32_t *)malloc(capacity*4);
+    offsets2=(int32_t *)malloc(capacity*4);
+    if(source==NULL || expected==NULL || target==NULL || offsets==NULL || offsets2==NULL) {
+        log_err("out of memory\n");
+        free(source); free(expected); free(target); free(offsets); free(offsets2);
+        return;
+    }
+
+    for(i=0; i<UPRV_LENGTHOF(pairs); ++i) {
+        errorCode=U_ZERO_ERROR;
+        sourceCnv=ucnv_open(pairs[i].sourceName, &errorCode);
+        targetCnv=ucnv_open(pairs[i].targetName, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_data_err("unable to open %s or %s converter - %s\n",
+                         pairs[i].sourceName, pairs[i].targetName, u_errorName(errorCode));
+            ucnv_close(sourceCnv);
+            ucnv_close(targetCnv);
+            continue;
+        }
+
+        /* source: text, illegal bytes, text, illegal bytes (truncated at the end) */
+        sourceLength=0;
+        for(j=0; j<2; ++j) {
+            sourceLength+=ucnv_fromUChars(sourceCnv, source+sourceLength, capacity-sourceLength,
+                                          text, textLength, &errorCode);
+            uprv_memcpy(source+sourceLength, pairs[i].illegal, pairs[i].illegalLength);
+            sourceLength+=pairs[i].illegalLength;
+        }
+        if(U_FAILURE(errorCode)) {
+            log_err("ucnv_fromUChars(%s) failed - %s\n", pairs[i].sourceName, u_errorName(errorCode));
+            ucnv_close(sourceCnv);
+            ucnv_close(targetCnv);
+            continue;
+        }
+        expectedLength=convertExAll(targetCnv, sourceCnv, expected, capacity, source, sourceLength);
+        if(expectedLength<0) {
+            ucnv_close(sourceCnv);
+            ucnv_close(targetCnv);
+            continue;
+        }
+
+        /* offsets on the calling thread, for comparison */
+        errorCode=U_ZERO_ERROR;
+        length=ucnv_convertBulk(targetCnv, sourceCnv, target, capacity, source, sourceLength,
+                                offsets2, 0, NULL, NULL, &errorCode);
+        if(U_FAILURE(errorCode) || length!=expectedLength ||
+                uprv_memcmp(target, expected, length)!=0) {
+            log_err("ucnv_convertBulk(%s -> %s, no executor) = %d (expected %d) differs from "
+                    "ucnv_convertEx() - %s\n",
+                    pairs[i].sourceName, pairs[i].targetName, length, expectedLength,
+                    u_errorName(errorCode));
+        }
+        /* each offset points into the source, and they do not go backward */
+        for(j=0, k=0; j<length; ++j) {
+            if(offsets2[j]>=0) {
+                if(offsets2[j]<k || offsets2[j]>=sourceLength) {
+                    log_err("ucnv_convertBulk(%s -> %s) offsets[%d]=%d out of order\n",
+                            pairs[i].sourceName, pairs[i].targetName, j, offsets2[j]);
+                    break;
+                }
+                k=offsets2[j];
+            }
+        }
+
+        for(j=0; j<UPRV_LENGTHOF(chunkLengths); ++j) {
+            /* without offsets: ucnv_convertEx() per chunk */
+            counter.count=0;
+            errorCode=U_ZERO_ERROR;
+            uprv_memset(target, 0x55, capacity);
+            length=ucnv_convertBulk(targetCnv, sourceCnv, target, capacity, source, sourceLength,
+                                    NULL, chunkLengths[j], bulkExecutor, &counter, &errorCode);
+            if(U_FAILURE(errorCode) || length!=expectedLength ||
+                    uprv_memcmp(target, expected, length)!=0 || target[length]!=0) {
+                log_err("ucnv_convertBulk(%s -> %s, chunkLength %d) = %d (expected %d) differs from "
+                        "ucnv_convertEx() - %s\n",
+                        pairs[i].sourceName, pairs[i].targetName, chunkLengths[j],
+                        length, expectedLength, u_errorName(errorCode));
+            }
+            if(chunkLengths[j]>0 && (counter.count>0)!=pairs[i].isSplittable) {
+                log_err("ucnv_convertBulk(%s -> %s, chunkLength %d) ran %d tasks on the executor\n",
+                        pairs[i].sourceName, pairs[i].targetName, chunkLengths[j], counter.count);
+            }
+            if(chunkLengths[j]==0 && counter.count!=0) {
+                log_err("ucnv_convertBulk(%s -> %s) split %d bytes into default-size chunks\n",
+                        pairs[i].sourceName, pairs[i].targetName, sourceLength);
+            }
+
+            /* with offsets: separate toUnicode and fromUnicode passes */
+            errorCode=U_ZERO_ERROR;
+            length=ucnv_convertBulk(targetCnv, sourceCnv, target, capacity, source, sourceLength,
+                                    offsets, chunkLengths[j], bulkExecutor, &counter, &errorCode);
+            if(U_FAILURE(errorCode) || length!=expectedLength ||
+                    uprv_memcmp(target, expected, length)!=0 ||
+                    uprv_memcmp(offsets, offsets2, length*4)!=0) {
+                log_err("ucnv_convertBulk(%s -> %s, chunkLength %d, offsets) = %d (expected %d) "
+                        "differs from the single-chunk result - %s\n",
+                        pairs[i].sourceName, pairs[i].targetName, chunkLengths[j],
+                        length, expectedLength, u_errorName(errorCode));
+            }
+        }
+
+        /* preflighting */
+        counter.count=0;
+        errorCode=U_ZERO_ERROR;
+        length=ucnv_convertBulk(targetCnv, sourceCnv, NULL, 0, source, sourceLength,
+                                NULL, 50, bulkExecutor, &counter, &errorCode);
+        if(errorCode!=U_BUFFER_OVERFLOW_ERROR || length!=expectedLength) {
+            log_err("ucnv_convertBulk(%s -> %s, preflighting) = %d (expected %d) - %s\n",
+                    pairs[i].sourceName, pairs[i].targetName, length, expectedLength,
+                    u_errorName(errorCode));
+        }
+        ucnv_close(sourceCnv);
+        ucnv_close(targetCnv);
+    }
+
+    /* NUL-terminated input, stop callback, argument errors */
+    errorCode=U_ZERO_ERROR;
+    sourceCnv=ucnv_open("UTF-8", &errorCode);
+    targetCnv=ucnv_open("US-ASCII", &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_err("unable to open UTF-8 or US-ASCII converters - %s\n", u_errorName(errorCode));
+    } else {
+        length=ucnv_convertBulk(targetCnv, sourceCnv, target, 20, "abc defgh ij", -1,
+                                NULL, 2, bulkExecutor, &counter, &errorCode);
+        if(U_FAILURE(errorCode) || length!=12 || uprv_strcmp(target, "abc defgh ij")!=0) {
+            log_err("ucnv_convertBulk(NUL-terminated) = %d - %s\n", length, u_errorName(errorCode));
+        }
+        length=ucnv_convertBulk(targetCnv, sourceCnv, target, 12, "abc defgh ij", -1,
+                                NULL, 2, bulkExecutor, &counter, &errorCode);
+        if(errorCode!=U_STRING_NOT_TERMINATED_WARNING || length!=12) {
+            log_err("ucnv_convertBulk(exactly filling the target) = %d - %s\n",
+                    length, u_errorName(errorCode));
+        }
+
+        /* the first failing chunk determines the error */
+        errorCode=U_ZERO_ERROR;
+        ucnv_setFromUCallBack(targetCnv, UCNV_FROM_U_CALLBACK_STOP, NULL, NULL, NULL, &errorCode);
+        ucnv_setToUCallBack(sourceCnv, UCNV_TO_U_CALLBACK_STOP, NULL, NULL, NULL, &errorCode);
+        length=ucnv_convertBulk(targetCnv, sourceCnv, target, 20, "ab c\xc3\xa9 d \xff", -1,
+                                NULL, 1, bulkExecutor, &counter, &errorCode);
+        if(errorCode!=U_INVALID_CHAR_FOUND) {
+            log_err("ucnv_convertBulk(stop callbacks) - %s (expected U_INVALID_CHAR_FOUND)\n",
+                    u_errorName(errorCode));
+        }
+
+        errorCode=U_ZERO_ERROR;
+        ucnv_convertBulk(NULL, sourceCnv, target, 20, "a", 1, NULL, 0, NULL, NULL, &errorCode);
+        if(errorCode!=U_ILLEGAL_ARGUMENT_ERROR) {
+            log_err("ucnv_convertBulk(targetCnv=NULL) - %s\n", u_errorName(errorCode));
+        }
+        errorCode=U_ZERO_ERROR;
+        ucnv_convertBulk(targetCnv, sourceCnv, NULL, 20, "a", 1, NULL, 0, NULL, NULL, &errorCode);
+        if(errorCode!=U_ILLEGAL_ARGUMENT_ERROR) {
+            log_err("ucnv_convertBulk(target=NULL, capacity>0) - %s\n", u_errorName(errorCode));
+        }
+        errorCode=U_ZERO_ERROR;
+        ucnv_convertBulk(targetCnv, sourceCnv, target, 20, NULL, 1, NULL, 0, NULL, NULL, &errorCode);
+        if(errorCode!=U_ILLEGAL_ARGUMENT_ERROR) {
+            log_err("ucnv_convertBulk(source=NULL, length>0) - %s\n", u_errorName(errorCode));
+        }
+        errorCode=U_ZERO_ERROR;
+        ucnv_convertBulk(targetCnv, sourceCnv, target, 20, "a", -2, NULL, 0, NULL, NULL, &errorCode);
+        if(errorCode!=U_ILLEGAL_ARGUMENT_ERROR) {
+            log_err("ucnv_convertBulk(sourceLength=-2) - %s\n", u_errorName(errorCode));
+        }
+    }
+    ucnv_close(sourceCnv);
+    ucnv_close(targetCnv);
+
+    /* into and out of UTF-16 with a BOM: the same as ucnv_convert() */
+    {
+        static const char *const bomNames[]={ "UnicodeBig", "UnicodeLittle" };
+        int32_t utf8Length, bomLength;
+        for(utf8Length=0; utf8Length<4000; ++utf8Length) {
+            source[utf8Length]=(char)(0x61+utf8Length%26);
+        }
+        for(i=0; i<UPRV_LENGTHOF(bomNames); ++i) {
+            errorCode=U_ZERO_ERROR;
+            sourceCnv=ucnv_open("UTF-8", &errorCode);
+            targetCnv=ucnv_open(bomNames[i], &errorCode);
+            expectedLength=ucnv_convert(bomNames[i], "UTF-8", expected, capacity,
+                                        source, utf8Length, &errorCode);
+            counter.count=0;
+            length=ucnv_convertBulk(targetCnv, sourceCnv, target, capacity, source, utf8Length,
+                                    NULL, 1000, bulkExecutor, &counter, &errorCode);
+            if(U_FAILURE(errorCode) || length!=expectedLength ||
+                    uprv_memcmp(target, expected, length)!=0) {
+                log_err("ucnv_convertBulk(UTF-8 -> %s) = %d differs from ucnv_convert() = %d - %s\n",
+                        bomNames[i], length, expectedLength, u_errorName(errorCode));
+            }
+            ucnv_close(sourceCnv);
+            ucnv_close(targetCnv);
+
+            /* and back, with the BOM from the first conversion */
+            bomLength=expectedLength;
+            uprv_memcpy(source+utf8Length, expected, bomLength);
+            errorCode=U_ZERO_ERROR;
+            sourceCnv=ucnv_open(bomNames[i], &errorCode);
+            targetCnv=ucnv_open("UTF-8", &errorCode);
+            expectedLength=ucnv_convert("UTF-8", bomNames[i], expected, capacity,
+                                        source+utf8Length, bomLength, &errorCode);
+            length=ucnv_convertBulk(targetCnv, sourceCnv, target, capacity,
+                                    source+utf8Length, bomLength,
+                                    NULL, 1000, bulkExecutor, &counter, &errorCode);
+            if(U_FAILURE(errorCode) || length!=expectedLength || length!=utf8Length ||
+                    uprv_memcmp(target, expected, length)!=0) {
+                log_err("ucnv_convertBulk(%s -> UTF-8) = %d differs from ucnv_convert() = %d - %s\n",
+                        bomNames[i], length, expectedLength, u_errorName(errorCode));
+            }
+            ucnv_close(sourceCnv);
+            ucnv_close(targetCnv);
+        }
+    }
+
+    free(source);
+    free(expected);
+    free(target);
+    free(offsets);
+    free(offsets2);
+}
+
 #if !UCONFIG_NO_FILE_IO && !UCONFIG_NO_LEGACY_CONVERSION
 static void TestLMBCSMaxChar(void) {
     static const struct {
@@ -39,6 +39,7 @@ void addCurrencyTest(TestNode**);
 void addPluralRulesTest(TestNode**);
 void addURegionTest(TestNode** root);
 void addUListFmtTest(TestNode** root);
+void addPreloadTest(TestNode** root);
 
 void addFormatTest(TestNode** root);
 
@@ -61,6 +62,7 @@ void addFormatTest(TestNode** root)
     addPluralRulesTest(root);
     addURegionTest(root);
     addUListFmtTest(root);
+    addPreloadTest(root);
 }
 /*Internal functions used*/
 
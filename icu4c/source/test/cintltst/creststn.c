@@ -223,6 +223,8 @@ void addNEWResourceBundleTest(TestNode** root)
     addTest(root, &TestGetFunctionalEquivalent,"tsutil/creststn/TestGetFunctionalEquivalent");
     addTest(root, &TestJB3763,                "tsutil/creststn/TestJB3763");
     addTest(root, &TestStackReuse,            "tsutil/creststn/TestStackReuse");
+    addTest(root, &TestRepeatedOpenFallback,  "tsutil/creststn/TestRepeatedOpenFallback");
+    addTest(root, &TestLargeTableLookup,      "tsutil/creststn/TestLargeTableLookup");
 }
 
 
@@ -2860,6 +2862,104 @@ static void TestStackReuse(void) {
     ures_close(&table);
 }
 
+/*
+ * Opening the same locale ID again must give the same result,
+ * even though the fallback resolution is remembered after the first open.
+ */
+static void checkOpenTwice(const char *localeID, const char *expectedLocale,
+                           UErrorCode expectedStatus) {
+    int32_t i;
+    for (i = 0; i < 2; ++i) {
+        UErrorCode errorCode = U_ZERO_ERROR;
+        UResourceBundle *rb = ures_open(NULL, localeID, &errorCode);
+        const char *actual;
+        if (U_FAILURE(errorCode)) {
+            log_data_err("ures_open(%s) #%d failed: %s\n", localeID, (int)i, u_errorName(errorCode));
+            return;
+        }
+        actual = ures_getLocaleByType(rb, ULOC_ACTUAL_LOCALE, &errorCode);
+        if (errorCode != expectedStatus) {
+            log_err("ures_open(%s) #%d: expected status %s, got %s\n", localeID, (int)i,
+                    u_errorName(expectedStatus), u_errorName(errorCode));
+        }
+        if (uprv_strcmp(actual, expectedLocale) != 0) {
+            log_err("ures_open(%s) #%d: expected actual locale %s, got %s\n", localeID, (int)i,
+                    expectedLocale, actual);
+        }
+        ures_close(rb);
+    }
+}
+
+static void TestRepeatedOpenFallback(void) {
+    UErrorCode errorCode = U_ZERO_ERROR;
+    char oldDefault[ULOC_FULLNAME_CAPACITY];
+    uprv_strcpy(oldDefault, uloc_getDefault());
+
+    checkOpenTwice("de_AT", "de_AT", U_ZERO_ERROR);
+    checkOpenTwice("de-AT", "de_AT", U_ZERO_ERROR);
+    checkOpenTwice("de_AT@currency=EUR", "de_AT", U_ZERO_ERROR);
+    checkOpenTwice("de_XX", "de", U_USING_FALLBACK_WARNING);
+
+    /* Results that depend on the default locale follow changes of the default. */
+    uloc_setDefault("de_AT", &errorCode);
+    checkOpenTwice("xx_YY", "de_AT", U_USING_DEFAULT_WARNING);
+    uloc_setDefault("fr", &errorCode);
+    checkOpenTwice("xx_YY", "fr", U_USING_DEFAULT_WARNING);
+    uloc_setDefault(oldDefault, &errorCode);
+    if (U_FAILURE(errorCode)) {
+        log_err("uloc_setDefault() failed: %s\n", u_errorName(errorCode));
+    }
+}
+
+/*
+ * Large tables are looked up via a hash index rather than binary search.
+ * Every key must still find its own item, and only that.
+ */
+static void TestLargeTableLookup(void) {
+    static const char *const keys[] = { "Currencies", "CurrencyPlurals" };
+    UErrorCode errorCode = U_ZERO_ERROR;
+    UResourceBundle *rb = ures_open(U_ICUDATA_CURR, "en", &errorCode);
+    UResourceBundle *table = NULL, *byIndex = NULL, *byKey = NULL;
+    int32_t i, j, size;
+
+    if(U_FAILURE(errorCode)) {
+        log_data_err("Could not load en currency data. status=%s\n", myErrorName(errorCode));
+        return;
+    }
+    for(i = 0; i < UPRV_LENGTHOF(keys); ++i) {
+        table = ures_getByKey(rb, keys[i], table, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_data_err("Could not get %s. status=%s\n", keys[i], myErrorName(errorCode));
+            break;
+        }
+        size = ures_getSize(table);
+        if(size < 100) {
+            log_err("%s has only %d items, not a large table\n", keys[i], (int)size);
+        }
+        for(j = 0; j < size; ++j) {
+            const char *key;
+            byIndex = ures_getByIndex(table, j, byIndex, &errorCode);
+            key = ures_getKey(byIndex);
+            byKey = ures_getByKey(table, key, byKey, &errorCode);
+            if(U_FAILURE(errorCode)) {
+                log_err("%s/%s not found by key. status=%s\n", keys[i], key, myErrorName(errorCode));
+                errorCode = U_ZERO_ERROR;
+            } else if(uprv_strcmp(ures_getKey(byKey), key) != 0) {
+                log_err("%s/%s found %s\n", keys[i], key, ures_getKey(byKey));
+            }
+        }
+        byKey = ures_getByKey(table, "XYZ", byKey, &errorCode);
+        if(errorCode != U_MISSING_RESOURCE_ERROR) {
+            log_err("%s/XYZ: expected U_MISSING_RESOURCE_ERROR, got %s\n", keys[i], myErrorName(errorCode));
+        }
+        errorCode = U_ZERO_ERROR;
+    }
+    ures_close(byKey);
+    ures_close(byIndex);
+    ures_close(table);
+    ures_close(rb);
+}
+
 /* Test ures_getUTF8StringXYZ() --------------------------------------------- */
 
 /*
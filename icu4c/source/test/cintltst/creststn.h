@@ -83,6 +83,10 @@ static void TestXPath(void);
 
 static void TestStackReuse(void);
 
+static void TestRepeatedOpenFallback(void);
+
+static void TestLargeTableLookup(void);
+
 /**
 * extensive subtests called by TestResourceBundles
 **/
@@ -38,6 +38,8 @@ static void Test_strFromUTF32_surrogates(void);
 static void Test_UChar_UTF8_API(void);
 static void Test_FromUTF8(void);
 static void Test_FromUTF8Lenient(void);
+static void Test_UTF8ASCIIRuns(void);
+static void Test_validateUTF(void);
 static void Test_UChar_WCHART_API(void);
 static void Test_widestrs(void);
 static void Test_WCHART_LongString(void);
@@ -55,6 +57,8 @@ addUCharTransformTest(TestNode** root)
    addTest(root, &Test_UChar_UTF8_API, "custrtrn/Test_UChar_UTF8_API");
    addTest(root, &Test_FromUTF8, "custrtrn/Test_FromUTF8");
    addTest(root, &Test_FromUTF8Lenient, "custrtrn/Test_FromUTF8Lenient");
+   addTest(root, &Test_UTF8ASCIIRuns, "custrtrn/Test_UTF8ASCIIRuns");
+   addTest(root, &Test_validateUTF, "custrtrn/Test_validateUTF");
    addTest(root, &Test_UChar_WCHART_API,  "custrtrn/Test_UChar_WCHART_API");
    addTest(root, &Test_widestrs,  "custrtrn/Test_widestrs");
 #if !UCONFIG_NO_FILE_IO && !UCONFIG_NO_LEGACY_CONVERSION
@@ -928,6 +932,162 @@ Test_FromUTF8(void) {
     }
 }
 
+/*
+ * Long ASCII runs are converted in blocks; check that the conversion
+ * of the characters around them and of ill-formed sequences is unchanged.
+ */
+static void
+Test_UTF8ASCIIRuns(void) {
+    static const char *const inserts[]={
+        "", "\xc3\xa9", "\xe4\xb8\xad", "\xf0\x9f\x98\x80", "\xff", "\xe4\xb8", "\xed\xa0\x80"
+    };
+    char src[300], out8[1200];
+    UChar expected[300], dest[300], utf16[300];
+    int32_t insert, pos, capacity;
+    for(insert=0; insert<UPRV_LENGTHOF(inserts); ++insert) {
+        const char *bytes=inserts[insert];
+        int32_t bytesLength=(int32_t)uprv_strlen(bytes);
+        for(pos=0; pos<40; pos+=3) {
+            int32_t srcLength=0, expectedLength=0, i, j, destLength, numSubstitutions;
+            UErrorCode errorCode;
+            for(i=0; i<pos; ++i) {
+                src[srcLength++]=(char)('a'+i%26);
+            }
+            uprv_memcpy(src+srcLength, bytes, bytesLength);
+            srcLength+=bytesLength;
+            for(i=0; i<100; ++i) {
+                src[srcLength++]=(char)('A'+i%26);
+            }
+            uprv_memcpy(src+srcLength, bytes, bytesLength);
+            srcLength+=bytesLength;
+            for(i=0; i<50; ++i) {
+                src[srcLength++]=(char)('0'+i%10);
+            }
+            /* reference: one code point at a time */
+            for(i=0; i<srcLength;) {
+                UChar32 c;
+                U8_NEXT(src, i, srcLength, c);
+                if(c<0) {
+                    c=0xfffd;
+                }
+                U16_APPEND_UNSAFE(expected, expectedLength, c);
+            }
+
+            for(capacity=expectedLength; capacity>=expectedLength-20; capacity-=7) {
+                errorCode=U_ZERO_ERROR;
+                u_memset(dest, 0x5555, UPRV_LENGTHOF(dest));
+                u_strFromUTF8WithSub(dest, capacity, &destLength, src, srcLength,
+                                     0xfffd, &numSubstitutions, &errorCode);
+                if(destLength!=expectedLength ||
+                        (capacity==expectedLength ? errorCode!=U_STRING_NOT_TERMINATED_WARNING :
+                                                    errorCode!=U_BUFFER_OVERFLOW_ERROR)) {
+                    log_err("u_strFromUTF8WithSub(insert %d at %d, capacity %d) length %d - %s\n",
+                            (int)insert, (int)pos, (int)capacity, (int)destLength, u_errorName(errorCode));
+                    continue;
+                }
+                for(j=0; j<capacity && j<expectedLength; ++j) {
+                    if(dest[j]!=expected[j]) {
+                        /* a supplementary code point may be cut off at the capacity */
+                        if(!(j==capacity-1 && U16_IS_LEAD(expected[j]))) {
+                            log_err("u_strFromUTF8WithSub(insert %d at %d, capacity %d) "
+                                    "differs at %d\n", (int)insert, (int)pos, (int)capacity, (int)j);
+                        }
+                        break;
+                    }
+                }
+                if(dest[capacity]!=0x5555) {
+                    log_err("u_strFromUTF8WithSub(insert %d at %d) wrote past the capacity %d\n",
+                            (int)insert, (int)pos, (int)capacity);
+                }
+            }
+
+            /* round trip from the well-formed UTF-16 */
+            u_memcpy(utf16, expected, expectedLength);
+            errorCode=U_ZERO_ERROR;
+            u_strToUTF8(out8, UPRV_LENGTHOF(out8), &destLength, utf16, expectedLength, &errorCode);
+            errorCode=U_ZERO_ERROR;
+            u_strFromUTF8(dest, UPRV_LENGTHOF(dest), &i, out8, destLength, &errorCode);
+            if(U_FAILURE(errorCode) || i!=expectedLength || u_memcmp(dest, expected, i)!=0) {
+                log_err("UTF-16/UTF-8 round trip (insert %d at %d) failed - %s\n",
+                        (int)insert, (int)pos, u_errorName(errorCode));
+            }
+        }
+    }
+}
+
+/* test u_validateUTF8() and u_validateUTF16() */
+static void
+Test_validateUTF(void) {
+    static const struct {
+        const char *s;
+        int32_t errorIndex;
+    } utf8Cases[]={
+        { "", -1 },
+        { "abc", -1 },
+        { "a\xc3\xa9\xe4\xb8\xad\xf0\x9f\x98\x80z", -1 },
+        { "ab\x80", 2 },
+        { "a\xc0\xaf", 1 },             /* non-shortest form */
+        { "a\xed\xa0\x80", 1 },         /* surrogate code point */
+        { "a\xf4\x90\x80\x80", 1 },     /* above U+10FFFF */
+        { "abc\xe4\xb8", 3 },           /* truncated */
+        { "0123456789abcdefghijklmnopqrstuvwxyz\xff", 36 },
+        { "0123456789abcdefghijklmnopqrstuvwxyz\xe4\xb8\xad" "0123456789abcdef\xc3", 55 }
+    };
+    static const UChar utf16Bad[]={ 0x61, 0xd800, 0xdc00, 0x62, 0xdc00, 0x63 };
+    UChar long16[100];
+    UErrorCode errorCode=U_ZERO_ERROR;
+    int32_t i, errorIndex;
+    UBool isValid;
+
+    for(i=0; i<UPRV_LENGTHOF(utf8Cases); ++i) {
+        errorIndex=-99;
+        isValid=u_validateUTF8(utf8Cases[i].s, -1, &errorIndex, &errorCode);
+        if(U_FAILURE(errorCode) || isValid!=(utf8Cases[i].errorIndex<0) ||
+                errorIndex!=utf8Cases[i].errorIndex) {
+            log_err("u_validateUTF8(case %d)=%d errorIndex=%d - %s\n",
+                    (int)i, isValid, (int)errorIndex, u_errorName(errorCode));
+        }
+    }
+    /* with explicit length, a NUL byte is valid */
+    if(!u_validateUTF8("a\0b", 3, NULL, &errorCode) || U_FAILURE(errorCode)) {
+        log_err("u_validateUTF8(embedded NUL) failed - %s\n", u_errorName(errorCode));
+    }
+    /* a truncated sequence at the end of the length is ill-formed */
+    if(u_validateUTF8("a\xe4\xb8\xad", 3, &errorIndex, &errorCode) || errorIndex!=1) {
+        log_err("u_validateUTF8(length cuts off a character) errorIndex=%d\n", (int)errorIndex);
+    }
+
+    if(u_validateUTF16(utf16Bad, 4, &errorIndex, &errorCode)!=TRUE || errorIndex!=-1) {
+        log_err("u_validateUTF16(surrogate pair) errorIndex=%d\n", (int)errorIndex);
+    }
+    if(u_validateUTF16(utf16Bad, UPRV_LENGTHOF(utf16Bad), &errorIndex, &errorCode)!=FALSE || errorIndex!=4) {
+        log_err("u_validateUTF16(lone trail) errorIndex=%d\n", (int)errorIndex);
+    }
+    if(u_validateUTF16(utf16Bad, 2, &errorIndex, &errorCode)!=FALSE || errorIndex!=1) {
+        log_err("u_validateUTF16(lead at the end) errorIndex=%d\n", (int)errorIndex);
+    }
+    for(i=0; i<UPRV_LENGTHOF(long16); ++i) {
+        long16[i]=(UChar)(0x4e00+i);
+    }
+    for(i=0; i<UPRV_LENGTHOF(long16); i+=13) {
+        UChar saved=long16[i];
+        long16[i]=0xdbff;
+        if(u_validateUTF16(long16, UPRV_LENGTHOF(long16), &errorIndex, &errorCode)!=FALSE ||
+                errorIndex!=i) {
+            log_err("u_validateUTF16(lone lead at %d) errorIndex=%d\n", (int)i, (int)errorIndex);
+        }
+        long16[i]=saved;
+    }
+    if(!u_validateUTF16(long16, UPRV_LENGTHOF(long16), &errorIndex, &errorCode) || U_FAILURE(errorCode)) {
+        log_err("u_validateUTF16(long string) failed - %s\n", u_errorName(errorCode));
+    }
+
+    u_validateUTF8(NULL, 1, NULL, &errorCode);
+    if(errorCode!=U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("u_validateUTF8(NULL, 1) did not fail with U_ILLEGAL_ARGUMENT_ERROR\n");
+    }
+}
+
 /* test u_strFromUTF8Lenient() */
 static void
 Test_FromUTF8Lenient(void) {
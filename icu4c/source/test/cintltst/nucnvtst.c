@@ -43,6 +43,8 @@ static void TestSignatureDetection(void);
 static void TestUTF7(void);
 static void TestIMAP(void);
 static void TestUTF8(void);
+static void TestUTF8ASCIIRuns(void);
+static void TestMBCSASCIIRuns(void);
 static void TestCESU8(void);
 static void TestUTF16(void);
 static void TestUTF16BE(void);
@@ -259,6 +261,7 @@ void addTestNewConvert(TestNode** root)
    addTest(root, &TestUTF7, "tsconv/nucnvtst/TestUTF7");
    addTest(root, &TestIMAP, "tsconv/nucnvtst/TestIMAP");
    addTest(root, &TestUTF8, "tsconv/nucnvtst/TestUTF8");
+   addTest(root, &TestUTF8ASCIIRuns, "tsconv/nucnvtst/TestUTF8ASCIIRuns");
 
    /* test ucnv_getNextUChar() for charsets that encode single surrogates with complete byte sequences */
    addTest(root, &TestCESU8, "tsconv/nucnvtst/TestCESU8");
@@ -282,6 +285,7 @@ void addTestNewConvert(TestNode** root)
    addTest(root, &TestICCRunout, "tsconv/nucnvtst/TestICCRunout");
 #endif
    addTest(root, &TestMBCS, "tsconv/nucnvtst/TestMBCS");
+   addTest(root, &TestMBCSASCIIRuns, "tsconv/nucnvtst/TestMBCSASCIIRuns");
 
 #ifdef U_ENABLE_GENERIC_ISO_2022
    addTest(root, &TestISO_2022, "tsconv/nucnvtst/TestISO_2022");
@@ -1961,6 +1965,155 @@ static void TestUTF8() {
     ucnv_close(cnv);
 }
 
+/*
+ * Long ASCII runs are converted in bulk.
+ * Interleave them with multi-byte characters and convert in small pieces
+ * so that sequences are split across buffer boundaries.
+ */
+static void TestUTF8ASCIIRuns() {
+    static const char *const names[]={ "UTF-8", "CESU-8" };
+    UChar text[400];
+    uint8_t bytes[1200];
+    int32_t textOffsets[1200];
+    int32_t byteOffsets[400];
+    UChar text2[400];
+    uint8_t bytes2[1200];
+    int32_t offsets[1200];
+    int32_t textLength=0, bytesLength=0;
+    int32_t i, n;
+
+    /* build the UTF-16 text and its UTF-8 form, with the expected offsets */
+    for(i=0; textLength<360; ++i) {
+        UChar32 c;
+        int32_t start;
+        switch(i%5) {
+        case 0: c=0xe9; break;
+        case 1: c=0x4e00+i; break;
+        case 2: c=0x10400+i; break;
+        default: c=0; break;
+        }
+        for(n=0; n<(i%23)+1; ++n) {
+            byteOffsets[textLength]=bytesLength;
+            textOffsets[bytesLength]=textLength;
+            text[textLength++]=(UChar)(0x20+(i+n)%0x5f);
+            bytes[bytesLength++]=(uint8_t)(0x20+(i+n)%0x5f);
+        }
+        if(c!=0) {
+            start=bytesLength;
+            U8_APPEND_UNSAFE(bytes, bytesLength, c);
+            n=textLength;
+            U16_APPEND_UNSAFE(text, textLength, c);
+            while(n<textLength) {
+                byteOffsets[n++]=start;
+            }
+            while(start<bytesLength) {
+                textOffsets[start++]=textLength-U16_LENGTH(c);
+            }
+        }
+    }
+
+    for(i=0; i<UPRV_LENGTHOF(names); ++i) {
+        UErrorCode errorCode=U_ZERO_ERROR;
+        UConverter *cnv=ucnv_open(names[i], &errorCode);
+        const char *source;
+        const UChar *uSource;
+        char *target;
+        UChar *uTarget;
+        int32_t chunk, expectLength;
+
+        if(U_FAILURE(errorCode)) {
+            log_data_err("Unable to open a %s converter: %s\n", names[i], u_errorName(errorCode));
+            continue;
+        }
+        if(i==0) {
+            expectLength=bytesLength;
+        } else {
+            /* CESU-8 encodes each surrogate separately; convert the text to find the expected form */
+            target=(char *)bytes2;
+            uSource=text;
+            ucnv_fromUnicode(cnv, &target, (const char *)bytes2+sizeof(bytes2),
+                             &uSource, text+textLength, NULL, TRUE, &errorCode);
+            expectLength=(int32_t)(target-(char *)bytes2);
+            uprv_memcpy(bytes, bytes2, expectLength);
+            ucnv_resetFromUnicode(cnv);
+        }
+
+        /* whole-buffer conversion with offsets */
+        if(i==0) {
+            target=(char *)bytes2;
+            uSource=text;
+            ucnv_fromUnicode(cnv, &target, (const char *)bytes2+sizeof(bytes2),
+                             &uSource, text+textLength, offsets, TRUE, &errorCode);
+            if(U_FAILURE(errorCode) || (target-(char *)bytes2)!=bytesLength ||
+                    0!=memcmp(bytes, bytes2, bytesLength)) {
+                log_err("%s fromUnicode of ASCII runs failed: %s\n", names[i], u_errorName(errorCode));
+            } else {
+                for(n=0; n<bytesLength; ++n) {
+                    if(offsets[n]!=textOffsets[n]) {
+                        log_err("%s fromUnicode offsets[%d]=%d, expected %d\n",
+                                names[i], (int)n, (int)offsets[n], (int)textOffsets[n]);
+                        break;
+                    }
+                }
+            }
+
+            uTarget=text2;
+            source=(const char *)bytes;
+            ucnv_toUnicode(cnv, &uTarget, text2+UPRV_LENGTHOF(text2),
+                           &source, (const char *)bytes+bytesLength, offsets, TRUE, &errorCode);
+            if(U_FAILURE(errorCode) || (uTarget-text2)!=textLength ||
+                    0!=u_memcmp(text, text2, textLength)) {
+                log_err("%s toUnicode of ASCII runs failed: %s\n", names[i], u_errorName(errorCode));
+            } else {
+                for(n=0; n<textLength; ++n) {
+                    if(offsets[n]!=byteOffsets[n]) {
+                        log_err("%s toUnicode offsets[%d]=%d, expected %d\n",
+                                names[i], (int)n, (int)offsets[n], (int)byteOffsets[n]);
+                        break;
+                    }
+                }
+            }
+        }
+
+        /* piecewise conversion, splitting sequences across calls */
+        for(chunk=1; chunk<=37; chunk+=4) {
+            const UChar *uSourceLimit;
+            const char *sourceLimit;
+
+            ucnv_reset(cnv);
+            errorCode=U_ZERO_ERROR;
+            target=(char *)bytes2;
+            uSource=text;
+            do {
+                uSourceLimit=uSource+chunk<=text+textLength ? uSource+chunk : text+textLength;
+                ucnv_fromUnicode(cnv, &target, (const char *)bytes2+sizeof(bytes2),
+                                 &uSource, uSourceLimit, NULL, uSourceLimit==text+textLength, &errorCode);
+            } while(U_SUCCESS(errorCode) && uSource<text+textLength);
+            if(U_FAILURE(errorCode) || (target-(char *)bytes2)!=expectLength ||
+                    0!=memcmp(bytes, bytes2, expectLength)) {
+                log_err("%s piecewise fromUnicode (chunk %d) failed: %s\n",
+                        names[i], (int)chunk, u_errorName(errorCode));
+            }
+
+            uTarget=text2;
+            source=(const char *)bytes;
+            do {
+                sourceLimit=source+chunk<=(const char *)bytes+expectLength ?
+                    source+chunk : (const char *)bytes+expectLength;
+                ucnv_toUnicode(cnv, &uTarget, text2+UPRV_LENGTHOF(text2),
+                               &source, sourceLimit, NULL,
+                               sourceLimit==(const char *)bytes+expectLength, &errorCode);
+            } while(U_SUCCESS(errorCode) && source<(const char *)bytes+expectLength);
+            if(U_FAILURE(errorCode) || (uTarget-text2)!=textLength ||
+                    0!=u_memcmp(text, text2, textLength)) {
+                log_err("%s piecewise toUnicode (chunk %d) failed: %s\n",
+                        names[i], (int)chunk, u_errorName(errorCode));
+            }
+        }
+        ucnv_close(cnv);
+    }
+}
+
 static void TestCESU8() {
     /* test input */
     static const uint8_t in[]={
@@ -2610,6 +2763,131 @@ TestDBCS() {
     ucnv_close(cnv);
 }
 
+/*
+ * Long ASCII runs in codepages where all of ASCII round-trips are converted in bulk.
+ * Interleave them with non-ASCII characters and convert in small pieces
+ * so that the runs and double-byte characters are split across buffer boundaries.
+ */
+static void
+TestMBCSASCIIRuns() {
+    static const struct {
+        const char *name;
+        UChar c;
+        uint8_t bytes[2];
+        int32_t length;
+    } cases[]={
+        { "windows-1252", 0xe9, { 0xe9, 0 }, 1 },
+        { "windows-1252", 0x20ac, { 0x80, 0 }, 1 },
+        { "Shift-JIS", 0x3042, { 0x82, 0xa0 }, 2 },
+        { "GBK", 0x4e2d, { 0xd6, 0xd0 }, 2 }
+    };
+    UChar text[400], text2[400];
+    uint8_t bytes[800], bytes2[800];
+    int32_t textOffsets[800], byteOffsets[400], offsets[800];
+    int32_t i;
+
+    for(i=0; i<UPRV_LENGTHOF(cases); ++i) {
+        UErrorCode errorCode=U_ZERO_ERROR;
+        UConverter *cnv=ucnv_open(cases[i].name, &errorCode);
+        const char *source, *sourceLimit;
+        const UChar *uSource, *uSourceLimit;
+        char *target;
+        UChar *uTarget;
+        int32_t textLength=0, bytesLength=0;
+        int32_t j, n, chunk;
+
+        if(U_FAILURE(errorCode)) {
+            log_data_err("Unable to open a %s converter: %s\n", cases[i].name, u_errorName(errorCode));
+            continue;
+        }
+
+        /* build the text and its codepage form, with the expected offsets */
+        for(j=0; textLength<360; ++j) {
+            for(n=0; n<(j%29)+1; ++n) {
+                byteOffsets[textLength]=bytesLength;
+                textOffsets[bytesLength]=textLength;
+                text[textLength++]=(UChar)(0x61+(j+n)%26);
+                bytes[bytesLength++]=(uint8_t)(0x61+(j+n)%26);
+            }
+            byteOffsets[textLength]=bytesLength;
+            for(n=0; n<cases[i].length; ++n) {
+                textOffsets[bytesLength]=textLength;
+                bytes[bytesLength++]=cases[i].bytes[n];
+            }
+            text[textLength++]=cases[i].c;
+        }
+
+        /* whole-buffer conversion with offsets */
+        target=(char *)bytes2;
+        uSource=text;
+        ucnv_fromUnicode(cnv, &target, (const char *)bytes2+sizeof(bytes2),
+                         &uSource, text+textLength, offsets, TRUE, &errorCode);
+        if(U_FAILURE(errorCode) || (target-(char *)bytes2)!=bytesLength ||
+                0!=memcmp(bytes, bytes2, bytesLength)) {
+            log_err("%s fromUnicode of ASCII runs failed: %s\n", cases[i].name, u_errorName(errorCode));
+        } else {
+            for(n=0; n<bytesLength; ++n) {
+                if(offsets[n]!=textOffsets[n]) {
+                    log_err("%s fromUnicode offsets[%d]=%d, expected %d\n",
+                            cases[i].name, (int)n, (int)offsets[n], (int)textOffsets[n]);
+                    break;
+                }
+            }
+        }
+
+        uTarget=text2;
+        source=(const char *)bytes;
+        ucnv_toUnicode(cnv, &uTarget, text2+UPRV_LENGTHOF(text2),
+                       &source, (const char *)bytes+bytesLength, offsets, TRUE, &errorCode);
+        if(U_FAILURE(errorCode) || (uTarget-text2)!=textLength ||
+                0!=u_memcmp(text, text2, textLength)) {
+            log_err("%s toUnicode of ASCII runs failed: %s\n", cases[i].name, u_errorName(errorCode));
+        } else {
+            for(n=0; n<textLength; ++n) {
+                if(offsets[n]!=byteOffsets[n]) {
+                    log_err("%s toUnicode offsets[%d]=%d, expected %d\n",
+                            cases[i].name, (int)n, (int)offsets[n], (int)byteOffsets[n]);
+                    break;
+                }
+            }
+        }
+
+        /* piecewise conversion */
+        for(chunk=1; chunk<=41; chunk+=4) {
+            ucnv_reset(cnv);
+            errorCode=U_ZERO_ERROR;
+            target=(char *)bytes2;
+            uSource=text;
+            do {
+                uSourceLimit=uSource+chunk<=text+textLength ? uSource+chunk : text+textLength;
+                ucnv_fromUnicode(cnv, &target, (const char *)bytes2+sizeof(bytes2),
+                                 &uSource, uSourceLimit, NULL, uSourceLimit==text+textLength, &errorCode);
+            } while(U_SUCCESS(errorCode) && uSource<text+textLength);
+            if(U_FAILURE(errorCode) || (target-(char *)bytes2)!=bytesLength ||
+                    0!=memcmp(bytes, bytes2, bytesLength)) {
+                log_err("%s piecewise fromUnicode (chunk %d) failed: %s\n",
+                        cases[i].name, (int)chunk, u_errorName(errorCode));
+            }
+
+            uTarget=text2;
+            source=(const char *)bytes;
+            do {
+                sourceLimit=source+chunk<=(const char *)bytes+bytesLength ?
+                    source+chunk : (const char *)bytes+bytesLength;
+                ucnv_toUnicode(cnv, &uTarget, text2+UPRV_LENGTHOF(text2),
+                               &source, sourceLimit, NULL,
+                               sourceLimit==(const char *)bytes+bytesLength, &errorCode);
+            } while(U_SUCCESS(errorCode) && source<(const char *)bytes+bytesLength);
+            if(U_FAILURE(errorCode) || (uTarget-text2)!=textLength ||
+                    0!=u_memcmp(text, text2, textLength)) {
+                log_err("%s piecewise toUnicode (chunk %d) failed: %s\n",
+                        cases[i].name, (int)chunk, u_errorName(errorCode));
+            }
+        }
+        ucnv_close(cnv);
+    }
+}
+
 static void
 TestMBCS() {
     /* test input */
@@ -33,12 +33,14 @@
 
 static void TestSelector(void);
 static void TestUPropsVector(void);
+static void TestSelectorCache(void);
 void addCnvSelTest(TestNode** root);  /* Declaration required to suppress compiler warnings. */
 
 void addCnvSelTest(TestNode** root)
 {
     addTest(root, &TestSelector, "tsconv/ucnvseltst/TestSelector");
     addTest(root, &TestUPropsVector, "tsconv/ucnvseltst/TestUPropsVector");
+    addTest(root, &TestSelectorCache, "tsconv/ucnvseltst/TestSelectorCache");
 }
 
 static const char **gAvailableNames = NULL;
@@ -538,3 +540,265 @@ static void TestUPropsVector() {
 
     upvec_close(pv);
 }
+
+/* returns TRUE if the two selectors select the same encodings for s */
+static UBool
+sameSelection(const UConverterSelector *sel1, const UConverterSelector *sel2,
+              const UChar *s, int32_t length) {
+  UErrorCode status = U_ZERO_ERROR;
+  UEnumeration *res1 = ucnvsel_selectForString(sel1, s, length, &status);
+  UEnumeration *res2 = ucnvsel_selectForString(sel2, s, length, &status);
+  UBool same = U_SUCCESS(status);
+  while (same) {
+    const char *name1 = uenum_next(res1, NULL, &status);
+    const char *name2 = uenum_next(res2, NULL, &status);
+    if (name1 == NULL || name2 == NULL) {
+      same = (UBool)(name1 == name2);
+      break;
+    }
+    same = (UBool)(uprv_strcmp(name1, name2) == 0);
+  }
+  uenum_close(res1);
+  uenum_close(res2);
+  return same;
+}
+
+static void
+checkOpenWithCache(const char *message, const char **encodings, int32_t num_encodings,
+                   const USet *excluded, UConverterUnicodeSet whichSet,
+                   const void *cache, int32_t cacheLength,
+                   const UConverterSelector *expected, UBool expectFromCache) {
+  static const UChar strings[][16] = {
+    { 0x61, 0x62, 0x63, 0 },
+    { 0x61, 0x61, 0x61, 0x61, 0xe4, 0xe4, 0x3b1, 0x3b2, 0x3b3, 0 },
+    { 0x41, 0x3042, 0x3044, 0x3046, 0x4e00, 0x4e01, 0 },
+    { 0x20ac, 0xd83d, 0xde00, 0x62, 0 }
+  };
+  UErrorCode status = U_ZERO_ERROR;
+  UBool isFromCache = !expectFromCache;
+  int32_t i;
+  UConverterSelector *sel = ucnvsel_openWithCache(encodings, num_encodings, excluded, whichSet,
+                                                  cache, cacheLength, &isFromCache, &status);
+  if (U_FAILURE(status)) {
+    log_err("%s: ucnvsel_openWithCache() failed - %s\n", message, u_errorName(status));
+    return;
+  }
+  if (isFromCache != expectFromCache) {
+    log_err("%s: ucnvsel_openWithCache() isFromCache=%d but expected %d\n",
+            message, isFromCache, expectFromCache);
+  }
+  for (i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+    if (!sameSelection(sel, expected, strings[i], -1)) {
+      log_err("%s: ucnvsel_openWithCache() selector differs for string %d\n", message, (int)i);
+    }
+  }
+  ucnvsel_close(sel);
+}
+
+static void TestSelectorCache() {
+  const char **encodings;
+  int32_t num_encodings, length;
+  UConverterSelector *sel, *sel_fb;
+  USet *excluded;
+  uint8_t *buffer, *copy;
+  UErrorCode status = U_ZERO_ERROR;
+  UBool isFromCache;
+
+  if (!getAvailableNames()) {
+    return;
+  }
+  encodings = getSomeEncodings(&num_encodings);
+  excluded = uset_open(0x30, 0x530);
+  sel = ucnvsel_open(encodings, num_encodings, excluded, UCNV_ROUNDTRIP_SET, &status);
+  sel_fb = ucnvsel_open(encodings, num_encodings, excluded,
+                        UCNV_ROUNDTRIP_AND_FALLBACK_SET, &status);
+  length = ucnvsel_serialize(sel, NULL, 0, &status);
+  if (status == U_BUFFER_OVERFLOW_ERROR) {
+    status = U_ZERO_ERROR;
+  }
+  buffer = (uint8_t *)uprv_malloc(length);
+  copy = (uint8_t *)uprv_malloc(length);
+  if (buffer == NULL || copy == NULL) {
+    log_err("memory allocation error\n");
+    status = U_MEMORY_ALLOCATION_ERROR;
+  }
+  ucnvsel_serialize(sel, buffer, length, &status);
+  if (U_FAILURE(status)) {
+    log_data_err("unable to open and serialize a selector - %s\n", u_errorName(status));
+    ucnvsel_close(sel);
+    ucnvsel_close(sel_fb);
+    uset_close(excluded);
+    uprv_free(buffer);
+    uprv_free(copy);
+    uprv_free((void *)encodings);
+    releaseAvailableNames();
+    return;
+  }
+
+  checkOpenWithCache("same parameters", encodings, num_encodings,
+                     excluded, UCNV_ROUNDTRIP_SET, buffer, length, sel, TRUE);
+  checkOpenWithCache("no cache", encodings, num_encodings,
+                     excluded, UCNV_ROUNDTRIP_SET, NULL, 0, sel, FALSE);
+  checkOpenWithCache("different whichSet", encodings, num_encodings,
+                     excluded, UCNV_ROUNDTRIP_AND_FALLBACK_SET, buffer, length, sel_fb, FALSE);
+  ucnvsel_close(sel_fb);
+  uset_add(excluded, 0x20ac);
+  sel_fb = ucnvsel_open(encodings, num_encodings, excluded, UCNV_ROUNDTRIP_SET, &status);
+  checkOpenWithCache("different excluded code points", encodings, num_encodings,
+                     excluded, UCNV_ROUNDTRIP_SET, buffer, length, sel_fb, FALSE);
+  uset_remove(excluded, 0x20ac);
+
+  /* fewer encodings */
+  ucnvsel_close(sel_fb);
+  sel_fb = ucnvsel_open(encodings, num_encodings - 1, excluded, UCNV_ROUNDTRIP_SET, &status);
+  checkOpenWithCache("different encodings", encodings, num_encodings - 1,
+                     excluded, UCNV_ROUNDTRIP_SET, buffer, length, sel_fb, FALSE);
+
+  /* different excluded code points with the same UnicodeSet::hashCode() */
+  {
+    USet *excluded1 = uset_open(0x4c5, 0x7e6);
+    USet *excluded2 = uset_open(0x2bb, 0xd42);
+    UConverterSelector *sel1, *sel2;
+    uint8_t *buffer1;
+    int32_t length1;
+    uset_addRange(excluded1, 0xad1, 0x2212);
+    uset_addRange(excluded2, 0x119f, 0x2a7a);
+    sel1 = ucnvsel_open(encodings, num_encodings, excluded1, UCNV_ROUNDTRIP_SET, &status);
+    sel2 = ucnvsel_open(encodings, num_encodings, excluded2, UCNV_ROUNDTRIP_SET, &status);
+    length1 = ucnvsel_serialize(sel1, NULL, 0, &status);
+    if (status == U_BUFFER_OVERFLOW_ERROR) {
+      status = U_ZERO_ERROR;
+    }
+    buffer1 = (uint8_t *)uprv_malloc(length1);
+    ucnvsel_serialize(sel1, buffer1, length1, &status);
+    if (U_FAILURE(status)) {
+      log_err("unable to serialize a selector - %s\n", u_errorName(status));
+    } else {
+      checkOpenWithCache("same excluded code points", encodings, num_encodings,
+                         excluded1, UCNV_ROUNDTRIP_SET, buffer1, length1, sel1, TRUE);
+      checkOpenWithCache("excluded code points with the same hash", encodings, num_encodings,
+                         excluded2, UCNV_ROUNDTRIP_SET, buffer1, length1, sel2, FALSE);
+    }
+    ucnvsel_close(sel1);
+    ucnvsel_close(sel2);
+    uset_close(excluded1);
+    uset_close(excluded2);
+    uprv_free(buffer1);
+  }
+
+  /* dataVersion in the DataHeader's UDataInfo */
+  uprv_memcpy(copy, buffer, length);
+  copy[20] ^= 1;
+  checkOpenWithCache("different data version", encodings, num_encodings,
+                     excluded, UCNV_ROUNDTRIP_SET, copy, length, sel, FALSE);
+
+  /* formatVersion 1.0 data does not record the cache key */
+  uprv_memcpy(copy, buffer, length);
+  copy[17] = 0;
+  checkOpenWithCache("formatVersion 1.0", encodings, num_encodings,
+                     excluded, UCNV_ROUNDTRIP_SET, copy, length, sel, FALSE);
+
+  /* invalid cached data is rebuilt */
+  uprv_memcpy(copy, buffer, length);
+  copy[2] = 0;
+  checkOpenWithCache("invalid data", encodings, num_encodings,
+                     excluded, UCNV_ROUNDTRIP_SET, copy, length, sel, FALSE);
+  checkOpenWithCache("truncated data", encodings, num_encodings,
+                     excluded, UCNV_ROUNDTRIP_SET, buffer, 40, sel, FALSE);
+
+  /* section lengths that do not fit into the data */
+  {
+    /* indexes[] after the 32-byte DataHeader */
+    static const struct {
+      const char *name;
+      int32_t index, delta;
+    } corruptions[] = {
+      { "negative trie size", 0, -0x10000 },
+      { "too many bit vectors", 1, 0x10000 },
+      { "fewer bit vectors than trie values", 1, -4 },
+      { "negative number of names", 2, -0x10000 },
+      { "more names than bytes", 2, 0x10000 },
+      { "unterminated names", 2, 1 },
+      { "too many name bytes", 3, 0x10000 },
+      { "negative number of excluded ranges", 6, -0x10000 },
+      { "too many excluded ranges", 6, 0x10000 },
+      { "odd number of excluded range limits", 6, 1 },
+      { "too short for its indexes", 15, -0x10000 }
+    };
+    int32_t i;
+    for (i = 0; i < UPRV_LENGTHOF(corruptions); ++i) {
+      UConverterSelector *corrupt;
+      uprv_memcpy(copy, buffer, length);
+      ((int32_t *)(copy + 32))[corruptions[i].index] += corruptions[i].delta;
+      status = U_ZERO_ERROR;
+      corrupt = ucnvsel_openFromSerialized(copy, length, &status);
+      if (status != U_INVALID_FORMAT_ERROR) {
+        log_err("ucnvsel_openFromSerialized(%s) did not fail with U_INVALID_FORMAT_ERROR - %s\n",
+                corruptions[i].name, u_errorName(status));
+      }
+      ucnvsel_close(corrupt);
+      checkOpenWithCache(corruptions[i].name, encodings, num_encodings,
+                         excluded, UCNV_ROUNDTRIP_SET, copy, length, sel, FALSE);
+    }
+    status = U_ZERO_ERROR;
+  }
+
+  /* all available converters, with more than 128 bits per row */
+  {
+    static const UChar text[] = {
+      0x61, 0x62, 0x63, 0xe4, 0xe4, 0x3b1, 0x3b2, 0x3b3, 0x3042, 0x3044, 0x4e00, 0x4e01, 0
+    };
+    char utf8[64];
+    int32_t length8, allLength, prefixLength;
+    uint8_t *allBuffer;
+    UConverterSelector *sel_all, *sel_cached;
+    UBool *manual;
+
+    status = U_ZERO_ERROR;
+    sel_all = ucnvsel_open(NULL, 0, NULL, UCNV_ROUNDTRIP_SET, &status);
+    allLength = ucnvsel_serialize(sel_all, NULL, 0, &status);
+    if (status == U_BUFFER_OVERFLOW_ERROR) {
+      status = U_ZERO_ERROR;
+    }
+    allBuffer = (uint8_t *)uprv_malloc(allLength);
+    ucnvsel_serialize(sel_all, allBuffer, allLength, &status);
+    isFromCache = FALSE;
+    sel_cached = ucnvsel_openWithCache(NULL, 0, NULL, UCNV_ROUNDTRIP_SET,
+                                       allBuffer, allLength, &isFromCache, &status);
+    if (U_FAILURE(status) || !isFromCache) {
+      log_err("ucnvsel_openWithCache(all converters) failed or rebuilt - %s\n",
+              u_errorName(status));
+    } else {
+      /* each prefix ends with a different script and has fewer selected encodings */
+      for (prefixLength = 3; prefixLength <= UPRV_LENGTHOF(text) - 1; prefixLength += 3) {
+        u_strToUTF8(utf8, UPRV_LENGTHOF(utf8), &length8, text, prefixLength, &status);
+        manual = getResultsManually(gAvailableNames, gCountAvailable, utf8, length8,
+                                    NULL, UCNV_ROUNDTRIP_SET);
+        verifyResult(ucnvsel_selectForString(sel_all, text, prefixLength, &status), manual);
+        verifyResult(ucnvsel_selectForString(sel_cached, text, prefixLength, &status), manual);
+        verifyResult(ucnvsel_selectForUTF8(sel_cached, utf8, length8, &status), manual);
+        uprv_free(manual);
+      }
+    }
+    ucnvsel_close(sel_cached);
+    ucnvsel_close(sel_all);
+    uprv_free(allBuffer);
+  }
+
+  status = U_ZERO_ERROR;
+  isFromCache = TRUE;
+  ucnvsel_openWithCache(encodings, num_encodings, excluded, UCNV_ROUNDTRIP_SET,
+                        NULL, length, &isFromCache, &status);
+  if (status != U_ILLEGAL_ARGUMENT_ERROR || isFromCache) {
+    log_err("ucnvsel_openWithCache(NULL cache, length>0) did not fail properly - %s\n",
+            u_errorName(status));
+  }
+
+  ucnvsel_close(sel);
+  ucnvsel_close(sel_fb);
+  uset_close(excluded);
+  uprv_free(buffer);
+  uprv_free(copy);
+  uprv_free((void *)encodings);
+  releaseAvailableNames();
+}
@@ -28,6 +28,7 @@
 #include "cstring.h"
 #include "filestrm.h"
 #include "udatamem.h"
+#include "umapfile.h"
 #include "cintltst.h"
 #include "ubrkimpl.h"
 #include "toolutil.h" /* for uprv_fileExists() */
@@ -71,6 +72,8 @@ static void TestSwapData(void);
 static void TestUDataSetAppData(void);
 static void TestICUDataName(void);
 static void PointerTableOfContents(void);
+static void TestTOCHashIndex(void);
+static void TestMapPolicy(void);
 static void SetBadCommonData(void);
 static void TestUDataFileAccess(void);
 #if !UCONFIG_NO_FORMATTING && !UCONFIG_NO_FILE_IO && !UCONFIG_NO_LEGACY_CONVERSION
@@ -95,6 +98,8 @@ addUDataTest(TestNode** root)
     addTest(root, &TestUDataSetAppData, "udatatst/TestUDataSetAppData" );
     addTest(root, &TestICUDataName, "udatatst/TestICUDataName" );
     addTest(root, &PointerTableOfContents, "udatatst/PointerTableOfContents" );
+    addTest(root, &TestTOCHashIndex, "udatatst/TestTOCHashIndex" );
+    addTest(root, &TestMapPolicy, "udatatst/TestMapPolicy" );
     addTest(root, &SetBadCommonData, "udatatst/SetBadCommonData" );
     addTest(root, &TestUDataFileAccess, "udatatst/TestUDataFileAccess" );
 #if !UCONFIG_NO_FORMATTING && !UCONFIG_NO_FILE_IO && !UCONFIG_NO_LEGACY_CONVERSION
@@ -489,6 +494,24 @@ static void TestUDataSetAppData(){
                 " returned status of %s, expected U_USING_DEFAULT_WARNING.\n", u_errorName(status));
     }
 
+    /* More packages than fit into the fixed-size part of the data cache must also be found. */
+    {
+        char name[20];
+        int32_t i, pass;
+        for (pass = 0; pass < 2; ++pass) {
+            for (i = 0; i < 60; ++i) {
+                sprintf(name, "appDataMany%d", (int)i);
+                status=U_ZERO_ERROR;
+                udata_setAppData(name, &gEmptyHeader, &status);
+                if (status != (pass == 0 ? U_ZERO_ERROR : U_USING_DEFAULT_WARNING)) {
+                    log_err("FAIL: TestUDataSetAppData(): udata_setAppData(\"%s\") pass %d "
+                            " returned status of %s\n", name, (int)pass, u_errorName(status));
+                    return;
+                }
+            }
+        }
+    }
+
 
     /** It is no longer  correct to use udata_setAppData to change the 
         package of a contained item.
@@ -1792,6 +1815,214 @@ static void PointerTableOfContents() {
 
 }
 
+static void setTOCTestHeader(DataHeader *pHeader, const char *dataFormat) {
+    uprv_memset(pHeader, 0, 32);
+    pHeader->dataHeader.headerSize=32;
+    pHeader->dataHeader.magic1=0xda;
+    pHeader->dataHeader.magic2=0x27;
+    pHeader->info.size=(uint16_t)sizeof(UDataInfo);
+    pHeader->info.isBigEndian=U_IS_BIG_ENDIAN;
+    pHeader->info.charsetFamily=U_CHARSET_FAMILY;
+    pHeader->info.sizeofUChar=U_SIZEOF_UCHAR;
+    uprv_memcpy(pHeader->info.dataFormat, dataFormat, 4);
+    pHeader->info.formatVersion[0]=1;
+}
+
+/* The TOC hash index item may be the last item, whose length is not known from the TOC. */
+static void TestTOCHashIndexAsLastItem(void) {
+    static const char *const names[2]={ "pkg/a.res", "pkg/tochash.icu" };
+    uint32_t package[64];
+    char *data=(char *)package;
+    UDataOffsetTOC *toc=(UDataOffsetTOC *)(data+32);
+    uint32_t *tocHash=(uint32_t *)(data+32+96+32);
+    UErrorCode status=U_ZERO_ERROR;
+    UDataMemory mem;
+    uint32_t seed=0, d, h0, h1;
+    int32_t i, itemLength;
+
+    uprv_memset(package, 0, sizeof(package));
+    setTOCTestHeader((DataHeader *)data, "CmnD");
+    toc->count=2;
+    toc->entry[0].nameOffset=20;
+    toc->entry[0].dataOffset=48;
+    toc->entry[1].nameOffset=30;
+    toc->entry[1].dataOffset=96;
+    uprv_strcpy((char *)toc+20, names[0]);
+    uprv_strcpy((char *)toc+30, names[1]);
+    setTOCTestHeader((DataHeader *)((char *)toc+48), "Test");
+    setTOCTestHeader((DataHeader *)((char *)toc+96), "TocH");
+
+    /* one bucket: find a displacement that separates the two names */
+    for(d=0;; ++d) {
+        h0=udata_hashTOCName(names[0], UDATA_TOC_HASH_SLOT_SEED(seed, d))%2;
+        h1=udata_hashTOCName(names[1], UDATA_TOC_HASH_SLOT_SEED(seed, d))%2;
+        if(h0!=h1) {
+            break;
+        }
+    }
+    tocHash[UDATA_TOC_HASH_IX_ITEM_COUNT]=2;
+    tocHash[UDATA_TOC_HASH_IX_BUCKET_COUNT]=1;
+    tocHash[UDATA_TOC_HASH_IX_SEED]=seed;
+    tocHash[UDATA_TOC_HASH_IX_TOC_CHECKSUM]=udata_checksumTOC(toc->entry, 2);
+    tocHash[UDATA_TOC_HASH_IX_COUNT]=d;
+    tocHash[UDATA_TOC_HASH_IX_COUNT+1+h0]=0;
+    tocHash[UDATA_TOC_HASH_IX_COUNT+1+h1]=1;
+
+    UDataMemory_init(&mem);
+    UDataMemory_setData(&mem, data);
+    udata_checkCommonData(&mem, &status);
+    if(U_FAILURE(status) || mem.tocHash!=tocHash) {
+        log_err("a TOC hash index as the last item was not used - %s\n", u_errorName(status));
+        return;
+    }
+    for(i=0; i<2; ++i) {
+        const DataHeader *pHeader=mem.vFuncs->Lookup(&mem, names[i], &itemLength, &status);
+        if(pHeader!=(const DataHeader *)((char *)toc+toc->entry[i].dataOffset)) {
+            log_err("TOC hash index lookup of %s did not find its item\n", names[i]);
+        }
+    }
+
+    /* An index with more buckets than items is ignored. */
+    tocHash[UDATA_TOC_HASH_IX_BUCKET_COUNT]=3;
+    UDataMemory_init(&mem);
+    UDataMemory_setData(&mem, data);
+    udata_checkCommonData(&mem, &status);
+    if(U_FAILURE(status) || mem.tocHash!=NULL) {
+        log_err("a TOC hash index with too many buckets was used - %s\n", u_errorName(status));
+    }
+}
+
+/* Package tools add a hash index to the TOC; lookups must find the same items as binary search. */
+static void TestTOCHashIndex(void) {
+    UErrorCode status=U_ZERO_ERROR;
+    UDataMemory mem;
+    const UDataOffsetTOC *toc;
+    const char *base;
+    char filename[1024];
+    FileStream *file;
+    char *data;
+    int32_t length, i, count, itemLength;
+    const char *testPath=loadTestData(&status);
+    if(U_FAILURE(status)) {
+        log_data_err("Could not load testdata.dat, status = %s\n", u_errorName(status));
+        return;
+    }
+    if(uprv_strlen(testPath)+5>=sizeof(filename)) {
+        log_err("testdata path too long\n");
+        return;
+    }
+    uprv_strcpy(filename, testPath);
+    uprv_strcat(filename, ".dat");
+    file=T_FileStream_open(filename, "rb");
+    if(file==NULL) {
+        log_data_err("unable to open %s\n", filename);
+        return;
+    }
+    length=T_FileStream_size(file);
+    data=(char *)uprv_malloc(length);
+    if(data==NULL || T_FileStream_read(file, data, length)!=length) {
+        log_err("unable to read %s\n", filename);
+        T_FileStream_close(file);
+        uprv_free(data);
+        return;
+    }
+    T_FileStream_close(file);
+
+    UDataMemory_init(&mem);
+    UDataMemory_setData(&mem, data);
+    udata_checkCommonData(&mem, &status);
+    if(U_FAILURE(status) || mem.tocHash==NULL) {
+        log_err("%s has no valid TOC hash index - %s\n", filename, u_errorName(status));
+        uprv_free(data);
+        return;
+    }
+    toc=(const UDataOffsetTOC *)mem.toc;
+    base=(const char *)toc;
+    count=(int32_t)toc->count;
+    for(i=0; i<count; ++i) {
+        const DataHeader *pHeader=mem.vFuncs->Lookup(&mem, base+toc->entry[i].nameOffset, &itemLength, &status);
+        if(pHeader!=(const DataHeader *)(base+toc->entry[i].dataOffset)) {
+            log_err("TOC hash index lookup of %s did not find its item\n", base+toc->entry[i].nameOffset);
+        }
+    }
+    if(mem.vFuncs->Lookup(&mem, "testdata/nonexistent.res", &itemLength, &status)!=NULL) {
+        log_err("TOC hash index lookup found a nonexistent item\n");
+    }
+
+    /* An index that does not match its TOC is ignored. */
+    ((uint32_t *)mem.tocHash)[UDATA_TOC_HASH_IX_TOC_CHECKSUM]^=1;
+    UDataMemory_init(&mem);
+    UDataMemory_setData(&mem, data);
+    udata_checkCommonData(&mem, &status);
+    if(U_FAILURE(status) || mem.tocHash!=NULL) {
+        log_err("a TOC hash index with a wrong checksum was used - %s\n", u_errorName(status));
+    }
+    uprv_free(data);
+    TestTOCHashIndexAsLastItem();
+}
+
+/* Each mapping policy must yield the same data as the default mapping. */
+static void TestMapPolicy(void) {
+    static const uint32_t policies[] = {
+        UDATA_MAP_PREFAULT,
+        UDATA_MAP_HUGE_PAGES,
+        UDATA_MAP_LOCK,
+        UDATA_MAP_COPY,
+        UDATA_MAP_COPY|UDATA_MAP_HUGE_PAGES|UDATA_MAP_LOCK
+    };
+    UErrorCode status=U_ZERO_ERROR;
+    UDataMemory expected, actual;
+    char filename[1024];
+    FileStream *file;
+    int32_t i, length;
+    const char *testPath=loadTestData(&status);
+    if(U_FAILURE(status)) {
+        log_data_err("Could not load testdata.dat, status = %s\n", u_errorName(status));
+        return;
+    }
+    if(uprv_strlen(testPath)+5>=sizeof(filename)) {
+        log_err("testdata path too long\n");
+        return;
+    }
+    uprv_strcpy(filename, testPath);
+    uprv_strcat(filename, ".dat");
+    file=T_FileStream_open(filename, "rb");
+    if(file==NULL) {
+        log_data_err("unable to open %s\n", filename);
+        return;
+    }
+    length=T_FileStream_size(file);
+    T_FileStream_close(file);
+    if(!uprv_mapFile(&expected, filename)) {
+        log_err("unable to map %s\n", filename);
+        return;
+    }
+    for(i=0; i<UPRV_LENGTHOF(policies); ++i) {
+        udata_setMapPolicy(policies[i], &status);
+        if(U_FAILURE(status)) {
+            log_err("udata_setMapPolicy(0x%x) failed - %s\n", (int)policies[i], u_errorName(status));
+            break;
+        }
+        if(!uprv_mapFile(&actual, filename)) {
+            log_err("unable to map %s with policy 0x%x\n", filename, (int)policies[i]);
+            continue;
+        }
+        if(uprv_memcmp(actual.pHeader, expected.pHeader, length)!=0) {
+            log_err("%s mapped with policy 0x%x has different contents\n", filename, (int)policies[i]);
+        }
+        uprv_unmapFile(&actual);
+    }
+    uprv_unmapFile(&expected);
+    status=U_ZERO_ERROR;
+    udata_setMapPolicy(UDATA_MAP_DEFAULT, &status);
+
+    udata_setMapPolicy(0x100, &status);
+    if(status!=U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("udata_setMapPolicy(unknown flag) returned %s instead of U_ILLEGAL_ARGUMENT_ERROR\n",
+                u_errorName(status));
+    }
+}
+
 static void SetBadCommonData(void) {
     /* It's difficult to test that udata_setCommonData really works within the test framework.
        So we just test that foolish people can't do bad things. */
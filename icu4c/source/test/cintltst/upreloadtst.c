@@ -0,0 +1,171 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/* C API TEST for upreload_preloadLocales() */
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_FORMATTING
+
+#include "unicode/ucache.h"
+#include "unicode/ucol.h"
+#include "unicode/uloc.h"
+#include "unicode/unum.h"
+#include "unicode/upluralrules.h"
+#include "unicode/upreload.h"
+#include "cintltst.h"
+#include "cmemory.h"
+#include "cstring.h"
+
+static void TestPreloadLocales(void);
+static void TestPreloadWithExecutor(void);
+static void TestPreloadDefaultLocale(void);
+
+void addPreloadTest(TestNode** root);
+
+#define TESTCASE(x) addTest(root, &x, "tsformat/upreloadtst/" #x)
+
+void addPreloadTest(TestNode** root)
+{
+    TESTCASE(TestPreloadLocales);
+    TESTCASE(TestPreloadWithExecutor);
+    TESTCASE(TestPreloadDefaultLocale);
+}
+
+static const char *const preloadLocales[] = { "de", "ja_JP" };
+
+static int64_t getMissCount(void) {
+    UCacheStatistics stats[32];
+    UErrorCode status = U_ZERO_ERROR;
+    int64_t misses = 0;
+    int32_t i;
+    int32_t length = ucache_getStatistics(stats, UPRV_LENGTHOF(stats), &status);
+    if (U_FAILURE(status)) {
+        log_err("ucache_getStatistics() failed: %s\n", u_errorName(status));
+        return -1;
+    }
+    for (i = 0; i < length; ++i) {
+        misses += stats[i].missCount;
+    }
+    return misses;
+}
+
+static void TestPreloadLocales(void) {
+    UErrorCode status = U_ZERO_ERROR;
+    UNumberFormat *nf;
+    UPluralRules *rules;
+    int64_t misses;
+
+    upreload_preloadLocales(preloadLocales, UPRV_LENGTHOF(preloadLocales),
+                            UPRELOAD_ALL, NULL, NULL, &status);
+    if (U_FAILURE(status)) {
+        log_data_err("upreload_preloadLocales() failed: %s\n", u_errorName(status));
+        return;
+    }
+
+    /* The objects created after preloading come from the cache. */
+    ucache_resetStatistics(&status);
+    nf = unum_open(UNUM_DECIMAL, NULL, 0, "de", NULL, &status);
+    unum_close(nf);
+    rules = uplrules_open("ja_JP", &status);
+    uplrules_close(rules);
+#if !UCONFIG_NO_COLLATION
+    {
+        UCollator *coll = ucol_open("ja_JP", &status);
+        ucol_close(coll);
+    }
+#endif
+    if (U_FAILURE(status)) {
+        log_err("opening services failed: %s\n", u_errorName(status));
+        return;
+    }
+    misses = getMissCount();
+    if (misses != 0) {
+        log_err("%d cache misses after preloading\n", (int)misses);
+    }
+
+    status = U_ZERO_ERROR;
+    upreload_preloadLocales(preloadLocales, 1, 0x10000, NULL, NULL, &status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("unknown service flag: got %s instead of U_ILLEGAL_ARGUMENT_ERROR\n",
+                u_errorName(status));
+    }
+}
+
+typedef struct ExecutorCounter {
+    int32_t count;
+} ExecutorCounter;
+
+static void U_CALLCONV countingExecutor(const void *context, UTaskFn *taskFn, void *task) {
+    ExecutorCounter *counter = (ExecutorCounter *)context;
+    ++counter->count;
+    taskFn(task);
+}
+
+static void TestPreloadWithExecutor(void) {
+    UErrorCode status = U_ZERO_ERROR;
+    ExecutorCounter counter = { 0 };
+    upreload_preloadLocales(preloadLocales, UPRV_LENGTHOF(preloadLocales),
+                            UPRELOAD_NUMBER_FORMAT | UPRELOAD_PLURAL_RULES,
+                            countingExecutor, &counter, &status);
+    if (U_FAILURE(status)) {
+        log_err("upreload_preloadLocales() with executor failed: %s\n", u_errorName(status));
+        return;
+    }
+    if (counter.count != UPRV_LENGTHOF(preloadLocales)) {
+        log_err("expected one task per locale, got %d tasks\n", (int)counter.count);
+    }
+}
+
+typedef struct DeferringExecutor {
+    UTaskFn *taskFn;
+    void *task;
+} DeferringExecutor;
+
+static void U_CALLCONV deferringExecutor(const void *context, UTaskFn *taskFn, void *task) {
+    DeferringExecutor *executor = (DeferringExecutor *)context;
+    executor->taskFn = taskFn;
+    executor->task = task;
+}
+
+/* A NULL locale ID is the default locale when the function is called, also for a task. */
+static void TestPreloadDefaultLocale(void) {
+    static const char *const defaultLocales[] = { NULL };
+    UErrorCode status = U_ZERO_ERROR;
+    DeferringExecutor executor = { NULL, NULL };
+    UNumberFormat *nf;
+    UPluralRules *rules;
+    int64_t misses;
+    char savedDefault[ULOC_FULLNAME_CAPACITY];
+
+    uprv_strcpy(savedDefault, uloc_getDefault());
+    uloc_setDefault("yo_BJ", &status);
+    upreload_preloadLocales(defaultLocales, 1,
+                            UPRELOAD_NUMBER_FORMAT | UPRELOAD_PLURAL_RULES,
+                            deferringExecutor, &executor, &status);
+    if (U_FAILURE(status) || executor.task == NULL) {
+        log_err("upreload_preloadLocales(NULL locale) with executor failed: %s\n",
+                u_errorName(status));
+        uloc_setDefault(savedDefault, &status);
+        return;
+    }
+    /* The task runs after the default locale changed again. */
+    uloc_setDefault("en_US", &status);
+    executor.taskFn(executor.task);
+
+    ucache_resetStatistics(&status);
+    nf = unum_open(UNUM_DECIMAL, NULL, 0, "yo_BJ", NULL, &status);
+    unum_close(nf);
+    rules = uplrules_open("yo_BJ", &status);
+    uplrules_close(rules);
+    uloc_setDefault(savedDefault, &status);
+    if (U_FAILURE(status)) {
+        log_err("opening services failed: %s\n", u_errorName(status));
+        return;
+    }
+    misses = getMissCount();
+    if (misses != 0) {
+        log_err("%d cache misses after preloading the default locale\n", (int)misses);
+    }
+}
+
+#endif /* #if !UCONFIG_NO_FORMATTING */
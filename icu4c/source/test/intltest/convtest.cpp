@@ -31,6 +31,8 @@
  * not testing conversion for a custom configuration like this should be ok.
  */
 
+#include "unicode/bytestream.h"
+#include "unicode/convstream.h"
 #include "unicode/ucnv.h"
 #include "unicode/unistr.h"
 #include "unicode/parsepos.h"
@@ -43,6 +45,7 @@
 #include "unicode/tstdtmod.h"
 #include <string.h>
 #include <stdlib.h>
+#include <string>
 
 enum {
     // characters used in test data for callbacks
@@ -77,6 +80,7 @@ ConversionTest::runIndexedTest(int32_t index, UBool exec, const char *&name, cha
     TESTCASE_AUTO(TestGetUnicodeSet2);
     TESTCASE_AUTO(TestDefaultIgnorableCallback);
     TESTCASE_AUTO(TestUTF8ToUTF8Overflow);
+    TESTCASE_AUTO(TestConverterStream);
     TESTCASE_AUTO_END;
 }
 
@@ -839,6 +843,124 @@ ConversionTest::TestUTF8ToUTF8Overflow() {
     }
 }
 
+namespace {
+
+// Hands out small buffers of its own, so that ConverterStream
+// must convert each segment in several steps.
+class SmallBufferByteSink : public ByteSink {
+public:
+    SmallBufferByteSink(std::string &dest) : dest_(dest) {}
+    virtual void Append(const char *bytes, int32_t n) {
+        dest_.append(bytes, n);
+    }
+    virtual char *GetAppendBuffer(int32_t min_capacity, int32_t /*desired_capacity_hint*/,
+                                  char *scratch, int32_t scratch_capacity,
+                                  int32_t *result_capacity) {
+        if (min_capacity > (int32_t)sizeof(buffer_)) {
+            *result_capacity = scratch_capacity;
+            return scratch;
+        }
+        *result_capacity = (int32_t)sizeof(buffer_);
+        return buffer_;
+    }
+private:
+    std::string &dest_;
+    char buffer_[17];
+};
+
+}  // namespace
+
+void
+ConversionTest::TestConverterStream() {
+    IcuTestErrorCode errorCode(*this, "TestConverterStream");
+    LocalUConverterPointer sjis(ucnv_open("Shift-JIS", errorCode));
+    LocalUConverterPointer utf8(ucnv_open("UTF-8", errorCode));
+    if (errorCode.errIfFailureAndReset("ucnv_open(Shift-JIS and UTF-8)")) {
+        return;
+    }
+    UnicodeString text;
+    for (int32_t i = 0; i < 100; ++i) {
+        text.append((UChar)(0x61 + i % 26)).append((UChar)(0x3041 + i % 80));
+        text.append((UChar)(0x4e00 + i * 7)).append((UChar)(0xff71 + i % 40));
+    }
+    // Text ending with a truncated character: flushing substitutes it.
+    char source[1000];
+    int32_t sourceLength = text.extract(source, (int32_t)sizeof(source) - 1, sjis.getAlias(), errorCode);
+    source[sourceLength++] = (char)0x82;
+    char expected[2000];
+    int32_t expectedLength = ucnv_convert("UTF-8", "Shift-JIS", expected, (int32_t)sizeof(expected),
+                                          source, sourceLength, errorCode);
+    if (errorCode.errIfFailureAndReset("ucnv_convert(Shift-JIS -> UTF-8)")) {
+        return;
+    }
+
+    ConverterStream stream(utf8.getAlias(), sjis.getAlias());
+    static const int32_t segmentLengths[] = { 1, 2, 3, 5, 64, 1000 };
+    for (int32_t segmentLength : segmentLengths) {
+        UConverterSegment segments[1000];
+        int32_t count = 0;
+        for (int32_t start = 0; start < sourceLength; start += segmentLength) {
+            segments[count].data = source + start;
+            segments[count].length = sourceLength - start < segmentLength ?
+                sourceLength - start : segmentLength;
+            ++count;
+        }
+
+        // Two calls, the second one flushing.
+        std::string result;
+        StringByteSink<std::string> sink(&result);
+        stream.convert(segments, count / 2, sink, FALSE, errorCode);
+        stream.convert(segments + count / 2, count - count / 2, sink, TRUE, errorCode);
+        assertSuccess("two calls", errorCode);
+        assertTrue("two calls result", result == std::string(expected, expectedLength));
+
+        // Small sink buffers, and an extra flush-only call.
+        // The stream starts over after the previous flush.
+        std::string result2;
+        SmallBufferByteSink smallSink(result2);
+        stream.convert(segments, count, smallSink, FALSE, errorCode);
+        stream.convert(NULL, 0, smallSink, TRUE, errorCode);
+        assertSuccess("small buffers", errorCode);
+        assertTrue("small buffers result", result2 == std::string(expected, expectedLength));
+
+        // Writing directly into the destination array.
+        char dest[2000];
+        CheckedArrayByteSink arraySink(dest, expectedLength);
+        stream.convert(segments, count, arraySink, TRUE, errorCode);
+        assertSuccess("array sink", errorCode);
+        assertFalse("array sink overflow", arraySink.Overflowed());
+        assertEquals("array sink length", expectedLength, arraySink.NumberOfBytesAppended());
+        assertTrue("array sink result", uprv_memcmp(dest, expected, expectedLength) == 0);
+    }
+
+    // Without flushing, the truncated character is held back until reset().
+    std::string result;
+    StringByteSink<std::string> sink(&result);
+    stream.convert(StringPiece(source, sourceLength), sink, FALSE, errorCode);
+    char unflushed[2000];
+    int32_t unflushedLength = ucnv_convert("UTF-8", "Shift-JIS", unflushed, (int32_t)sizeof(unflushed),
+                                           source, sourceLength - 1, errorCode);
+    assertTrue("unflushed result", result == std::string(unflushed, unflushedLength));
+    stream.reset();
+    result.clear();
+    stream.convert(StringPiece("\x88\xea"), sink, TRUE, errorCode);
+    assertSuccess("after reset", errorCode);
+    assertTrue("after reset result", result == "\xe4\xb8\x80");
+
+    // Errors.
+    stream.convert(NULL, -1, sink, TRUE, errorCode);
+    assertEquals("count<0", U_ILLEGAL_ARGUMENT_ERROR, errorCode.reset());
+    UConverterSegment badSegment = { NULL, 5 };
+    stream.convert(&badSegment, 1, sink, TRUE, errorCode);
+    assertEquals("NULL data", U_ILLEGAL_ARGUMENT_ERROR, errorCode.reset());
+    ucnv_setToUCallBack(sjis.getAlias(), UCNV_TO_U_CALLBACK_STOP, NULL, NULL, NULL, errorCode);
+    stream.reset();
+    result.clear();
+    stream.convert(StringPiece("ab\x82"), sink, TRUE, errorCode);
+    assertEquals("stop callback", U_TRUNCATED_CHAR_FOUND, errorCode.reset());
+    assertTrue("output before the error", result == "ab");
+}
+
 // open testdata or ICU data converter ------------------------------------- ***
 
 UConverter *
@@ -16,12 +16,15 @@
 #include "uparse.h"
 #include "unicode/localpointer.h"
 #include "unicode/resbund.h"
+#include "unicode/ures.h"
 #include "unicode/udata.h"
 #include "unicode/uloc.h"
 #include "unicode/locid.h"
 #include "putilimp.h"
 #include "intltest.h"
 #include "tsmthred.h"
+#include "unicode/ucnv.h"
+#include "unicode/normalizer2.h"
 #include "unicode/ushape.h"
 #include "unicode/translit.h"
 #include "sharedobject.h"
@@ -78,10 +81,17 @@ void MultithreadTest::runIndexedTest( int32_t index, UBool exec,
     TESTCASE_AUTO(TestAnyTranslit);
     TESTCASE_AUTO(TestConditionVariables);
     TESTCASE_AUTO(TestUnifiedCache);
+    TESTCASE_AUTO(TestResourceBundleOpen);
 #if !UCONFIG_NO_TRANSLITERATION
     TESTCASE_AUTO(TestBreakTranslit);
     TESTCASE_AUTO(TestIncDec);
 #endif /* #if !UCONFIG_NO_TRANSLITERATION */
+#if !UCONFIG_NO_CONVERSION
+    TESTCASE_AUTO(TestBulkConversion);
+#endif
+#if !UCONFIG_NO_NORMALIZATION
+    TESTCASE_AUTO(TestBulkNormalization);
+#endif
     TESTCASE_AUTO_END
 }
 
@@ -1458,6 +1468,77 @@ void MultithreadTest::TestUnifiedCache() {
     }
 }
 
+//
+//  Resource bundle open threading test.
+//     Threads open the same bundles concurrently, mostly through the
+//     cache fast path, and check that they get the same results as a
+//     single-threaded open.
+//
+
+// Includes an alias (iw), a bundle without data (xx_YY), and bundles
+// with explicit or no parents.
+static const char *gResbLocales[] = {
+    "de_AT", "en_GB", "iw", "xx_YY", "sr_Latn_BA", "zh_Hant_HK", "root", "es_419"
+};
+static const char *gResbActualLocales[UPRV_LENGTHOF(gResbLocales)];
+static UErrorCode gResbStatus[UPRV_LENGTHOF(gResbLocales)];
+
+class ResourceBundleThread: public SimpleThread {
+  public:
+    void run();
+};
+
+void ResourceBundleThread::run() {
+    for (int32_t iteration = 0; iteration < 500; ++iteration) {
+        for (int32_t i = 0; i < UPRV_LENGTHOF(gResbLocales); ++i) {
+            UErrorCode status = U_ZERO_ERROR;
+            UResourceBundle *rb = ures_open(NULL, gResbLocales[i], &status);
+            const char *actual = ures_getLocaleByType(rb, ULOC_ACTUAL_LOCALE, &status);
+            if (status != gResbStatus[i] || uprv_strcmp(actual, gResbActualLocales[i]) != 0) {
+                IntlTest::gTest->errln("%s:%d ures_open(%s) got %s, %s expected %s, %s",
+                        __FILE__, __LINE__, gResbLocales[i], actual, u_errorName(status),
+                        gResbActualLocales[i], u_errorName(gResbStatus[i]));
+            }
+            ures_close(rb);
+        }
+        UErrorCode status = U_ZERO_ERROR;
+        UResourceBundle *rb = ures_openDirect(NULL, "supplementalData", &status);
+        if (U_FAILURE(status)) {
+            IntlTest::gTest->errln("%s:%d ures_openDirect(supplementalData) failed: %s",
+                    __FILE__, __LINE__, u_errorName(status));
+        }
+        ures_close(rb);
+    }
+}
+
+void MultithreadTest::TestResourceBundleOpen() {
+    // Reference results, which also prime the cache.
+    UResourceBundle *bundles[UPRV_LENGTHOF(gResbLocales)];
+    for (int32_t i = 0; i < UPRV_LENGTHOF(gResbLocales); ++i) {
+        gResbStatus[i] = U_ZERO_ERROR;
+        bundles[i] = ures_open(NULL, gResbLocales[i], &gResbStatus[i]);
+        UErrorCode status = U_ZERO_ERROR;
+        gResbActualLocales[i] = ures_getLocaleByType(bundles[i], ULOC_ACTUAL_LOCALE, &status);
+        if (U_FAILURE(gResbStatus[i]) || U_FAILURE(status)) {
+            dataerrln("ures_open(%s) failed: %s", gResbLocales[i], u_errorName(gResbStatus[i]));
+            return;
+        }
+    }
+
+    static constexpr int NUM_THREADS = 8;
+    ResourceBundleThread threads[NUM_THREADS];
+    for (auto &thread:threads) {
+        thread.start();
+    }
+    for (auto &thread:threads) {
+        thread.join();
+    }
+
+    for (int32_t i = 0; i < UPRV_LENGTHOF(gResbLocales); ++i) {
+        ures_close(bundles[i]);
+    }
+}
+
 #if !UCONFIG_NO_TRANSLITERATION
 //
 //  BreakTransliterator Threading Test
@@ -1550,3 +1631,214 @@ void MultithreadTest::TestIncDec()
 
 
 #endif /* !UCONFIG_NO_TRANSLITERATION */
+
+
+//-------------------------------------------------------------------------
+//
+//  An executor for the bulk APIs, which runs every task on a new thread.
+//
+//-------------------------------------------------------------------------
+
+class BulkTaskThread : public SimpleThread {
+  public:
+    BulkTaskThread(UTaskFn *taskFn, void *task) : fTaskFn(taskFn), fTask(task) {}
+    virtual void run() { fTaskFn(fTask); }
+  private:
+    UTaskFn *fTaskFn;
+    void *fTask;
+};
+
+struct BulkExecutor {
+    static constexpr int32_t MAX_THREADS = 64;
+    BulkTaskThread *threads[MAX_THREADS];
+    int32_t count;
+};
+
+static void U_CALLCONV bulkThreadExecutor(const void *context, UTaskFn *taskFn, void *task) {
+    BulkExecutor *executor = static_cast<BulkExecutor *>(const_cast<void *>(context));
+    if (executor->count < BulkExecutor::MAX_THREADS) {
+        BulkTaskThread *thread = new BulkTaskThread(taskFn, task);
+        if (thread->start() == 0) {
+            executor->threads[executor->count++] = thread;
+            return;
+        }
+        delete thread;
+    }
+    taskFn(task);
+}
+
+static void joinBulkThreads(BulkExecutor &executor) {
+    for (int32_t j = 0; j < executor.count; ++j) {
+        executor.threads[j]->join();
+        delete executor.threads[j];
+    }
+}
+
+#if !UCONFIG_NO_CONVERSION
+
+//-------------------------------------------------------------------------
+//
+//  TestBulkConversion. Several threads call ucnv_convertBulk() at the same time,
+//                      each with an executor that runs every task on a new thread.
+//
+//-------------------------------------------------------------------------
+
+static std::string gBulkSource;
+static std::string gBulkExpected;
+static u_atomic_int32_t gBulkFailures;
+
+class BulkConversionThread : public SimpleThread {
+  public:
+    virtual void run();
+};
+
+void BulkConversionThread::run() {
+    UErrorCode status = U_ZERO_ERROR;
+    LocalUConverterPointer utf8(ucnv_open("UTF-8", &status));
+    LocalUConverterPointer utf16(ucnv_open("UTF-16LE", &status));
+    if (U_FAILURE(status)) {
+        umtx_atomic_inc(&gBulkFailures);
+        return;
+    }
+    int32_t capacity = (int32_t)gBulkExpected.length() + 1;
+    LocalArray<char> target(new char[capacity]);
+    for (int32_t i = 0; i < 5; ++i) {
+        BulkExecutor executor;
+        executor.count = 0;
+        int32_t length = ucnv_convertBulk(utf16.getAlias(), utf8.getAlias(),
+                                          target.getAlias(), capacity,
+                                          gBulkSource.data(), (int32_t)gBulkSource.length(),
+                                          NULL, 1000, bulkThreadExecutor, &executor, &status);
+        joinBulkThreads(executor);
+        if (U_FAILURE(status) || length != (int32_t)gBulkExpected.length() ||
+                uprv_memcmp(target.getAlias(), gBulkExpected.data(), length) != 0 ||
+                executor.count == 0) {
+            umtx_atomic_inc(&gBulkFailures);
+            return;
+        }
+    }
+}
+
+void MultithreadTest::TestBulkConversion() {
+    UnicodeString text;
+    for (int32_t i = 0; i < 4000; ++i) {
+        text.append((UChar32)(0x20 + i % 0x60)).append((UChar32)(0x3b1 + i % 20));
+        text.append((UChar32)(0x4e00 + i)).append((UChar32)(0x1f600 + i % 50));
+    }
+    gBulkSource.clear();
+    text.toUTF8String(gBulkSource);
+    UErrorCode status = U_ZERO_ERROR;
+    int32_t expectedLength = ucnv_convert("UTF-16LE", "UTF-8", NULL, 0,
+                                          gBulkSource.data(), (int32_t)gBulkSource.length(),
+                                          &status);
+    gBulkExpected.assign(expectedLength, 0);
+    status = U_ZERO_ERROR;
+    ucnv_convert("UTF-16LE", "UTF-8", &gBulkExpected[0], expectedLength,
+                 gBulkSource.data(), (int32_t)gBulkSource.length(), &status);
+    if (U_FAILURE(status) && status != U_STRING_NOT_TERMINATED_WARNING) {
+        dataerrln("ucnv_convert(UTF-8 -> UTF-16LE) failed - %s", u_errorName(status));
+        return;
+    }
+
+    static constexpr int NUM_THREADS = 4;
+    gBulkFailures = 0;
+    BulkConversionThread threads[NUM_THREADS];
+    for (auto &thread:threads) {
+        thread.start();
+    }
+    for (auto &thread:threads) {
+        thread.join();
+    }
+    assertEquals("ucnv_convertBulk() failures", 0, gBulkFailures);
+}
+
+#endif /* !UCONFIG_NO_CONVERSION */
+
+#if !UCONFIG_NO_NORMALIZATION
+
+//-------------------------------------------------------------------------
+//
+//  TestBulkNormalization. Several threads call Normalizer2::normalizeBulk()
+//                         and normalizeUTF8Bulk() at the same time.
+//
+//-------------------------------------------------------------------------
+
+static UnicodeString gBulkNormSource;
+static UnicodeString gBulkNormExpected;
+static std::string gBulkNormSource8;
+static std::string gBulkNormExpected8;
+static u_atomic_int32_t gBulkNormFailures;
+
+class BulkNormalizationThread : public SimpleThread {
+  public:
+    virtual void run();
+};
+
+void BulkNormalizationThread::run() {
+    UErrorCode status = U_ZERO_ERROR;
+    const Normalizer2 *nfc = Normalizer2::getNFCInstance(status);
+    if (U_FAILURE(status)) {
+        umtx_atomic_inc(&gBulkNormFailures);
+        return;
+    }
+    for (int32_t i = 0; i < 5; ++i) {
+        BulkExecutor executor;
+        executor.count = 0;
+        UnicodeString result;
+        nfc->normalizeBulk(gBulkNormSource, result, 1000, bulkThreadExecutor, &executor, status);
+        joinBulkThreads(executor);
+        if (U_FAILURE(status) || result != gBulkNormExpected || executor.count == 0) {
+            umtx_atomic_inc(&gBulkNormFailures);
+            return;
+        }
+
+        executor.count = 0;
+        std::string result8;
+        StringByteSink<std::string> sink(&result8);
+        nfc->normalizeUTF8Bulk(0, gBulkNormSource8, sink, NULL, 1000,
+                               bulkThreadExecutor, &executor, status);
+        joinBulkThreads(executor);
+        if (U_FAILURE(status) || result8 != gBulkNormExpected8 || executor.count == 0) {
+            umtx_atomic_inc(&gBulkNormFailures);
+            return;
+        }
+    }
+}
+
+void MultithreadTest::TestBulkNormalization() {
+    gBulkNormSource.remove();
+    for (int32_t i = 0; i < 4000; ++i) {
+        gBulkNormSource.append((UChar32)(0x41 + i % 26)).append((UChar32)(0x300 + i % 5));
+        gBulkNormSource.append((UChar32)(0x1100 + i % 19)).append((UChar32)(0x1161 + i % 21));
+        gBulkNormSource.append((UChar32)(0x1d15e + i % 2)).append((UChar32)0x1d165);
+    }
+    gBulkNormSource8.clear();
+    gBulkNormSource.toUTF8String(gBulkNormSource8);
+    UErrorCode status = U_ZERO_ERROR;
+    const Normalizer2 *nfc = Normalizer2::getNFCInstance(status);
+    if (U_FAILURE(status)) {
+        dataerrln("Normalizer2::getNFCInstance() failed - %s", u_errorName(status));
+        return;
+    }
+    gBulkNormExpected = nfc->normalize(gBulkNormSource, status);
+    gBulkNormExpected8.clear();
+    StringByteSink<std::string> sink(&gBulkNormExpected8);
+    nfc->normalizeUTF8(0, gBulkNormSource8, sink, NULL, status);
+    if (U_FAILURE(status)) {
+        errln("Normalizer2::normalize() failed - %s", u_errorName(status));
+        return;
+    }
+
+    static constexpr int NUM_THREADS = 4;
+    gBulkNormFailures = 0;
+    BulkNormalizationThread threads[NUM_THREADS];
+    for (auto &thread:threads) {
+        thread.start();
+    }
+    for (auto &thread:threads) {
+        thread.join();
+    }
+    assertEquals("Normalizer2::normalizeBulk() failures", 0, gBulkNormFailures);
+}
+
+#endif /* !UCONFIG_NO_NORMALIZATION */
@@ -51,8 +51,11 @@ class MultithreadTest : public IntlTest
     void TestAnyTranslit();
     void TestConditionVariables();
     void TestUnifiedCache();
+    void TestResourceBundleOpen();
     void TestBreakTranslit();
     void TestIncDec();
+    void TestBulkConversion();
+    void TestBulkNormalization();
 };
 
 #endif
@@ -12,7 +12,10 @@
 
 #include "unicode/uchar.h"
 #include "unicode/errorcode.h"
+#include "unicode/appendable.h"
+#include "unicode/edits.h"
 #include "unicode/normlzr.h"
+#include "unicode/normstream.h"
 #include "unicode/stringoptions.h"
 #include "unicode/uniset.h"
 #include "unicode/usetiter.h"
@@ -60,6 +63,12 @@ void BasicNormalizerTest::runIndexedTest(int32_t index, UBool exec,
     TESTCASE_AUTO(TestNormalizeIllFormedText);
     TESTCASE_AUTO(TestComposeJamoTBase);
     TESTCASE_AUTO(TestComposeBoundaryAfter);
+    TESTCASE_AUTO(TestDecomposeUTF8WithEdits);
+    TESTCASE_AUTO(TestNormalizeUTF8AllModes);
+    TESTCASE_AUTO(TestLongRunsBelowMinimum);
+    TESTCASE_AUTO(TestNormalizerStream);
+    TESTCASE_AUTO(TestNormalizeBulk);
+    TESTCASE_AUTO(TestNormalizeBatch);
     TESTCASE_AUTO_END;
 }
 
@@ -1805,4 +1814,588 @@ BasicNormalizerTest::TestComposeBoundaryAfter() {
     assertFalse("U+FB2C boundary-after", nfkc->hasBoundaryAfter(0xFB2C));
 }
 
+void
+BasicNormalizerTest::TestDecomposeUTF8WithEdits() {
+    IcuTestErrorCode errorCode(*this, "TestDecomposeUTF8WithEdits");
+    const Normalizer2 *nfd = Normalizer2::getNFDInstance(errorCode);
+    const Normalizer2 *fcd = Normalizer2::getInstance(nullptr, "nfc", UNORM2_FCD, errorCode);
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getNFDInstance() call failed")) {
+        return;
+    }
+    static const char *const src = u8"  AÄẠ̈Ạ̈,가가  ";
+    std::string expected = u8"  AÄẠ̈Ạ̈,가가  ";
+    std::string result;
+    StringByteSink<std::string> sink(&result, expected.length());
+    Edits edits;
+    nfd->normalizeUTF8(0, src, sink, &edits, errorCode);
+    assertSuccess("NFD normalizeUTF8 with Edits", errorCode.get());
+    assertEquals("NFD normalizeUTF8 with Edits", expected.c_str(), result.c_str());
+    static const EditChange expectedChanges[] = {
+        { FALSE, 3, 3 },  // 2 spaces + A
+        { TRUE, 2, 3 },  // Ä→Ä
+        { FALSE, 1, 1 },  // A
+        { TRUE, 4, 4 },  // ̣̈→̣̈
+        { TRUE, 4, 5 },  // Ạ̈→Ạ̈
+        { FALSE, 7, 7 },  // comma + 가
+        { TRUE, 3, 6 },  // 가→가
+        { FALSE, 2, 2 }  // 2 spaces
+    };
+    assertTrue("NFD normalizeUTF8 with Edits hasChanges", edits.hasChanges());
+    assertEquals("NFD normalizeUTF8 with Edits numberOfChanges", 4, edits.numberOfChanges());
+    TestUtility::checkEditsIter(*this, u"NFD normalizeUTF8 with Edits",
+            edits.getFineIterator(), edits.getFineIterator(),
+            expectedChanges, UPRV_LENGTHOF(expectedChanges),
+            TRUE, errorCode);
+
+    assertFalse("NFD isNormalizedUTF8(source)", nfd->isNormalizedUTF8(src, errorCode));
+    assertTrue("NFD isNormalizedUTF8(normalized)", nfd->isNormalizedUTF8(result, errorCode));
+
+    // Omit unchanged text.
+    expected = u8"Ạ̈̈Ạ̈가";
+    result.clear();
+    edits.reset();
+    nfd->normalizeUTF8(U_OMIT_UNCHANGED_TEXT, src, sink, &edits, errorCode);
+    assertSuccess("NFD normalizeUTF8 omit unchanged", errorCode.get());
+    assertEquals("NFD normalizeUTF8 omit unchanged", expected.c_str(), result.c_str());
+    TestUtility::checkEditsIter(*this, u"NFD normalizeUTF8 omit unchanged",
+            edits.getFineIterator(), edits.getFineIterator(),
+            expectedChanges, UPRV_LENGTHOF(expectedChanges),
+            TRUE, errorCode);
+
+    // FCD decomposes only where the canonical order is broken.
+    expected = u8"  AÄẠ̈Ạ̈,가가  ";
+    result.clear();
+    edits.reset();
+    fcd->normalizeUTF8(0, src, sink, &edits, errorCode);
+    assertSuccess("FCD normalizeUTF8 with Edits", errorCode.get());
+    assertEquals("FCD normalizeUTF8 with Edits", expected.c_str(), result.c_str());
+    static const EditChange fcdChanges[] = {
+        { FALSE, 6, 6 },  // 2 spaces + AÄA
+        { TRUE, 4, 4 },  // ̣̈→̣̈
+        { TRUE, 4, 5 },  // Ạ̈→Ạ̈
+        { FALSE, 12, 12 }  // comma + 가가 + 2 spaces
+    };
+    assertEquals("FCD normalizeUTF8 with Edits numberOfChanges", 2, edits.numberOfChanges());
+    TestUtility::checkEditsIter(*this, u"FCD normalizeUTF8 with Edits",
+            edits.getFineIterator(), edits.getFineIterator(),
+            fcdChanges, UPRV_LENGTHOF(fcdChanges),
+            TRUE, errorCode);
+
+    assertFalse("FCD isNormalizedUTF8(source)", fcd->isNormalizedUTF8(src, errorCode));
+    assertTrue("FCD isNormalizedUTF8(normalized)", fcd->isNormalizedUTF8(result, errorCode));
+}
+
+void
+BasicNormalizerTest::TestNormalizeUTF8AllModes() {
+    // The UTF-8 implementations must yield the same results as the UTF-16 ones,
+    // and ill-formed sequences must be copied unchanged, as boundaries.
+    IcuTestErrorCode errorCode(*this, "TestNormalizeUTF8AllModes");
+    const Normalizer2 *n2s[] = {
+        Normalizer2::getNFCInstance(errorCode),
+        Normalizer2::getNFDInstance(errorCode),
+        Normalizer2::getNFKCInstance(errorCode),
+        Normalizer2::getNFKDInstance(errorCode),
+        Normalizer2::getInstance(nullptr, "nfc", UNORM2_FCD, errorCode),
+        Normalizer2::getInstance(nullptr, "nfc", UNORM2_COMPOSE_CONTIGUOUS, errorCode),
+        Normalizer2::getInstance(nullptr, "nfkc_cf", UNORM2_DECOMPOSE, errorCode),
+        Normalizer2::getInstance(nullptr, "nfkc_cf", UNORM2_FCD, errorCode)
+    };
+    static const char *const names[] = {
+        "NFC", "NFD", "NFKC", "NFKD", "FCD", "FCC", "NFKC_CF decompose", "NFKC_CF FCD"
+    };
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getInstance() call failed")) {
+        return;
+    }
+    static const char16_t *const strings[] = {
+        u"",
+        u"cat",
+        u"àardvark",
+        u"Ḍ̇",
+        u"Ḍ̨̇",
+        u"Ḑ̣̇",
+        u"ḔÅ̧",
+        u"ཱཱཱིྀུ ̴ཱིུ",
+        u"각각각퓛ᇂ",
+        u" שֶּׁ˚̹Ωﬁ",
+        u"x̣́ͅy­̀Z͏̧",
+        u"\U0001D15E\U0001D165\U0001D16D\U0001D16F\U0002F800",
+        u"ạ̈́̀́̈́ཷẛ̣"
+    };
+    for (int32_t i = 0; i < UPRV_LENGTHOF(n2s); ++i) {
+        const Normalizer2 &n2 = *n2s[i];
+        for (int32_t j = 0; j < UPRV_LENGTHOF(strings); ++j) {
+            UnicodeString s16(strings[j]);
+            UnicodeString expected16 = n2.normalize(s16, errorCode);
+            std::string s8, expected8, result8;
+            s16.toUTF8String(s8);
+            expected16.toUTF8String(expected8);
+            StringByteSink<std::string> sink(&result8);
+            Edits edits;
+            n2.normalizeUTF8(0, s8, sink, &edits, errorCode);
+            UnicodeString msg = UnicodeString(names[i], -1, US_INV) + u" strings[" + Int64ToUnicodeString(j) + u"]";
+            if (errorCode.errIfFailureAndReset("%s strings[%d] normalizeUTF8", names[i], (int)j)) {
+                return;
+            }
+            assertEquals(msg + u" normalizeUTF8", expected8.c_str(), result8.c_str());
+            assertEquals(msg + u" Edits length delta",
+                         (int32_t)(result8.length() - s8.length()), edits.lengthDelta());
+            assertEquals(msg + u" Edits hasChanges", (UBool)(s8 != result8), edits.hasChanges());
+            // Unchanged spans must be copies of the source.
+            for (Edits::Iterator ei = edits.getFineIterator(); ei.next(errorCode);) {
+                if (!ei.hasChange()) {
+                    assertTrue(msg + u" unchanged span",
+                               s8.compare(ei.sourceIndex(), ei.oldLength(),
+                                          result8, ei.destinationIndex(), ei.newLength()) == 0);
+                }
+            }
+            assertEquals(msg + u" isNormalizedUTF8(source)",
+                         n2.isNormalized(s16, errorCode), n2.isNormalizedUTF8(s8, errorCode));
+            assertTrue(msg + u" isNormalizedUTF8(normalized)",
+                       n2.isNormalizedUTF8(result8, errorCode));
+
+            // An ill-formed sequence between two strings is a normalization boundary.
+            static const char *const illFormed[] = { "\x80", "\xC0\x80", "\xED\xA0\x80", "\xF0" };
+            std::string prefix8;
+            UnicodeString(u"Ä").toUTF8String(prefix8);
+            const char *ill = illFormed[j % UPRV_LENGTHOF(illFormed)];
+            std::string joined8 = prefix8 + ill + s8 + ill;
+            std::string expectedJoined8;
+            UnicodeString(n2.normalize(UnicodeString(u"Ä"), errorCode)).
+                toUTF8String(expectedJoined8);
+            expectedJoined8.append(ill).append(expected8).append(ill);
+            result8.clear();
+            n2.normalizeUTF8(0, joined8, sink, nullptr, errorCode);
+            assertEquals(msg + u" normalizeUTF8(ill-formed)", expectedJoined8.c_str(), result8.c_str());
+            assertEquals(msg + u" isNormalizedUTF8(ill-formed)",
+                         (UBool)(n2.isNormalized(s16, errorCode) &&
+                             n2.isNormalized(UnicodeString(u"Ä"), errorCode)),
+                         n2.isNormalizedUTF8(joined8, errorCode));
+        }
+    }
+}
+
+void
+BasicNormalizerTest::TestLongRunsBelowMinimum() {
+    // Runs of characters below the quick check minimum are skipped
+    // many at a time. Put a character that needs work at every offset
+    // relative to those blocks, in both UTF-16 and UTF-8.
+    IcuTestErrorCode errorCode(*this, "TestLongRunsBelowMinimum");
+    const Normalizer2 *n2s[] = {
+        Normalizer2::getNFCInstance(errorCode),
+        Normalizer2::getNFDInstance(errorCode),
+        Normalizer2::getNFKCCasefoldInstance(errorCode),
+        Normalizer2::getInstance(nullptr, "nfc", UNORM2_FCD, errorCode)
+    };
+    static const char *const names[] = { "NFC", "NFD", "NFKC_CF", "FCD" };
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getInstance() call failed")) {
+        return;
+    }
+    // U+F900 is above U+7FFF and changes in all but FCD.
+    static const char16_t *const middles[] = { u"Ạ̈", u"豈", u"A", u"·" };
+    for (int32_t i = 0; i < UPRV_LENGTHOF(n2s); ++i) {
+        const Normalizer2 &n2 = *n2s[i];
+        for (int32_t j = 0; j < UPRV_LENGTHOF(middles); ++j) {
+            UnicodeString middle(middles[j]);
+            UnicodeString normalizedMiddle = n2.normalize(middle, errorCode);
+            UBool isNormalized = middle == normalizedMiddle;
+            for (int32_t n = 0; n <= 40; ++n) {
+                UnicodeString prefix, suffix;
+                for (int32_t k = 0; k < n; ++k) {
+                    prefix.append((char16_t)((k % 5) == 3 ? 0xb7 : u'a'));
+                    suffix.append((char16_t)((k % 7) == 2 ? 0x20 : u'b'));
+                }
+                UnicodeString s = prefix + middle + suffix;
+                UnicodeString expected = prefix + normalizedMiddle + suffix;
+                char msg[80];
+                sprintf(msg, "%s middles[%d] n=%d", names[i], (int)j, (int)n);
+
+                UnicodeString result = n2.normalize(s, errorCode);
+                assertEquals(UnicodeString(msg, -1, US_INV) + u" normalize", expected, result);
+                assertEquals(UnicodeString(msg, -1, US_INV) + u" isNormalized",
+                             isNormalized, n2.isNormalized(s, errorCode));
+                assertEquals(UnicodeString(msg, -1, US_INV) + u" quickCheck==YES",
+                             isNormalized, (UBool)(n2.quickCheck(s, errorCode) == UNORM_YES));
+                int32_t span = n2.spanQuickCheckYes(s, errorCode);
+                if (isNormalized ? span != s.length() : (span < n - 1 || span > n)) {
+                    errln("%s spanQuickCheckYes=%d", msg, (int)span);
+                }
+
+                std::string s8, expected8, result8;
+                s.toUTF8String(s8);
+                expected.toUTF8String(expected8);
+                StringByteSink<std::string> sink(&result8);
+                n2.normalizeUTF8(0, s8, sink, nullptr, errorCode);
+                assertEquals(UnicodeString(msg, -1, US_INV) + u" normalizeUTF8",
+                             expected8.c_str(), result8.c_str());
+                assertEquals(UnicodeString(msg, -1, US_INV) + u" isNormalizedUTF8",
+                             isNormalized, n2.isNormalizedUTF8(s8, errorCode));
+                if (errorCode.errIfFailureAndReset("%s", msg)) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+void
+BasicNormalizerTest::TestNormalizerStream() {
+    IcuTestErrorCode errorCode(*this, "TestNormalizerStream");
+    const Normalizer2 *nfc = Normalizer2::getNFCInstance(errorCode);
+    const Normalizer2 *n2s[] = {
+        nfc,
+        Normalizer2::getNFDInstance(errorCode),
+        Normalizer2::getNFKCCasefoldInstance(errorCode),
+        Normalizer2::getInstance(nullptr, "nfc", UNORM2_FCD, errorCode),
+        Normalizer2::getInstance(nullptr, "nfc", UNORM2_COMPOSE_CONTIGUOUS, errorCode)
+    };
+    static const char *const names[] = { "NFC", "NFD", "NFKC_CF", "FCD", "FCC" };
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getInstance() call failed")) {
+        return;
+    }
+    // Combining sequences, Hangul, supplementary combining marks and unpaired surrogates,
+    // so that chunks split them in many different places.
+    UnicodeString text(u"  AÄÄ­̣Ạ̈,각각 "
+                       u"\U0001D15E\U0001D165\U0001D16D ẍ\U0001D165̣ ");
+    text.append((UChar)0xd800).append(u"̈ ཱཱཱིྀུ Ḍ̇̇").
+        append((UChar)0xdc00).append(u"̧");
+    // The same with ill-formed UTF-8 sequences, some of them truncated.
+    std::string text8;
+    UnicodeString(text, 0, 22).toUTF8String(text8);
+    text8.append("\xE1\x84");
+    UnicodeString(text, 22, 20).toUTF8String(text8);
+    text8.append("\xF0\x9D\x85");
+    UnicodeString(u"̣̇ ").toUTF8String(text8);
+    text8.append("\xC0\x80\xCC");
+    UnicodeString(u"̈ä").toUTF8String(text8);
+
+    for (int32_t i = 0; i < UPRV_LENGTHOF(n2s); ++i) {
+        const Normalizer2 &n2 = *n2s[i];
+        NormalizerStream stream(n2);
+        UnicodeString expected = n2.normalize(text, errorCode);
+        std::string expected8;
+        StringByteSink<std::string> expectedSink(&expected8);
+        n2.normalizeUTF8(0, text8, expectedSink, nullptr, errorCode);
+        for (int32_t chunkLength = 1; chunkLength <= 9; ++chunkLength) {
+            char msg[80];
+            sprintf(msg, "%s chunkLength=%d", names[i], (int)chunkLength);
+            UnicodeString result;
+            UnicodeStringAppendable app(result);
+            for (int32_t start = 0; start < text.length(); start += chunkLength) {
+                int32_t length = text.length() - start;
+                if (length > chunkLength) {
+                    length = chunkLength;
+                }
+                // The last chunk flushes only for some chunk lengths.
+                UBool flush = (chunkLength & 1) != 0 && start + length == text.length();
+                stream.normalize(UnicodeString(FALSE, text.getBuffer() + start, length),
+                                 app, flush, errorCode);
+            }
+            if ((chunkLength & 1) == 0) {
+                stream.normalize(UnicodeString(), app, TRUE, errorCode);
+            }
+            assertEquals(UnicodeString(msg, -1, US_INV) + u" normalize", expected, result);
+
+            std::string result8;
+            StringByteSink<std::string> sink(&result8);
+            for (int32_t start = 0; start < (int32_t)text8.length(); start += chunkLength) {
+                int32_t length = (int32_t)text8.length() - start;
+                if (length > chunkLength) {
+                    length = chunkLength;
+                }
+                stream.normalizeUTF8(StringPiece(text8.data() + start, length),
+                                     sink, FALSE, errorCode);
+            }
+            stream.normalizeUTF8(StringPiece(), sink, TRUE, errorCode);
+            assertEquals(UnicodeString(msg, -1, US_INV) + u" normalizeUTF8",
+                         expected8.c_str(), result8.c_str());
+            if (errorCode.errIfFailureAndReset("%s", msg)) {
+                return;
+            }
+        }
+    }
+
+    // Text is written out as soon as it cannot change any more.
+    NormalizerStream stream(*nfc);
+    std::string result8;
+    StringByteSink<std::string> sink(&result8);
+    stream.normalizeUTF8("abc", sink, FALSE, errorCode);
+    assertEquals("normalizeUTF8(abc) keeps c", "ab", result8.c_str());
+    stream.normalizeUTF8("\xCC", sink, FALSE, errorCode);
+    assertEquals("normalizeUTF8(lead byte) keeps c", "ab", result8.c_str());
+    stream.normalizeUTF8("\x88", sink, FALSE, errorCode);
+    assertEquals("normalizeUTF8(trail byte) keeps c+U+0308", "ab", result8.c_str());
+    stream.normalizeUTF8("d", sink, FALSE, errorCode);
+    assertEquals("normalizeUTF8(d) writes c+U+0308 composed", u8"abc̈", result8.c_str());
+
+    // The stream continues with the same form of text until it is flushed or reset.
+    UnicodeString result;
+    UnicodeStringAppendable app(result);
+    stream.normalize(u"x", app, FALSE, errorCode);
+    assertEquals("normalize() after normalizeUTF8()",
+                 u_errorName(U_ILLEGAL_ARGUMENT_ERROR), u_errorName(errorCode.reset()));
+    stream.reset();
+    stream.normalize(u"xy", app, FALSE, errorCode);
+    assertEquals("normalize() after reset()", u"x", result);
+    stream.normalizeUTF8("z", sink, TRUE, errorCode);
+    assertEquals("normalizeUTF8() after normalize()",
+                 u_errorName(U_ILLEGAL_ARGUMENT_ERROR), u_errorName(errorCode.reset()));
+    stream.normalize(UnicodeString(u"̈", -1).append((UChar)0xd834), app, FALSE, errorCode);
+    assertEquals("normalize() keeps y and an unpaired lead surrogate", u"x", result);
+    stream.normalize(UnicodeString((UChar)0xdd65).append(u'z'), app, TRUE, errorCode);
+    assertEquals("normalize() flush", u"x\u00FF\U0001D165z", result);
+    stream.normalizeUTF8("z", sink, TRUE, errorCode);
+    assertEquals("normalizeUTF8() after flush", u8"abc̈z", result8.c_str());
+}
+
+
+namespace {
+
+// Runs each task right away, and counts them.
+void U_CALLCONV countingExecutor(const void *context, UTaskFn *taskFn, void *task) {
+    ++*static_cast<int32_t *>(const_cast<void *>(context));
+    taskFn(task);
+}
+
+}  // namespace
+
+void
+BasicNormalizerTest::TestNormalizeBulk() {
+    IcuTestErrorCode errorCode(*this, "TestNormalizeBulk");
+    const Normalizer2 *n2s[] = {
+        Normalizer2::getNFCInstance(errorCode),
+        Normalizer2::getNFDInstance(errorCode),
+        Normalizer2::getNFKCCasefoldInstance(errorCode),
+        Normalizer2::getInstance(nullptr, "nfc", UNORM2_FCD, errorCode)
+    };
+    static const char *const names[] = { "NFC", "NFD", "NFKC_CF", "FCD" };
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getInstance() call failed")) {
+        return;
+    }
+    // Combining sequences, Hangul syllables and conjoining Jamo, a long run of combining marks,
+    // and supplementary characters, so that chunks end in many different places.
+    UnicodeString text;
+    for (int32_t i = 0; i < 6; ++i) {
+        text.append(u"\u00C4\u1EA0\u0308 \uAC01\u1100\u1161\u11A8 \U0001D15E\U0001D165 ");
+    }
+    for (int32_t i = 0; i < 30; ++i) {
+        text.append(i & 1 ? u'\u0308' : u'\u0323');
+    }
+    text.append(u"\u1E0C\u0307 \U0001D15F\U0001D16D\U0001D165 ").append((UChar)0xd800).
+        append(u"\u0308 x");
+    std::string text8;
+    text.toUTF8String(text8);
+    text8.insert(20, "\xE1\x84");  // truncated sequence
+    text8.insert(50, "\xC0\x80");  // ill-formed sequence
+
+    for (int32_t i = 0; i < UPRV_LENGTHOF(n2s); ++i) {
+        const Normalizer2 &n2 = *n2s[i];
+        UnicodeString expected = n2.normalize(text, errorCode);
+        std::string expected8;
+        StringByteSink<std::string> expectedSink(&expected8);
+        Edits expectedEdits;
+        n2.normalizeUTF8(0, text8, expectedSink, &expectedEdits, errorCode);
+        for (int32_t chunkLength = 1; chunkLength <= 40; chunkLength += 3) {
+            char msg[80];
+            sprintf(msg, "%s chunkLength=%d", names[i], (int)chunkLength);
+            int32_t count = 0;
+            UnicodeString result;
+            n2.normalizeBulk(text, result, chunkLength, countingExecutor, &count, errorCode);
+            assertEquals(UnicodeString(msg, -1, US_INV) + u" normalizeBulk", expected, result);
+            assertTrue(UnicodeString(msg, -1, US_INV) + u" normalizeBulk uses the executor",
+                       count > 0);
+
+            count = 0;
+            std::string result8;
+            StringByteSink<std::string> sink(&result8);
+            Edits edits;
+            n2.normalizeUTF8Bulk(0, text8, sink, &edits, chunkLength,
+                                 countingExecutor, &count, errorCode);
+            assertEquals(UnicodeString(msg, -1, US_INV) + u" normalizeUTF8Bulk",
+                         expected8.c_str(), result8.c_str());
+            assertTrue(UnicodeString(msg, -1, US_INV) + u" normalizeUTF8Bulk uses the executor",
+                       count > 0);
+            // The edits are the same as from a single normalizeUTF8() call.
+            Edits::Iterator expectedIter = expectedEdits.getFineIterator();
+            Edits::Iterator iter = edits.getFineIterator();
+            UBool expectedHasNext, hasNext;
+            do {
+                expectedHasNext = expectedIter.next(errorCode);
+                hasNext = iter.next(errorCode);
+                if (!assertEquals(UnicodeString(msg, -1, US_INV) + u" edits next()",
+                                  expectedHasNext, hasNext) ||
+                        (hasNext &&
+                            (!assertEquals(UnicodeString(msg, -1, US_INV) + u" edits change",
+                                           expectedIter.hasChange(), iter.hasChange()) ||
+                             !assertEquals(UnicodeString(msg, -1, US_INV) + u" edits old length",
+                                           expectedIter.oldLength(), iter.oldLength()) ||
+                             !assertEquals(UnicodeString(msg, -1, US_INV) + u" edits new length",
+                                           expectedIter.newLength(), iter.newLength())))) {
+                    break;
+                }
+            } while (hasNext);
+            if (errorCode.errIfFailureAndReset("%s", msg)) {
+                return;
+            }
+        }
+    }
+
+    // Without an executor, or for short text, everything runs on the calling thread.
+    const Normalizer2 &nfc = *n2s[0];
+    int32_t count = 0;
+    UnicodeString result;
+    nfc.normalizeBulk(text, result, 0, countingExecutor, &count, errorCode);
+    assertEquals("normalizeBulk(default chunk length)", nfc.normalize(text, errorCode), result);
+    assertEquals("normalizeBulk(default chunk length) task count", 0, count);
+    nfc.normalizeBulk(text, result, 5, nullptr, nullptr, errorCode);
+    assertEquals("normalizeBulk(no executor)", nfc.normalize(text, errorCode), result);
+
+    // U_EDITS_NO_RESET appends to the existing edits.
+    std::string result8;
+    StringByteSink<std::string> sink(&result8);
+    Edits edits;
+    edits.addUnchanged(2);
+    nfc.normalizeUTF8Bulk(U_EDITS_NO_RESET, "abe\xCC\x88" "d", sink, &edits, 1,
+                          countingExecutor, &count, errorCode);
+    assertEquals("normalizeUTF8Bulk(U_EDITS_NO_RESET)", u8"ab\u00EBd", result8.c_str());
+    assertEquals("U_EDITS_NO_RESET length delta", -1, edits.lengthDelta());
+    assertEquals("U_EDITS_NO_RESET changes", 1, edits.numberOfChanges());
+    Edits::Iterator iter = edits.getFineIterator();
+    iter.next(errorCode);
+    assertEquals("U_EDITS_NO_RESET first old length", 4, iter.oldLength());
+
+    nfc.normalizeBulk(result, result, 1, countingExecutor, &count, errorCode);
+    assertEquals("normalizeBulk(src=dest)",
+                 u_errorName(U_ILLEGAL_ARGUMENT_ERROR), u_errorName(errorCode.reset()));
+    assertTrue("normalizeBulk(src=dest) result is bogus", result.isBogus());
+}
+
+
+void
+BasicNormalizerTest::TestNormalizeBatch() {
+    IcuTestErrorCode errorCode(*this, "TestNormalizeBatch");
+    const Normalizer2 *n2s[] = {
+        Normalizer2::getNFCInstance(errorCode),
+        Normalizer2::getNFDInstance(errorCode),
+        Normalizer2::getNFKCCasefoldInstance(errorCode)
+    };
+    static const char *const names[] = { "NFC", "NFD", "NFKC_CF" };
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getInstance() call failed")) {
+        return;
+    }
+    // Normalized and not, empty, and one that only the full check finds to be NFC.
+    // The last ones start with combining marks, which must not combine or reorder
+    // with the end of the previous string.
+    static const char16_t *const strings[] = {
+        u"abc",
+        u"A\u0308",
+        u"",
+        u"\u00C4",
+        u"\u1E0C\u0307",
+        u"\uFB01x",
+        u"\uAC00\u11A8",
+        u"a\u0307\u0323",
+        u"a",
+        u"\u0301",
+        u"\u0307\u0323"
+    };
+    const int32_t count = UPRV_LENGTHOF(strings);
+    const UChar *srcs[count];
+    int32_t lengths[count];
+    std::string strings8[count];
+    StringPiece srcs8[count + 1];
+    for (int32_t i = 0; i < count; ++i) {
+        srcs[i] = strings[i];
+        lengths[i] = i == 0 ? -1 : u_strlen(strings[i]);  // the first one is NUL-terminated
+        UnicodeString(strings[i]).toUTF8String(strings8[i]);
+        srcs8[i] = strings8[i];
+    }
+    srcs8[count] = "\xE1\x84" "a\xCC\x88";  // truncated sequence, then not NFC
+    int32_t offsets[count + 2];
+    UBool isNormalized[count + 1];
+
+    for (int32_t n = 0; n < UPRV_LENGTHOF(n2s); ++n) {
+        const Normalizer2 &n2 = *n2s[n];
+        // The arena already has some text, and the results are appended.
+        UnicodeString arena(u"xy");
+        n2.normalizeBatch(srcs, lengths, count, arena, offsets, isNormalized, errorCode);
+        assertEquals(UnicodeString(names[n], -1, US_INV) + u" first offset", 2, offsets[0]);
+        for (int32_t i = 0; i < count; ++i) {
+            char msg[80];
+            sprintf(msg, "%s normalizeBatch[%d]", names[n], (int)i);
+            UnicodeString src(strings[i]);
+            UnicodeString expected = n2.normalize(src, errorCode);
+            assertEquals(UnicodeString(msg, -1, US_INV) + u" isNormalized",
+                         n2.isNormalized(src, errorCode), isNormalized[i]);
+            UnicodeString result = isNormalized[i] ? src :
+                arena.tempSubString(offsets[i], offsets[i + 1] - offsets[i]);
+            assertEquals(UnicodeString(msg, -1, US_INV), expected, result);
+            if (isNormalized[i]) {
+                assertEquals(UnicodeString(msg, -1, US_INV) + u" not copied",
+                             offsets[i], offsets[i + 1]);
+            }
+        }
+        assertEquals(UnicodeString(names[n], -1, US_INV) + u" last offset",
+                     arena.length(), offsets[count]);
+
+        // Without the flags, all results are in the arena.
+        arena.remove();
+        n2.normalizeBatch(srcs, lengths, count, arena, offsets, nullptr, errorCode);
+        UnicodeString expected;
+        for (int32_t i = 0; i < count; ++i) {
+            expected.append(n2.normalize(UnicodeString(strings[i]), errorCode));
+        }
+        assertEquals(UnicodeString(names[n], -1, US_INV) + u" normalizeBatch(no flags)",
+                     expected, arena);
+
+        std::string arena8;
+        StringByteSink<std::string> sink(&arena8);
+        n2.normalizeUTF8Batch(srcs8, count + 1, sink, offsets, isNormalized, errorCode);
+        assertEquals(UnicodeString(names[n], -1, US_INV) + u" UTF-8 first offset", 0, offsets[0]);
+        for (int32_t i = 0; i <= count; ++i) {
+            char msg[80];
+            sprintf(msg, "%s normalizeUTF8Batch[%d]", names[n], (int)i);
+            std::string expected8;
+            StringByteSink<std::string> expectedSink(&expected8);
+            n2.normalizeUTF8(0, srcs8[i], expectedSink, nullptr, errorCode);
+            assertEquals(UnicodeString(msg, -1, US_INV) + u" isNormalized",
+                         n2.isNormalizedUTF8(srcs8[i], errorCode), isNormalized[i]);
+            std::string result8 = isNormalized[i] ?
+                std::string(srcs8[i].data(), srcs8[i].length()) :
+                arena8.substr(offsets[i], offsets[i + 1] - offsets[i]);
+            assertEquals(UnicodeString(msg, -1, US_INV), expected8.c_str(), result8.c_str());
+        }
+        assertEquals(UnicodeString(names[n], -1, US_INV) + u" UTF-8 last offset",
+                     (int32_t)arena8.length(), offsets[count + 1]);
+
+        arena8.clear();
+        n2.normalizeUTF8Batch(srcs8, count + 1, sink, offsets, nullptr, errorCode);
+        std::string expected8;
+        StringByteSink<std::string> expectedSink(&expected8);
+        for (int32_t i = 0; i <= count; ++i) {
+            n2.normalizeUTF8(0, srcs8[i], expectedSink, nullptr, errorCode);
+        }
+        assertEquals(UnicodeString(names[n], -1, US_INV) + u" normalizeUTF8Batch(no flags)",
+                     expected8.c_str(), arena8.c_str());
+        if (errorCode.errIfFailureAndReset("%s", names[n])) {
+            return;
+        }
+    }
+    // The NFC flags for a few of the strings.
+    const Normalizer2 &nfc = *n2s[0];
+    UnicodeString arena;
+    nfc.normalizeBatch(srcs, lengths, count, arena, offsets, isNormalized, errorCode);
+    assertTrue("abc is NFC", isNormalized[0]);
+    assertFalse("A+U+0308 is not NFC", isNormalized[1]);
+    assertTrue("D+dot below+dot above is NFC", isNormalized[4]);
+
+    nfc.normalizeBatch(srcs, lengths, -1, arena, offsets, isNormalized, errorCode);
+    assertEquals("normalizeBatch(count<0)",
+                 u_errorName(U_ILLEGAL_ARGUMENT_ERROR), u_errorName(errorCode.reset()));
+    std::string arena8;
+    StringByteSink<std::string> sink(&arena8);
+    nfc.normalizeUTF8Batch(srcs8, count, sink, nullptr, isNormalized, errorCode);
+    assertEquals("normalizeUTF8Batch(offsets=nullptr)",
+                 u_errorName(U_ILLEGAL_ARGUMENT_ERROR), u_errorName(errorCode.reset()));
+}
+
 #endif /* #if !UCONFIG_NO_NORMALIZATION */
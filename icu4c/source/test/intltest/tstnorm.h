@@ -53,6 +53,12 @@ class BasicNormalizerTest : public IntlTest {
     void TestNormalizeIllFormedText();
     void TestComposeJamoTBase();
     void TestComposeBoundaryAfter();
+    void TestDecomposeUTF8WithEdits();
+    void TestNormalizeUTF8AllModes();
+    void TestLongRunsBelowMinimum();
+    void TestNormalizerStream();
+    void TestNormalizeBulk();
+    void TestNormalizeBatch();
 
 private:
     UnicodeString canonTests[24][3];
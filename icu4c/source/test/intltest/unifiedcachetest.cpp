@@ -14,6 +14,7 @@
 #include "intltest.h"
 #include "unifiedcache.h"
 #include "unicode/datefmt.h"
+#include "unicode/ucache.h"
 
 class UCTItem : public SharedObject {
   public:
@@ -24,6 +25,9 @@ class UCTItem : public SharedObject {
     virtual ~UCTItem() {
         uprv_free(value);
     }
+    virtual int32_t getMemoryFootprint() const {
+        return 1000;
+    }
 };
 
 class UCTItem2 : public SharedObject {
@@ -77,6 +81,12 @@ class UnifiedCacheTest : public IntlTest {
     void TestError();
     void TestHashEquals();
     void TestEvictionUnderStress();
+    void TestManyKeys();
+    void TestStatistics();
+    void TestStatisticsCApi();
+    void TestMemoryBudget();
+    const UCacheStatistics *findStatistics(
+            const UCacheStatistics *stats, int32_t length, const char *keyType);
 };
 
 void UnifiedCacheTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* /*par*/) {
@@ -87,6 +97,10 @@ void UnifiedCacheTest::runIndexedTest(int32_t index, UBool exec, const char* &na
   TESTCASE_AUTO(TestError);
   TESTCASE_AUTO(TestHashEquals);
   TESTCASE_AUTO(TestEvictionUnderStress);
+  TESTCASE_AUTO(TestManyKeys);
+  TESTCASE_AUTO(TestStatistics);
+  TESTCASE_AUTO(TestStatisticsCApi);
+  TESTCASE_AUTO(TestMemoryBudget);
   TESTCASE_AUTO_END;
 }
 
@@ -396,6 +410,184 @@ void UnifiedCacheTest::TestHashEquals() {
     assertTrue("", diffKey1 != diffKey2);
 }
 
+void UnifiedCacheTest::TestManyKeys() {
+    UErrorCode status = U_ZERO_ERROR;
+    UnifiedCache::getInstance(status);
+    UnifiedCache cache(status);
+    assertSuccess("T0", status);
+
+    // Enough keys to populate every shard of the cache several times over.
+    static const int32_t KEY_COUNT = 20 * UnifiedCache::SHARD_COUNT;
+    const UCTItem *items[KEY_COUNT] = {};
+    char name[16];
+    for (int32_t i = 0; i < KEY_COUNT; ++i) {
+        sprintf(name, "%d", (int)i);
+        cache.get(LocaleCacheKey<UCTItem>(name), &cache, items[i], status);
+    }
+    assertSuccess("T1", status);
+    assertEquals("T2", KEY_COUNT, cache.keyCount());
+    assertEquals("T3", 0, cache.unusedCount());
+
+    // Held values must keep resolving to the same references.
+    for (int32_t i = 0; i < KEY_COUNT; ++i) {
+        const UCTItem *item = NULL;
+        sprintf(name, "%d", (int)i);
+        cache.get(LocaleCacheKey<UCTItem>(name), &cache, item, status);
+        if (item != items[i] || uprv_strcmp(item->value, name) != 0) {
+            errln("T4: Expected key %s to resolve to the same object.", name);
+        }
+        SharedObject::clearPtr(item);
+    }
+
+    for (int32_t i = 0; i < KEY_COUNT; ++i) {
+        SharedObject::clearPtr(items[i]);
+    }
+    cache.flush();
+    assertEquals("T5", 0, cache.keyCount());
+    assertSuccess("T6", status);
+}
+
+const UCacheStatistics *UnifiedCacheTest::findStatistics(
+        const UCacheStatistics *stats, int32_t length, const char *keyType) {
+    for (int32_t i = 0; i < length; ++i) {
+        if (uprv_strcmp(stats[i].keyType, keyType) == 0) {
+            return stats + i;
+        }
+    }
+    errln("No statistics for %s", keyType);
+    return NULL;
+}
+
+void UnifiedCacheTest::TestStatistics() {
+    UErrorCode status = U_ZERO_ERROR;
+    UnifiedCache::getInstance(status);
+    UnifiedCache cache(status);
+    assertSuccess("T0", status);
+
+    const UCTItem *en = NULL;
+    const UCTItem *enUs = NULL;
+    const UCTItem *zh = NULL;
+    cache.get(LocaleCacheKey<UCTItem>("en"), &cache, en, status);    // miss
+    cache.get(LocaleCacheKey<UCTItem>("en"), &cache, en, status);    // hit
+    // en_US is a miss; creating it fetches en, a hit.
+    cache.get(LocaleCacheKey<UCTItem>("en_US"), &cache, enUs, status);
+    UErrorCode zhStatus = U_ZERO_ERROR;
+    cache.get(LocaleCacheKey<UCTItem>("zh"), &cache, zh, zhStatus);  // miss, error
+    assertSuccess("T1", status);
+
+    UCacheStatistics stats[4];
+    int32_t length = cache.getStatistics(stats, UPRV_LENGTHOF(stats), status);
+    assertSuccess("T2", status);
+    assertEquals("T3", 1, length);
+    const UCacheStatistics *item = findStatistics(stats, length, typeid(UCTItem).name());
+    if (item != NULL) {
+        assertEquals("T4 hits", (int64_t) 2, item->hitCount);
+        assertEquals("T5 misses", (int64_t) 3, item->missCount);
+        assertEquals("T6 entries", 3, item->entryCount);
+        assertEquals("T7 evictions", (int64_t) 0, item->evictionCount);
+        assertTrue("T8 creation time", item->creationMillis >= 0);
+    }
+
+    // Preflighting.
+    status = U_ZERO_ERROR;
+    assertEquals("T9", 1, cache.getStatistics(NULL, 0, status));
+    assertEquals("T10", U_BUFFER_OVERFLOW_ERROR, status);
+
+    status = U_ZERO_ERROR;
+    cache.resetStatistics();
+    length = cache.getStatistics(stats, UPRV_LENGTHOF(stats), status);
+    item = findStatistics(stats, length, typeid(UCTItem).name());
+    if (item != NULL) {
+        assertEquals("T11 hits", (int64_t) 0, item->hitCount);
+        assertEquals("T12 misses", (int64_t) 0, item->missCount);
+        assertEquals("T13 entries", 3, item->entryCount);
+    }
+    SharedObject::clearPtr(en);
+    SharedObject::clearPtr(enUs);
+    assertSuccess("T14", status);
+}
+
+void UnifiedCacheTest::TestStatisticsCApi() {
+    UErrorCode status = U_ZERO_ERROR;
+    const UnifiedCache *cache = UnifiedCache::getInstance(status);
+    assertSuccess("T0", status);
+    ucache_resetStatistics(&status);
+    const UCTItem *fr = NULL;
+    cache->get(LocaleCacheKey<UCTItem>("fr"), fr, status);
+    cache->get(LocaleCacheKey<UCTItem>("fr"), fr, status);
+
+    int32_t length = ucache_getStatistics(NULL, 0, &status);
+    if (status == U_BUFFER_OVERFLOW_ERROR) {
+        status = U_ZERO_ERROR;
+    }
+    LocalArray<UCacheStatistics> stats(new UCacheStatistics[length]);
+    assertEquals("T1", length, ucache_getStatistics(stats.getAlias(), length, &status));
+    assertSuccess("T2", status);
+    const UCacheStatistics *item = findStatistics(stats.getAlias(), length, typeid(UCTItem).name());
+    if (item != NULL) {
+        assertEquals("T3 hits", (int64_t) 1, item->hitCount);
+        assertEquals("T4 misses", (int64_t) 1, item->missCount);
+    }
+    for (int32_t i = 1; i < length; ++i) {
+        assertTrue("T5 sorted", uprv_strcmp(stats[i - 1].keyType, stats[i].keyType) < 0);
+    }
+
+    ucache_setEvictionPolicy(-1, 0, &status);
+    assertEquals("T6", U_ILLEGAL_ARGUMENT_ERROR, status);
+    SharedObject::clearPtr(fr);
+    cache->flush();
+}
+
+void UnifiedCacheTest::TestMemoryBudget() {
+    UErrorCode status = U_ZERO_ERROR;
+    UnifiedCache::getInstance(status);
+    UnifiedCache cache(status);
+    assertSuccess("T0", status);
+
+    // Each UCTItem reports 1000 bytes.
+    cache.setMemoryBudget(3000, status);
+    static const char *locales[] = {"a", "b", "c"};
+    for (int32_t i = 0; i < UPRV_LENGTHOF(locales); ++i) {
+        const UCTItem *item = NULL;
+        cache.get(LocaleCacheKey<UCTItem>(locales[i]), &cache, item, status);
+        SharedObject::clearPtr(item);
+    }
+    assertEquals("T1", 3, cache.keyCount());
+    assertEquals("T2", 3000, cache.bytesRetained());
+
+    // Fetching "a" again marks it as recently used.
+    const UCTItem *a = NULL;
+    cache.get(LocaleCacheKey<UCTItem>("a"), &cache, a, status);
+    SharedObject::clearPtr(a);
+
+    // Going over budget evicts "b" or "c" but not "a".
+    const UCTItem *d = NULL;
+    cache.get(LocaleCacheKey<UCTItem>("d"), &cache, d, status);
+    assertSuccess("T3", status);
+    assertEquals("T4", 3, cache.keyCount());
+    assertEquals("T5", 3000, cache.bytesRetained());
+    assertEquals("T6", (int64_t) 1, cache.autoEvictedCount());
+
+    cache.resetStatistics();
+    cache.get(LocaleCacheKey<UCTItem>("a"), &cache, a, status);
+    UCacheStatistics stats[2];
+    int32_t length = cache.getStatistics(stats, UPRV_LENGTHOF(stats), status);
+    const UCacheStatistics *item = findStatistics(stats, length, typeid(UCTItem).name());
+    if (item != NULL) {
+        assertEquals("T7 hits", (int64_t) 1, item->hitCount);
+        assertEquals("T8 misses", (int64_t) 0, item->missCount);
+    }
+    SharedObject::clearPtr(a);
+    SharedObject::clearPtr(d);
+
+    cache.setMemoryBudget(-1, status);
+    assertEquals("T9", U_ILLEGAL_ARGUMENT_ERROR, status);
+    status = U_ZERO_ERROR;
+    cache.flush();
+    assertEquals("T10", 0, cache.keyCount());
+    assertEquals("T11", 0, cache.bytesRetained());
+}
+
 extern IntlTest *createUnifiedCacheTest() {
     return new UnifiedCacheTest();
 }
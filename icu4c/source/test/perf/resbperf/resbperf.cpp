@@ -0,0 +1,158 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+ *  file name:  resbperf.cpp
+ *  encoding:   UTF-8
+ *  tab size:   8 (not used)
+ *  indentation:4
+ *
+ *  Performance test program for resource bundle key lookups.
+ *  Compares the hash index for large tables with binary search.
+ *
+ *  Example:
+ *  resbperf TableLookupIndexed TableLookupBinarySearch --passes 3 --iterations 10000 -v
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "unicode/ures.h"
+#include "unicode/uperf.h"
+#include "cmemory.h"
+#include "ureslocs.h"
+#include "uresdata.h"
+
+// Large tables that are looked up frequently.
+static const struct {
+    const char *path;
+    const char *table;
+} gTables[] = {
+    { U_ICUDATA_CURR, "Currencies" },
+    { U_ICUDATA_CURR, "CurrencyPlurals" },
+    { U_ICUDATA_ZONE, "zoneStrings" },
+    { U_ICUDATA_LANG, "Languages" },
+    { U_ICUDATA_REGION, "Countries" }
+};
+
+// Test object.
+class ResourceBundlePerfTest : public UPerfTest {
+public:
+    ResourceBundlePerfTest(int32_t argc, const char *argv[], UErrorCode &status);
+    virtual ~ResourceBundlePerfTest();
+
+    virtual UPerfFunction* runIndexedTest(int32_t index, UBool exec, const char* &name, char* par = NULL);
+
+    UResourceBundle *tables[UPRV_LENGTHOF(gTables)];
+    // All keys of all tables, each followed by the index of its table.
+    const char **keys;
+    int32_t *tableIndexes;
+    int32_t keyCount;
+};
+
+ResourceBundlePerfTest::ResourceBundlePerfTest(int32_t argc, const char *argv[], UErrorCode &status)
+        : UPerfTest(argc, argv, NULL, 0, "", status),
+          keys(NULL), tableIndexes(NULL), keyCount(0) {
+    uprv_memset(tables, 0, sizeof(tables));
+    if (U_FAILURE(status)) {
+        return;
+    }
+    int32_t capacity = 0;
+    for (int32_t i = 0; i < UPRV_LENGTHOF(gTables); ++i) {
+        UResourceBundle *rb = ures_open(gTables[i].path, "en", &status);
+        tables[i] = ures_getByKey(rb, gTables[i].table, NULL, &status);
+        ures_close(rb);
+        if (U_FAILURE(status)) {
+            fprintf(stderr, "error: unable to open en %s: %s\n",
+                    gTables[i].table, u_errorName(status));
+            return;
+        }
+        capacity += ures_getSize(tables[i]);
+    }
+    keys = (const char **)malloc(capacity * sizeof(const char *));
+    tableIndexes = (int32_t *)malloc(capacity * sizeof(int32_t));
+    if (keys == NULL || tableIndexes == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    UResourceBundle *item = NULL;
+    for (int32_t i = 0; i < UPRV_LENGTHOF(gTables); ++i) {
+        ures_resetIterator(tables[i]);
+        while (ures_hasNext(tables[i])) {
+            item = ures_getNextResource(tables[i], item, &status);
+            // Keys point into the memory-mapped data, which stays loaded.
+            keys[keyCount] = ures_getKey(item);
+            tableIndexes[keyCount++] = i;
+        }
+    }
+    ures_close(item);
+    if (verbose) {
+        printf("keys:%ld\n", (long)keyCount);
+    }
+}
+
+ResourceBundlePerfTest::~ResourceBundlePerfTest() {
+    for (int32_t i = 0; i < UPRV_LENGTHOF(gTables); ++i) {
+        ures_close(tables[i]);
+    }
+    free(keys);
+    free(tableIndexes);
+}
+
+// Performance test function object.
+// Looks up every key of every table once per iteration.
+class TableLookup : public UPerfFunction {
+public:
+    TableLookup(const ResourceBundlePerfTest &testcase, UBool useIndex)
+            : testcase(testcase), useIndex(useIndex), item(NULL) {}
+    virtual ~TableLookup() {
+        ures_close(item);
+        res_setUseTableKeyIndex(TRUE);
+    }
+
+    virtual void call(UErrorCode* pErrorCode) {
+        res_setUseTableKeyIndex(useIndex);
+        for (int32_t i = 0; i < testcase.keyCount; ++i) {
+            item = ures_getByKey(testcase.tables[testcase.tableIndexes[i]],
+                                 testcase.keys[i], item, pErrorCode);
+        }
+        if (U_FAILURE(*pErrorCode)) {
+            fprintf(stderr, "error: ures_getByKey() failed: %s\n", u_errorName(*pErrorCode));
+        }
+    }
+
+    virtual long getOperationsPerIteration() {
+        return testcase.keyCount;
+    }
+
+private:
+    const ResourceBundlePerfTest &testcase;
+    UBool useIndex;
+    UResourceBundle *item;
+};
+
+UPerfFunction* ResourceBundlePerfTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* /*par*/) {
+    switch (index) {
+        case 0: name = "TableLookupIndexed";        if (exec) return new TableLookup(*this, TRUE); break;
+        case 1: name = "TableLookupBinarySearch";   if (exec) return new TableLookup(*this, FALSE); break;
+        default: name = ""; break;
+    }
+    return NULL;
+}
+
+int main(int argc, const char *argv[]) {
+    UErrorCode status = U_ZERO_ERROR;
+    ResourceBundlePerfTest test(argc, argv, status);
+
+    if (U_FAILURE(status)) {
+        printf("The error is %s\n", u_errorName(status));
+        test.usage();
+        return status;
+    }
+
+    if (test.run() == FALSE) {
+        fprintf(stderr, "FAILED: Tests could not be run please check the "
+                        "arguments.\n");
+        return -1;
+    }
+
+    return 0;
+}
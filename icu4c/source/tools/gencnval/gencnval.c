@@ -976,10 +976,61 @@ createNormalizedAliasStrings(char *normalizedStrings, const char *origStringBloc
     }
 }
 
+/*
+ * Create the hash table over the normalized unique aliases.
+ * See ucnv_io.cpp for the format.
+ * Returns the number of slots, or 0 if there is no hash table.
+ */
+static uint32_t
+createAliasHashTable(uint16_t **pHashTable, const uint16_t *uniqueAliases, uint32_t uniqueAliasesSize, uint16_t aliasOffset) {
+    char strippedName[UCNV_MAX_CONVERTER_NAME_LENGTH];
+    uint16_t *hashTable;
+    uint32_t hashTableSize, mask, i;
+
+    *pHashTable = NULL;
+    if (uniqueAliasesSize >= MAX_ALIAS_COUNT) {
+        /* the slot values 1 + index would not fit */
+        return 0;
+    }
+
+    /* Keep at least half of the slots empty for short probe sequences. */
+    hashTableSize = 16;
+    while (hashTableSize < 2 * uniqueAliasesSize) {
+        hashTableSize <<= 1;
+    }
+    mask = hashTableSize - 1;
+    hashTable = (uint16_t *)uprv_malloc(hashTableSize * sizeof(uint16_t));
+    if (hashTable == NULL) {
+        fprintf(stderr, "gencnval: error: out of memory\n");
+        exit(U_MEMORY_ALLOCATION_ERROR);
+    }
+    uprv_memset(hashTable, 0, hashTableSize * sizeof(uint16_t));
+
+    for (i = 0; i < uniqueAliasesSize; ++i) {
+        const char *alias = GET_ALIAS_STR(uniqueAliases[i] - aliasOffset);
+        uint32_t slot;
+        if (uprv_strlen(alias) >= UCNV_MAX_CONVERTER_NAME_LENGTH) {
+            fprintf(stderr, "%s: error: alias %s is too long\n", path, alias);
+            exit(U_BUFFER_OVERFLOW_ERROR);
+        }
+        ucnv_io_stripForCompare(strippedName, alias);
+        slot = ucnv_io_hashNormalizedName(strippedName) & mask;
+        while (hashTable[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        hashTable[slot] = (uint16_t)(i + 1);
+    }
+
+    *pHashTable = hashTable;
+    return hashTableSize;
+}
+
 static void
 writeAliasTable(UNewDataMemory *out) {
     uint32_t i, j;
     uint32_t uniqueAliasesSize;
+    uint16_t *aliasHashTable = NULL;
+    uint32_t aliasHashTableSize = 0;
     uint16_t aliasOffset = (uint16_t)(tagBlock.top/sizeof(uint16_t));
     uint16_t *aliasArrLists = (uint16_t *)uprv_malloc(tagCount * converterCount * sizeof(uint16_t));
     uint16_t *uniqueAliases = (uint16_t *)uprv_malloc(knownAliasesCount * sizeof(uint16_t));
@@ -998,13 +1049,21 @@ writeAliasTable(UNewDataMemory *out) {
         }
     }
 
+    /* The hash table is over the normalized strings */
+    if (tableOptions.stringNormalizationType != UCNV_IO_UNNORMALIZED) {
+        aliasHashTableSize = createAliasHashTable(&aliasHashTable, uniqueAliases, uniqueAliasesSize, aliasOffset);
+    }
+
     /* Write the size of the TOC */
     if (tableOptions.stringNormalizationType == UCNV_IO_UNNORMALIZED) {
         udata_write32(out, 8);
     }
-    else {
+    else if (aliasHashTableSize == 0) {
         udata_write32(out, 9);
     }
+    else {
+        udata_write32(out, 10);
+    }
 
     /* Write the sizes of each section */
     /* All sizes are the number of uint16_t units, not bytes */
@@ -1019,6 +1078,9 @@ writeAliasTable(UNewDataMemory *out) {
     if (tableOptions.stringNormalizationType != UCNV_IO_UNNORMALIZED) {
         udata_write32(out, (tagBlock.top + stringBlock.top) / sizeof(uint16_t));
     }
+    if (aliasHashTableSize != 0) {
+        udata_write32(out, 1 + aliasHashTableSize);  /* charset family + slots */
+    }
 
     /* write the table of converters */
     /* Think of this as the column headers */
@@ -1072,6 +1134,13 @@ writeAliasTable(UNewDataMemory *out) {
         uprv_free(normalizedStrings);
     }
 
+    /* Write the hash table for the normalized aliases. */
+    if (aliasHashTableSize != 0) {
+        udata_write16(out, U_CHARSET_FAMILY);
+        udata_writeBlock(out, aliasHashTable, aliasHashTableSize * sizeof(uint16_t));
+        uprv_free(aliasHashTable);
+    }
+
     uprv_free(uniqueAliasesToConverter);
     uprv_free(uniqueAliases);
     uprv_free(aliasArrLists);
@@ -33,6 +33,7 @@
 #include "swapimpl.h"
 #include "toolutil.h"
 #include "package.h"
+#include "pkg_gencmn.h"
 #include "cmemory.h"
 
 #include <stdio.h>
@@ -672,6 +673,10 @@ Package::readPackage(const char *filename) {
             // sort the item names for the local charset
             sortItems();
         }
+
+        // The TOC hash index is derived from the TOC: writePackage() builds a new one,
+        // and it is not listed, extracted or checked like the other items.
+        removeItem(findItem(UDATA_TOC_HASH_ITEM_NAME));
     }
 
     udata_closeSwapper(ds);
@@ -685,13 +690,15 @@ Package::getInType() {
 void
 Package::writePackage(const char *filename, char outType, const char *comment) {
     char prefix[MAX_PKG_NAME_LENGTH+4];
-    UDataOffsetTOCEntry entry;
+    UDataOffsetTOCEntry entry, *tocEntries;
     UDataSwapper *dsLocalToOut, *ds[TYPE_COUNT];
     FILE *file;
     Item *pItem;
     char *name;
     UErrorCode errorCode;
     int32_t i, length, prefixLength, maxItemLength, basenameOffset, offset, outInt32;
+    int32_t tocHashLength;
+    uint8_t *tocHash;
     uint8_t outCharset;
     UBool outIsBigEndian;
 
@@ -723,6 +730,21 @@ Package::writePackage(const char *filename, char outType, const char *comment) {
 
     makeTypeProps(outType, outCharset, outIsBigEndian);
 
+    // replace a TOC hash index from the input with a new one for the output TOC;
+    // its contents are filled in once the TOC entries are known
+    removeItem(findItem(UDATA_TOC_HASH_ITEM_NAME));
+    tocHash=NULL;
+    tocHashLength=0;
+    if(itemCount>0) {
+        tocHashLength=getTOCHashItemLength(itemCount+1);
+        tocHash=(uint8_t *)uprv_malloc(tocHashLength);
+        if(tocHash==NULL) {
+            fprintf(stderr, "icupkg: out of memory\n");
+            exit(U_MEMORY_ALLOCATION_ERROR);
+        }
+        addItem(UDATA_TOC_HASH_ITEM_NAME, tocHash, tocHashLength, TRUE, outType);
+    }
+
     // open (TYPE_COUNT-2) swappers
     // one is a no-op for local type==outType
     // one type (TYPE_LE) is bogus
@@ -831,10 +853,16 @@ Package::writePackage(const char *filename, char outType, const char *comment) {
     }
 
     // then write the item entries (and collect the maxItemLength)
+    tocEntries=(UDataOffsetTOCEntry *)uprv_malloc((itemCount+1)*sizeof(UDataOffsetTOCEntry));
+    if(tocEntries==NULL) {
+        fprintf(stderr, "icupkg: out of memory\n");
+        exit(U_MEMORY_ALLOCATION_ERROR);
+    }
     maxItemLength=0;
     for(i=0; i<itemCount; ++i) {
         entry.nameOffset=(uint32_t)(basenameOffset+(items[i].name-outStrings));
         entry.dataOffset=(uint32_t)offset;
+        tocEntries[i]=entry;
         if(dsLocalToOut!=NULL) {
             dsLocalToOut->swapArray32(dsLocalToOut, &entry, 8, &entry, &errorCode);
             if(U_FAILURE(errorCode)) {
@@ -862,6 +890,30 @@ Package::writePackage(const char *filename, char outType, const char *comment) {
         exit(U_FILE_ACCESS_ERROR);
     }
 
+    // build the TOC hash index in the output form
+    if(tocHash!=NULL) {
+        const char **names=(const char **)uprv_malloc(itemCount*sizeof(const char *));
+        if(names==NULL) {
+            fprintf(stderr, "icupkg: out of memory\n");
+            exit(U_MEMORY_ALLOCATION_ERROR);
+        }
+        for(i=0; i<itemCount; ++i) {
+            names[i]=items[i].name;
+        }
+        buildTOCHash(names, itemCount, udata_checksumTOC(tocEntries, (uint32_t)itemCount), tocHash);
+        uprv_free(names);
+        if(dsLocalToOut!=NULL) {
+            int32_t headerLength=udata_swapDataHeader(dsLocalToOut, tocHash, tocHashLength, tocHash, &errorCode);
+            dsLocalToOut->swapArray32(dsLocalToOut, tocHash+headerLength, tocHashLength-headerLength,
+                                      tocHash+headerLength, &errorCode);
+            if(U_FAILURE(errorCode)) {
+                fprintf(stderr, "icupkg: swapping the TOC hash index failed - %s\n", u_errorName(errorCode));
+                exit(errorCode);
+            }
+        }
+    }
+    uprv_free(tocEntries);
+
     // write the items
     for(pItem=items, i=0; i<itemCount; ++pItem, ++i) {
         int32_t type=makeTypeEnum(pItem->type);
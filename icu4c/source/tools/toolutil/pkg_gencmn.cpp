@@ -18,6 +18,7 @@
 #include "unicode/uclean.h"
 #include "unewdata.h"
 #include "putilimp.h"
+#include "ucmndata.h"
 #include "pkg_gencmn.h"
 
 #define STRING_STORE_SIZE 200000
@@ -76,6 +77,21 @@ static const UDataInfo dataInfo={
     {3, 0, 0, 0}                  /* dataVersion */
 };
 
+/* UDataInfo for the TOC hash index item, see ucmndata.h */
+static const UDataInfo tocHashDataInfo={
+    (uint16_t)sizeof(UDataInfo),
+    0,
+
+    U_IS_BIG_ENDIAN,
+    U_CHARSET_FAMILY,
+    (uint8_t)sizeof(UChar),
+    0,
+
+    {0x54, 0x6f, 0x63, 0x48},     /* dataFormat="TocH" */
+    {1, 0, 0, 0},                 /* formatVersion */
+    {1, 0, 0, 0}                  /* dataVersion */
+};
+
 static uint32_t maxSize;
 
 static char stringStore[STRING_STORE_SIZE];
@@ -100,6 +116,9 @@ static char *symPrefix = NULL;
 static void
 addFile(const char *filename, const char *name, const char *source, UBool sourceTOC, UBool verbose);
 
+static void
+addTOCHashFile(const char *name);
+
 static char *
 allocString(uint32_t length);
 
@@ -116,6 +135,146 @@ static void
 fixDirToTreePath(char *s);
 /* -------------------------------------------------------------------------- */
 
+/* TOC hash index ----------------------------------------------------------- */
+
+/* the index header is padded to a multiple of 16 bytes */
+#define TOC_HASH_HEADER_LENGTH ((int32_t)((sizeof(DataHeader)+15)&~15))
+
+U_CAPI int32_t U_EXPORT2
+getTOCHashItemLength(int32_t count) {
+    int32_t bucketCount=(count+3)/4;
+    int32_t length=TOC_HASH_HEADER_LENGTH+4*(UDATA_TOC_HASH_IX_COUNT+bucketCount+count);
+    return (length+15)&~15;
+}
+
+/*
+ * Tries to build the minimal perfect hash function for the names with one seed.
+ * Places the buckets with the most names first, while most entries are still free,
+ * and searches for each bucket the smallest displacement that maps all of
+ * its names to distinct free entries.
+ */
+static UBool
+buildTOCHashWithSeed(const char *const names[], int32_t count, int32_t bucketCount, uint32_t seed,
+                     uint32_t *displacements, uint32_t *entries,
+                     int32_t *bucketOf, int32_t *sortedNames, int32_t *bucketStarts,
+                     int32_t *sortedBuckets, int32_t *slots) {
+    int32_t i, j, b, maxBucketSize;
+
+    // distribute the names into buckets (counting sort by bucket)
+    uprv_memset(bucketStarts, 0, (bucketCount+1)*4);
+    for(i=0; i<count; ++i) {
+        bucketOf[i]=(int32_t)(udata_hashTOCName(names[i], seed)%(uint32_t)bucketCount);
+        ++bucketStarts[bucketOf[i]+1];
+    }
+    maxBucketSize=0;
+    for(b=0; b<bucketCount; ++b) {
+        if(bucketStarts[b+1]>maxBucketSize) {
+            maxBucketSize=bucketStarts[b+1];
+        }
+        bucketStarts[b+1]+=bucketStarts[b];
+    }
+    for(i=0; i<count; ++i) {
+        // bucketStarts[b] temporarily becomes the insertion point, then the limit
+        sortedNames[bucketStarts[bucketOf[i]]++]=i;
+    }
+    for(b=bucketCount; b>0; --b) {
+        bucketStarts[b]=bucketStarts[b-1];
+    }
+    bucketStarts[0]=0;
+
+    // order the buckets by decreasing size
+    j=0;
+    for(int32_t size=maxBucketSize; size>0; --size) {
+        for(b=0; b<bucketCount; ++b) {
+            if((bucketStarts[b+1]-bucketStarts[b])==size) {
+                sortedBuckets[j++]=b;
+            }
+        }
+    }
+    for(b=0; b<bucketCount; ++b) {
+        displacements[b]=0;
+        if(bucketStarts[b+1]==bucketStarts[b]) {
+            sortedBuckets[j++]=b;
+        }
+    }
+
+    for(i=0; i<count; ++i) {
+        entries[i]=0xffffffff;
+    }
+    for(j=0; j<bucketCount; ++j) {
+        b=sortedBuckets[j];
+        int32_t start=bucketStarts[b], limit=bucketStarts[b+1];
+        if(start==limit) {
+            break;  // only empty buckets follow
+        }
+        uint32_t d;
+        for(d=0;; ++d) {
+            if(d>=(uint32_t)count*64) {
+                return FALSE;
+            }
+            uint32_t slotSeed=UDATA_TOC_HASH_SLOT_SEED(seed, d);
+            for(i=start; i<limit; ++i) {
+                int32_t slot=(int32_t)(udata_hashTOCName(names[sortedNames[i]], slotSeed)%(uint32_t)count);
+                if(entries[slot]!=0xffffffff) {
+                    break;
+                }
+                // reserve the slot for this displacement, undone if another name collides
+                entries[slot]=(uint32_t)sortedNames[i];
+                slots[i]=slot;
+            }
+            if(i==limit) {
+                break;  // all names of the bucket placed
+            }
+            while(i>start) {
+                entries[slots[--i]]=0xffffffff;
+            }
+        }
+        displacements[b]=d;
+    }
+    return TRUE;
+}
+
+U_CAPI void U_EXPORT2
+buildTOCHash(const char *const names[], int32_t count, uint32_t checksum, uint8_t *data) {
+    int32_t bucketCount=(count+3)/4;
+    int32_t length=getTOCHashItemLength(count);
+    uprv_memset(data, 0, length);
+    DataHeader *pHeader=(DataHeader *)data;
+    pHeader->dataHeader.headerSize=(uint16_t)TOC_HASH_HEADER_LENGTH;
+    pHeader->dataHeader.magic1=0xda;
+    pHeader->dataHeader.magic2=0x27;
+    uprv_memcpy(&pHeader->info, &tocHashDataInfo, sizeof(UDataInfo));
+
+    uint32_t *indexes=(uint32_t *)(data+TOC_HASH_HEADER_LENGTH);
+    uint32_t *displacements=indexes+UDATA_TOC_HASH_IX_COUNT;
+    uint32_t *entries=displacements+bucketCount;
+    int32_t *temp=(int32_t *)uprv_malloc((3*count+2*bucketCount+1)*4);
+    if(temp==NULL) {
+        fprintf(stderr, "icupkg/gencmn: out of memory\n");
+        exit(U_MEMORY_ALLOCATION_ERROR);
+    }
+    uint32_t seed;
+    for(seed=0;; ++seed) {
+        if(seed==100) {
+            // practically impossible; the package is still valid without an index
+            fprintf(stderr, "icupkg/gencmn: warning: unable to build the TOC hash index\n");
+            indexes[UDATA_TOC_HASH_IX_ITEM_COUNT]=0;
+            break;
+        }
+        if(buildTOCHashWithSeed(names, count, bucketCount, seed, displacements, entries,
+                                temp, temp+count, temp+2*count, temp+2*count+bucketCount+1,
+                                temp+2*count+2*bucketCount+1)) {
+            indexes[UDATA_TOC_HASH_IX_ITEM_COUNT]=(uint32_t)count;
+            break;
+        }
+    }
+    uprv_free(temp);
+    indexes[UDATA_TOC_HASH_IX_BUCKET_COUNT]=(uint32_t)bucketCount;
+    indexes[UDATA_TOC_HASH_IX_SEED]=seed;
+    indexes[UDATA_TOC_HASH_IX_TOC_CHECKSUM]=checksum;
+}
+
+
 U_CAPI void U_EXPORT2
 createCommonDataFile(const char *destDir, const char *name, const char *entrypointName, const char *type, const char *source, const char *copyRight,
                      const char *dataFile, uint32_t max_size, UBool sourceTOC, UBool verbose, char *gencmnFileName) {
@@ -218,11 +377,19 @@ createCommonDataFile(const char *destDir, const char *name, const char *entrypoi
         return;
     }
 
+    if(!sourceTOC) {
+        addTOCHashFile(name);
+    }
+
     /* sort the files by basename */
     qsort(files, fileCount, sizeof(File), compareFiles);
 
     if(!sourceTOC) {
         UNewDataMemory *out;
+        UDataOffsetTOCEntry *tocEntries;
+        const char **names;
+        uint8_t *tocHash;
+        uint32_t tocHashLength=0;
 
         /* determine the offsets of all basenames and files in this common one */
         basenameOffset=4+8*fileCount;
@@ -232,7 +399,27 @@ createCommonDataFile(const char *destDir, const char *name, const char *entrypoi
             fileOffset+=(files[i].fileSize+15)&~0xf;
             files[i].basenameOffset=basenameOffset;
             basenameOffset+=files[i].basenameLength;
+            if(files[i].pathname==NULL) {
+                tocHashLength=files[i].fileSize;
+            }
+        }
+
+        /* build the TOC hash index for the table of contents */
+        tocEntries=(UDataOffsetTOCEntry *)uprv_malloc(fileCount*sizeof(UDataOffsetTOCEntry));
+        names=(const char **)uprv_malloc(fileCount*sizeof(const char *));
+        tocHash=(uint8_t *)uprv_malloc(tocHashLength);
+        if(tocEntries==NULL || names==NULL || tocHash==NULL) {
+            fprintf(stderr, "gencmn: out of memory\n");
+            exit(U_MEMORY_ALLOCATION_ERROR);
+        }
+        for(i=0; i<fileCount; ++i) {
+            tocEntries[i].nameOffset=files[i].basenameOffset;
+            tocEntries[i].dataOffset=files[i].fileOffset;
+            names[i]=files[i].basename;
         }
+        buildTOCHash(names, (int32_t)fileCount, udata_checksumTOC(tocEntries, fileCount), tocHash);
+        uprv_free(tocEntries);
+        uprv_free(names);
 
         /* create the output file */
         out=udata_create(destDir, type, name,
@@ -267,6 +454,13 @@ createCommonDataFile(const char *destDir, const char *name, const char *entrypoi
                 udata_writePadding(out, 16-length);
             }
 
+            if(files[i].pathname==NULL) {
+                /* the TOC hash index */
+                udata_writeBlock(out, tocHash, tocHashLength);
+                length=tocHashLength;
+                continue;
+            }
+
             if (verbose) {
                 printf("adding %s (%ld byte%s)\n", files[i].pathname, (long)files[i].fileSize, files[i].fileSize == 1 ? "" : "s");
             }
@@ -300,6 +494,8 @@ createCommonDataFile(const char *destDir, const char *name, const char *entrypoi
             udata_writePadding(out, 16-length);
         }
 
+        uprv_free(tocHash);
+
         /* finish */
         udata_finish(out, &errorCode);
         if(U_FAILURE(errorCode)) {
@@ -410,6 +606,14 @@ addFile(const char *filename, const char *name, const char *source, UBool source
     uint32_t length;
     char *fullPath = NULL;
 
+    /* the TOC hash index is built from the other files, not copied */
+    if(uprv_strcmp(filename, UDATA_TOC_HASH_ITEM_NAME)==0) {
+        if (verbose) {
+            printf("%s ignored (the TOC hash index is rebuilt)\n", filename);
+        }
+        return;
+    }
+
     if(fileCount==fileMax) {
       fileMax += CHUNK_FILE_COUNT;
       files = (File *)uprv_realloc(files, fileMax*sizeof(files[0])); /* note: never freed. */
@@ -494,6 +698,35 @@ addFile(const char *filename, const char *name, const char *source, UBool source
     ++fileCount;
 }
 
+/* adds the TOC hash index item, whose data is built once the table of contents is known */
+static void
+addTOCHashFile(const char *name) {
+    uint32_t length;
+    char *s;
+
+    if(fileCount==fileMax) {
+      fileMax += CHUNK_FILE_COUNT;
+      files = (File *)uprv_realloc(files, fileMax*sizeof(files[0])); /* note: never freed. */
+      if(files==NULL) {
+        fprintf(stderr, "pkgdata/gencmn: Could not allocate %u bytes for %d files\n", (unsigned int)(fileMax*sizeof(files[0])), fileCount);
+        exit(U_MEMORY_ALLOCATION_ERROR);
+      }
+    }
+
+    length = (uint32_t)(uprv_strlen(name) + 1 + uprv_strlen(UDATA_TOC_HASH_ITEM_NAME) + 1);
+    s=allocString(length);
+    uprv_strcpy(s, name);
+    uprv_strcat(s, U_TREE_ENTRY_SEP_STRING);
+    uprv_strcat(s, UDATA_TOC_HASH_ITEM_NAME);
+    files[fileCount].basename=s;
+    files[fileCount].basenameLength=length;
+    basenameTotal+=length;
+
+    files[fileCount].pathname=NULL;
+    files[fileCount].fileSize=(uint32_t)getTOCHashItemLength((int32_t)fileCount+1);
+    ++fileCount;
+}
+
 static char *
 allocString(uint32_t length) {
     uint32_t top=stringTop+length;
@@ -15,4 +15,21 @@ U_CAPI void U_EXPORT2
 createCommonDataFile(const char *destDir, const char *name, const char *entrypointName, const char *type, const char *source, const char *copyRight,
                      const char *dataFile, uint32_t max_size, UBool sourceTOC, UBool verbose, char *gencmnFileName);
 
+/**
+ * Returns the length of the TOC hash index item (see ucmndata.h)
+ * for a package with count items, including the index item itself.
+ */
+U_CAPI int32_t U_EXPORT2
+getTOCHashItemLength(int32_t count);
+
+/**
+ * Builds the TOC hash index item data for the sorted, prefixed item names
+ * (including the index item's own name) in local endianness,
+ * into getTOCHashItemLength(count) bytes.
+ * The names must be in the output charset.
+ * @param checksum udata_checksumTOC() of the package's TOC entries
+ */
+U_CAPI void U_EXPORT2
+buildTOCHash(const char *const names[], int32_t count, uint32_t checksum, uint8_t *data);
+
 #endif
@@ -702,6 +702,65 @@ test_swap(const UDataSwapper *ds,
     return headerSize+size;
 }
 
+/* .dat package TOC hash index swapping ------------------------------------ */
+
+static int32_t U_CALLCONV
+udata_swapTOCHash(const UDataSwapper *ds,
+                  const void *inData, int32_t length, void *outData,
+                  UErrorCode *pErrorCode) {
+    /* udata_swapDataHeader checks the arguments */
+    int32_t headerSize=udata_swapDataHeader(ds, inData, length, outData, pErrorCode);
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+
+    /* check data format and format version */
+    const UDataInfo *pInfo=(const UDataInfo *)((const char *)inData+4);
+    if(!(
+        pInfo->dataFormat[0]==0x54 &&   /* dataFormat="TocH" */
+        pInfo->dataFormat[1]==0x6f &&
+        pInfo->dataFormat[2]==0x63 &&
+        pInfo->dataFormat[3]==0x48 &&
+        pInfo->formatVersion[0]==1
+    )) {
+        udata_printError(ds, "udata_swapTOCHash(): data format %02x.%02x.%02x.%02x (format version %02x) is not recognized as a TOC hash index\n",
+                         pInfo->dataFormat[0], pInfo->dataFormat[1],
+                         pInfo->dataFormat[2], pInfo->dataFormat[3],
+                         pInfo->formatVersion[0]);
+        *pErrorCode=U_UNSUPPORTED_ERROR;
+        return 0;
+    }
+
+    const uint32_t *inIndexes=(const uint32_t *)((const char *)inData+headerSize);
+    uint32_t *outIndexes=(uint32_t *)((char *)outData+headerSize);
+    int32_t size;
+    if(length>=0 && (length-headerSize)<(int32_t)(UDATA_TOC_HASH_IX_COUNT*4)) {
+        udata_printError(ds, "udata_swapTOCHash(): too few bytes (%d after header) for a TOC hash index\n",
+                         length-headerSize);
+        *pErrorCode=U_INDEX_OUTOFBOUNDS_ERROR;
+        return 0;
+    }
+    size=(int32_t)(UDATA_TOC_HASH_IX_COUNT+
+                   udata_readInt32(ds, (int32_t)inIndexes[UDATA_TOC_HASH_IX_BUCKET_COUNT])+
+                   udata_readInt32(ds, (int32_t)inIndexes[UDATA_TOC_HASH_IX_ITEM_COUNT]))*4;
+
+    if(length>=0) {
+        if((length-headerSize)<size) {
+            udata_printError(ds, "udata_swapTOCHash(): too few bytes (%d after header) for a TOC hash index\n",
+                             length-headerSize);
+            *pErrorCode=U_INDEX_OUTOFBOUNDS_ERROR;
+            return 0;
+        }
+        ds->swapArray32(ds, inIndexes, size, outIndexes, pErrorCode);
+        if(ds->inCharset!=ds->outCharset) {
+            /* the names are hashed in their charset: disable the index */
+            outIndexes[UDATA_TOC_HASH_IX_ITEM_COUNT]=0;
+        }
+    }
+
+    return headerSize+size;
+}
+
 /* swap any data (except a .dat package) ------------------------------------ */
 
 static const struct {
@@ -741,6 +800,7 @@ static const struct {
 #endif
     { { 0x70, 0x6e, 0x61, 0x6d }, upname_swap },        /* dataFormat="pnam" */
     { { 0x75, 0x6e, 0x61, 0x6d }, uchar_swapNames },    /* dataFormat="unam" */
+    { { 0x54, 0x6f, 0x63, 0x48 }, udata_swapTOCHash },  /* dataFormat="TocH" */
 #if !UCONFIG_NO_NORMALIZATION
     { { 0x43, 0x66, 0x75, 0x20 }, uspoof_swap },         /* dataFormat="Cfu " */
 #endif